@@ -0,0 +1,161 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include "../src/Graph.hpp"
+#include "../src/Generators.hpp"
+#include "../src/CompactGraph.hpp"
+#include "../src/MaximalSets.hpp"
+#include "../src/Spectral.hpp"
+#include "../src/Algebra.hpp"
+#include "../src/PageRank.hpp"
+#include "../src/Traversal.hpp"
+
+// Benchmarks of the parallel primitives against their sequential baselines on
+// GraphGenerator::Random graphs. Every row is the best of kRuns runs.
+
+constexpr int kRuns = 3;
+constexpr int kSpMVRepeats = 20;
+
+struct Family {
+    std::string name;
+    CompactGraph graph;
+};
+
+std::vector<Family> RandomFamilies() {
+    std::vector<Family> families;
+    auto add = [&](const char* name, Graph::Vertex n, double p) {
+        families.push_back({name, CompactGraph::fromGraph(GraphGenerator::Random(n, p))});
+    };
+    add("G(20000, 10/n)", 20000, 10.0 / 20000);
+    add("G(5000, 0.01)", 5000, 0.01);
+    add("G(2000, 0.1)", 2000, 0.1);
+    return families;
+}
+
+double BestMs(const std::function<void()>& run) {
+    double best = 1e300;
+    for (int i = 0; i < kRuns; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+// Prints one row; the result type needs size() and rounds.
+template <class Run>
+void Measure(const Family& f, const char* algorithm, unsigned threads, Run&& run) {
+    decltype(run()) result;
+    double ms = BestMs([&] { result = run(); });
+    std::printf("%-15s %-26s %7u %10.2f %9zu %7zu\n", f.name.c_str(), algorithm, threads, ms, (size_t)result.size(), result.rounds);
+}
+
+std::vector<unsigned> ThreadCounts() {
+    std::vector<unsigned> counts{1};
+    if (Parallel::threadCount() > 1) counts.push_back(Parallel::threadCount());
+    return counts;
+}
+
+void BenchMaximalSets(const std::vector<Family>& families) {
+    std::printf("\n--- Maximal independent set / maximal matching ---\n");
+    std::printf("%-15s %-26s %7s %10s %9s %7s\n", "graph", "algorithm", "threads", "ms", "size", "rounds");
+    for (const Family& f : families) {
+        const CompactGraph& g = f.graph;
+        Measure(f, "greedy MIS", 1, [&] { return MaximalSets::GreedyIndependentSet(g); });
+        for (unsigned t : ThreadCounts()) {
+            Measure(f, "reservation MIS", t, [&] { return MaximalSets::IndependentSet(g, t); });
+            Measure(f, "Luby MIS", t, [&] { return MaximalSets::Luby(g, t); });
+        }
+        Measure(f, "greedy matching", 1, [&] { return MaximalSets::GreedyMatching(g); });
+        for (unsigned t : ThreadCounts())
+            Measure(f, "reservation matching", t, [&] { return MaximalSets::Matching(g, t); });
+    }
+}
+
+// SpMV throughput in million stored entries (nnz) per second, then the
+// Lanczos solvers built on it.
+void BenchSpectral(const std::vector<Family>& families) {
+    std::printf("\n--- Sparse matrix-vector product (y = A x) ---\n");
+    std::printf("%-15s %-26s %7s %10s %9s\n", "graph", "kernel", "threads", "ms", "Mnnz/s");
+    for (const Family& f : families) {
+        const CompactGraph& g = f.graph;
+        std::vector<double> x(g.vertexCount()), y;
+        for (size_t v = 0; v < x.size(); ++v) x[v] = 1.0 / (1.0 + v);
+        for (unsigned t : ThreadCounts()) {
+            double ms = BestMs([&] { for (int r = 0; r < kSpMVRepeats; ++r) Spectral::Multiply(g, x, y, t); }) / kSpMVRepeats;
+            std::printf("%-15s %-26s %7u %10.3f %9.1f\n", f.name.c_str(), "CSR SpMV", t, ms, g.targets.size() / ms / 1e3);
+        }
+    }
+    std::printf("\n--- Lanczos eigensolvers ---\n");
+    std::printf("%-15s %-26s %7s %10s %12s %7s\n", "graph", "solver", "threads", "ms", "value", "SpMVs");
+    for (const Family& f : families) {
+        const CompactGraph& g = f.graph;
+        for (unsigned t : ThreadCounts()) {
+            EigenPair rho, fiedler;
+            double ms = BestMs([&] { rho = Spectral::SpectralRadius(g, t); });
+            std::printf("%-15s %-26s %7u %10.2f %12.6f %7zu\n", f.name.c_str(), "spectral radius", t, ms, rho.value, rho.iterations);
+            ms = BestMs([&] { fiedler = Spectral::Fiedler(g, t); });
+            std::printf("%-15s %-26s %7u %10.2f %12.6f %7zu\n", f.name.c_str(), "algebraic connectivity", t, ms, fiedler.value, fiedler.iterations);
+        }
+    }
+}
+
+// Semiring programs against hand-written baselines; "result" is the number
+// of reached vertices or components.
+void BenchAlgebra(const std::vector<Family>& families) {
+    std::printf("\n--- Semiring programs (GraphAlgebra) ---\n");
+    std::printf("%-15s %-26s %7s %10s %12s\n", "graph", "program", "threads", "ms", "result");
+    auto row = [](const Family& f, const char* program, unsigned threads, double ms, double result) {
+        std::printf("%-15s %-26s %7u %10.2f %12.6g\n", f.name.c_str(), program, threads, ms, result);
+    };
+    for (const Family& f : families) {
+        const CompactGraph& g = f.graph;
+        BreadthFirstSearch<CompactGraph> bfs(g);
+        double ms = BestMs([&] { bfs.run(0); });
+        row(f, "queue BFS", 1, ms, (double)bfs.visited().size());
+        for (unsigned t : ThreadCounts()) {
+            std::vector<CompactGraph::Index> levels;
+            ms = BestMs([&] { levels = GraphAlgebra::BFS(g, 0, t); });
+            row(f, "OR-AND BFS (push/pull)", t, ms, (double)(levels.size() - std::count(levels.begin(), levels.end(), CompactGraph::kNone)));
+            size_t components = 0;
+            ms = BestMs([&] { components = GraphAlgebra::ComponentCount(g, t); });
+            row(f, "OR-AND components", t, ms, (double)components);
+        }
+    }
+}
+
+void BenchPageRank(const std::vector<Family>& families) {
+    std::printf("\n--- PageRank (tolerance 1e-10) ---\n");
+    std::printf("%-15s %-26s %7s %10s %12s\n", "graph", "method", "threads", "ms", "iterations");
+    auto row = [](const Family& f, const char* method, unsigned threads, double ms, size_t iterations) {
+        std::printf("%-15s %-26s %7u %10.2f %12zu\n", f.name.c_str(), method, threads, ms, iterations);
+    };
+    for (const Family& f : families) {
+        const CompactGraph& g = f.graph;
+        PageRankResult rank;
+        for (unsigned t : ThreadCounts()) {
+            double ms = BestMs([&] { rank = PageRank::Compute(g, {}, t); });
+            row(f, "PLUS-TIMES pull (Jacobi)", t, ms, rank.iterations);
+        }
+        PageRankOptions gs;
+        gs.gaussSeidel = true;
+        double ms = BestMs([&] { rank = PageRank::Compute(g, gs); });
+        row(f, "Gauss-Seidel", 1, ms, rank.iterations);
+        for (double epsilon : {1e-4, 1e-6}) {
+            ms = BestMs([&] { rank = PageRank::Personalized(g, 0, epsilon); });
+            row(f, epsilon == 1e-4 ? "personalized push 1e-4" : "personalized push 1e-6", 1, ms, rank.iterations);
+        }
+    }
+}
+
+int main() {
+    std::printf("GraphoDro4 benchmarks, %u worker threads\n", Parallel::threadCount());
+    std::vector<Family> families = RandomFamilies();
+    for (const Family& f : families) std::printf("%-15s n = %u, m = %zu\n", f.name.c_str(), (unsigned)f.graph.vertexCount(), f.graph.targets.size() / 2);
+    BenchMaximalSets(families);
+    BenchSpectral(families);
+    BenchAlgebra(families);
+    BenchPageRank(families);
+    return 0;
+}
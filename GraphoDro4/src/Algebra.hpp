@@ -0,0 +1,291 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Semirings for GraphAlgebra. add is the reduction with identity zero(),
+// multiply(x, w) combines a vector entry with a matrix entry (the edge weight,
+// 1 when unweighted). saturated(a) means no further add can change a, which
+// lets a pull product stop scanning its row.
+struct OrAndSemiring {          // reachability
+    using Value = uint8_t;
+    static Value zero() { return 0; }
+    static Value add(Value a, Value b) { return a | b; }
+    static Value multiply(Value x, double) { return x; }
+    static bool saturated(Value a) { return a != 0; }
+};
+
+struct MinPlusSemiring {        // shortest paths
+    using Value = double;
+    static Value zero() { return std::numeric_limits<double>::infinity(); }
+    static Value add(Value a, Value b) { return std::min(a, b); }
+    static Value multiply(Value x, double w) { return x + w; }
+    static bool saturated(Value) { return false; }
+};
+
+struct PlusTimesSemiring {      // ordinary arithmetic
+    using Value = double;
+    static Value zero() { return 0.0; }
+    static Value add(Value a, Value b) { return a + b; }
+    static Value multiply(Value x, double w) { return x * w; }
+    static bool saturated(Value) { return false; }
+};
+
+struct MinFirstSemiring {       // smallest neighbouring label
+    using Value = uint64_t;
+    static Value zero() { return std::numeric_limits<uint64_t>::max(); }
+    static Value add(Value a, Value b) { return std::min(a, b); }
+    static Value multiply(Value x, double) { return x; }
+    static bool saturated(Value) { return false; }
+};
+
+// Vector over 0..n-1 stored densely; `present` marks the stored entries, an
+// absent entry is the implicit zero and never reaches the semiring.
+template <class T>
+struct DenseVector {
+    std::vector<T> values;
+    std::vector<char> present;
+
+    DenseVector() = default;
+    explicit DenseVector(size_t n) : values(n), present(n, 0) {}
+
+    size_t size() const { return values.size(); }
+    void set(size_t i, T value) { values[i] = value; present[i] = 1; }
+};
+
+// Vector over 0..n-1 holding only its stored entries, indices ascending.
+template <class T>
+struct SparseVector {
+    size_t dimension = 0;
+    std::vector<size_t> indices;
+    std::vector<T> values;
+
+    SparseVector() = default;
+    explicit SparseVector(size_t n) : dimension(n) {}
+
+    size_t size() const { return dimension; }
+    size_t nnz() const { return indices.size(); }
+    bool empty() const { return indices.empty(); }
+    void push(size_t i, T value) { indices.push_back(i); values.push_back(value); }
+};
+
+// Structural output mask: position v may be written iff bits[v] != 0 (iff it
+// is 0 when complemented). The default mask allows everything.
+struct Mask {
+    const std::vector<char>* bits = nullptr;
+    bool complement = false;
+
+    bool allows(size_t v) const { return !bits || (((*bits)[v] != 0) != complement); }
+};
+
+// GraphBLAS-style algebra over a CompactGraph read as its (symmetric)
+// adjacency matrix A. Products come in two directions: push scatters a sparse
+// frontier along its rows, pull gathers every allowed row against a dense
+// vector. The programs below (BFS, components, bipartiteness, Bellman-Ford)
+// are loops of such products and pick the direction per step; PageRank
+// (PageRank.hpp) is a loop of PLUS-TIMES pulls.
+class GraphAlgebra {
+public:
+    // y<mask> = A x for sparse x. Frontier slices run in parallel; their k
+    // (target, product) pairs for the edges leaving x are merged by a stable
+    // sort, so the cost is O(k log k) (no O(n) accumulator, which keeps long
+    // BFS runs with tiny frontiers cheap) and the sums do not depend on the
+    // thread count. On sparse graphs this is about 2x a queue BFS.
+    template <class S, class C>
+    static SparseVector<typename S::Value> Push(const C& g, const SparseVector<typename S::Value>& x,
+                                                const Mask& mask = {}, unsigned threads = 0) {
+        using Value = typename S::Value;
+        using Entry = std::pair<size_t, Value>;
+        size_t parts = x.nnz() < kPushSlice ? 1 : std::min<size_t>(Parallel::threadCount(threads), x.nnz() / kPushSlice);
+        std::vector<std::vector<Entry>> found(parts);
+        Parallel::forRange(0, parts, [&](size_t lo, size_t hi) {
+            for (size_t p = lo; p < hi; ++p)
+                for (size_t k = x.nnz() * p / parts; k < x.nnz() * (p + 1) / parts; ++k) {
+                    size_t i = x.indices[k];
+                    for (auto slot = g.offsets[i]; slot < g.offsets[i + 1]; ++slot)
+                        if (mask.allows(g.targets[slot])) found[p].push_back({g.targets[slot], S::multiply(x.values[k], g.weight(slot))});
+                }
+        }, threads, parts);
+        std::vector<Entry> all = std::move(found[0]);
+        for (size_t p = 1; p < parts; ++p) all.insert(all.end(), found[p].begin(), found[p].end());
+        std::stable_sort(all.begin(), all.end(), [](const Entry& a, const Entry& b) { return a.first < b.first; });
+        SparseVector<Value> y(g.vertexCount());
+        for (const Entry& e : all) {
+            if (!y.empty() && y.indices.back() == e.first) y.values.back() = S::add(y.values.back(), e.second);
+            else y.push(e.first, e.second);
+        }
+        return y;
+    }
+
+    // y<mask> = A x for dense x: allowed rows in parallel, each stopping once
+    // its sum saturates (the bottom-up step of direction-optimizing BFS).
+    template <class S, class C>
+    static DenseVector<typename S::Value> Pull(const C& g, const DenseVector<typename S::Value>& x,
+                                               const Mask& mask = {}, unsigned threads = 0) {
+        using Value = typename S::Value;
+        DenseVector<Value> y(g.vertexCount());
+        Parallel::forRange(0, g.vertexCount(), [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                if (!mask.allows(v)) continue;
+                Value acc = S::zero();
+                bool any = false;
+                for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) {
+                    size_t u = g.targets[slot];
+                    if (!x.present[u]) continue;
+                    acc = S::add(acc, S::multiply(x.values[u], g.weight(slot)));
+                    any = true;
+                    if (S::saturated(acc)) break;
+                }
+                if (any) y.set(v, acc);
+            }
+        }, threads);
+        return y;
+    }
+
+    // Push while the frontier touches few edges, pull once its edges exceed
+    // 1 / kPullRatio of all stored entries (Beamer's heuristic).
+    template <class S, class C>
+    static SparseVector<typename S::Value> Multiply(const C& g, const SparseVector<typename S::Value>& x,
+                                                    const Mask& mask = {}, unsigned threads = 0) {
+        size_t edges = 0;
+        for (size_t i : x.indices) edges += g.degree(i);
+        if (edges * kPullRatio > g.targets.size()) return ToSparse(Pull<S>(g, ToDense(x), mask, threads));
+        return Push<S>(g, x, mask, threads);
+    }
+
+    template <class T>
+    static DenseVector<T> ToDense(const SparseVector<T>& x) {
+        DenseVector<T> y(x.size());
+        for (size_t k = 0; k < x.nnz(); ++k) y.set(x.indices[k], x.values[k]);
+        return y;
+    }
+
+    template <class T>
+    static SparseVector<T> ToSparse(const DenseVector<T>& x) {
+        SparseVector<T> y(x.size());
+        for (size_t i = 0; i < x.size(); ++i) if (x.present[i]) y.push(i, x.values[i]);
+        return y;
+    }
+
+    // BFS levels from `source`, C::kNone when unreached:
+    // frontier<!visited> = A frontier over OR-AND until the frontier is empty.
+    template <class C>
+    static std::vector<typename C::Index> BFS(const C& g, typename C::Index source, unsigned threads = 0) {
+        return levels(g, {source}, threads);
+    }
+
+    // Per vertex the smallest index in its component: one BFS (as OR-AND
+    // products) from every vertex not reached yet, in index order. The visited
+    // mask is shared, so the total work is O(n + m) whatever the diameter.
+    template <class C>
+    static std::vector<typename C::Index> Components(const C& g, unsigned threads = 0) {
+        std::vector<typename C::Index> level;
+        return forest(g, level, threads);
+    }
+
+    template <class C>
+    static size_t ComponentCount(const C& g, unsigned threads = 0) {
+        std::vector<typename C::Index> label = Components(g, threads);
+        size_t count = 0;
+        for (size_t v = 0; v < label.size(); ++v) count += label[v] == v;
+        return count;
+    }
+
+    // BFS parity from every component's smallest vertex colours the graph; it
+    // is bipartite iff no odd vertex has an odd neighbour and no even vertex an
+    // even one, i.e. both masked products A odd<odd> and A even<even> are empty.
+    template <class C>
+    static bool IsBipartite(const C& g, unsigned threads = 0) {
+        size_t n = g.vertexCount();
+        std::vector<typename C::Index> level;
+        forest(g, level, threads);
+        std::vector<char> odd(n);
+        DenseVector<uint8_t> oddVertices(n), evenVertices(n);
+        for (size_t v = 0; v < n; ++v) {
+            odd[v] = level[v] & 1;
+            (odd[v] ? oddVertices : evenVertices).set(v, 1);
+        }
+        auto empty = [](const DenseVector<uint8_t>& y) { return std::find(y.present.begin(), y.present.end(), 1) == y.present.end(); };
+        return empty(Pull<OrAndSemiring>(g, oddVertices, Mask{&odd, false}, threads)) &&
+               empty(Pull<OrAndSemiring>(g, evenVertices, Mask{&odd, true}, threads));
+    }
+
+    // Single-source distances by frontier Bellman-Ford over MIN-PLUS: only
+    // vertices whose distance dropped are multiplied again. Unreachable
+    // vertices get infinity; negative or NaN weights throw std::invalid_argument.
+    template <class C>
+    static std::vector<double> BellmanFord(const C& g, typename C::Index source, unsigned threads = 0) {
+        for (double w : g.weights)
+            if (!(w >= 0.0)) throw std::invalid_argument("GraphAlgebra::BellmanFord: negative or NaN edge weight");
+        size_t n = g.vertexCount();
+        std::vector<double> dist(n, MinPlusSemiring::zero());
+        dist[source] = 0.0;
+        SparseVector<double> changed(n);
+        changed.push(source, 0.0);
+        while (!changed.empty()) {
+            SparseVector<double> offers = Multiply<MinPlusSemiring>(g, changed, {}, threads);
+            changed = SparseVector<double>(n);
+            for (size_t k = 0; k < offers.nnz(); ++k)
+                if (offers.values[k] < dist[offers.indices[k]]) {
+                    dist[offers.indices[k]] = offers.values[k];
+                    changed.push(offers.indices[k], offers.values[k]);
+                }
+        }
+        return dist;
+    }
+
+private:
+    static constexpr size_t kPullRatio = 16;
+    static constexpr size_t kPushSlice = 1024;
+
+    // Multi-source BFS levels over OR-AND products.
+    template <class C>
+    static std::vector<typename C::Index> levels(const C& g, std::vector<typename C::Index> sources, unsigned threads) {
+        std::vector<typename C::Index> level(g.vertexCount(), C::kNone);
+        std::vector<char> visited(g.vertexCount(), 0);
+        std::sort(sources.begin(), sources.end());
+        search(g, sources, visited, level, threads, [](size_t) {});
+        return level;
+    }
+
+    // BFS forest rooted at the smallest vertex of each component: returns the
+    // root per vertex and fills `level` with the depth below it.
+    template <class C>
+    static std::vector<typename C::Index> forest(const C& g, std::vector<typename C::Index>& level, unsigned threads) {
+        using Index = typename C::Index;
+        size_t n = g.vertexCount();
+        std::vector<Index> root(n);
+        std::vector<char> visited(n, 0);
+        level.assign(n, C::kNone);
+        for (size_t v = 0; v < n; ++v)
+            if (!visited[v]) search(g, {(Index)v}, visited, level, threads, [&](size_t u) { root[u] = (Index)v; });
+        return root;
+    }
+
+    // Levels from `sources` (ascending) into `level`, skipping vertices already
+    // `visited` and marking the reached ones; reach(v) sees every reached vertex.
+    // The cost is O(edges scanned) plus O(n) for each pull step, and pulls only
+    // run while the frontier holds a 1/kPullRatio share of all edges.
+    template <class C, class Reach>
+    static void search(const C& g, const std::vector<typename C::Index>& sources, std::vector<char>& visited,
+                       std::vector<typename C::Index>& level, unsigned threads, Reach&& reach) {
+        using Index = typename C::Index;
+        SparseVector<uint8_t> frontier(g.vertexCount());
+        for (Index s : sources) {
+            if (visited[s]) continue;
+            visited[s] = 1; level[s] = 0;
+            frontier.push(s, 1);
+            reach(s);
+        }
+        Mask unvisited{&visited, true};
+        for (Index depth = 1; !frontier.empty(); ++depth) {
+            frontier = Multiply<OrAndSemiring>(g, frontier, unvisited, threads);
+            for (size_t i : frontier.indices) { visited[i] = 1; level[i] = depth; reach(i); }
+        }
+    }
+};
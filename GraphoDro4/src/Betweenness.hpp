@@ -0,0 +1,131 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <numeric>
+#include <stdexcept>
+
+struct BetweennessResult {
+    std::vector<double> vertex; // per compact index
+    std::vector<double> edge;   // per CSR slot; both directions of an edge hold the same value
+    size_t pivots = 0;          // number of BFS sources actually used
+
+    template <class C>
+    double edgeValue(const C& g, typename C::Index u, typename C::Index v) const {
+        auto nb = g.neighbors(u);
+        auto it = std::lower_bound(nb.begin(), nb.end(), v);
+        return (it != nb.end() && *it == v) ? edge[it - g.targets.data()] : 0.0;
+    }
+};
+
+// Brandes' algorithm for unweighted graphs. Sources are split between threads,
+// each thread accumulates into its own arrays and the results are summed at the end.
+class Betweenness {
+public:
+    template <class C>
+    static BetweennessResult Exact(const C& g, unsigned threads = 0) {
+        std::vector<typename C::Index> sources(g.vertexCount());
+        std::iota(sources.begin(), sources.end(), 0);
+        return run(g, sources, 1.0, threads);
+    }
+
+    // Samples k pivots uniformly so that, with probability 1 - delta, every vertex
+    // score is within epsilon * n(n-2)/2 of the exact one (Hoeffding + union bound).
+    // Both epsilon and delta must lie in (0, 1).
+    template <class C>
+    static BetweennessResult Approximate(const C& g, double epsilon, double delta = 0.1,
+                                         unsigned threads = 0, uint64_t seed = std::random_device{}()) {
+        if (!(epsilon > 0.0 && epsilon < 1.0)) throw std::invalid_argument("Betweenness::Approximate: epsilon must be in (0, 1)");
+        if (!(delta > 0.0 && delta < 1.0)) throw std::invalid_argument("Betweenness::Approximate: delta must be in (0, 1)");
+        size_t n = g.vertexCount();
+        if (n == 0) return {};
+        // Clamp in floating point: a tiny epsilon gives a bound beyond size_t.
+        double k = std::ceil(std::log(2.0 * n / delta) / (2.0 * epsilon * epsilon));
+        return Sampled(g, k < (double)n ? (size_t)k : n, threads, seed);
+    }
+
+    template <class C>
+    static BetweennessResult Sampled(const C& g, size_t k, unsigned threads = 0,
+                                     uint64_t seed = std::random_device{}()) {
+        size_t n = g.vertexCount();
+        std::vector<typename C::Index> sources(n);
+        std::iota(sources.begin(), sources.end(), 0);
+        if (k >= n) return run(g, sources, 1.0, threads);
+        std::mt19937_64 rng(seed);
+        for (size_t i = 0; i < k; ++i) {
+            std::uniform_int_distribution<size_t> pick(i, n - 1);
+            std::swap(sources[i], sources[pick(rng)]);
+        }
+        sources.resize(k);
+        return run(g, sources, (double)n / k, threads);
+    }
+
+private:
+    template <class C>
+    static BetweennessResult run(const C& g, const std::vector<typename C::Index>& sources,
+                                 double scale, unsigned threads) {
+        using Index = typename C::Index;
+        size_t n = g.vertexCount();
+        BetweennessResult res;
+        res.vertex.assign(n, 0.0);
+        res.edge.assign(g.targets.size(), 0.0);
+        res.pivots = sources.size();
+        std::mutex merge;
+
+        Parallel::forRange(0, sources.size(), [&](size_t lo, size_t hi) {
+            std::vector<double> vbc(n, 0.0), ebc(g.targets.size(), 0.0);
+            std::vector<double> sigma(n, 0.0), delta(n, 0.0);
+            std::vector<Index> dist(n, C::kNone);
+            std::vector<Index> order;
+            order.reserve(n);
+
+            for (size_t i = lo; i < hi; ++i) {
+                Index s = sources[i];
+                order.clear();
+                order.push_back(s);
+                dist[s] = 0;
+                sigma[s] = 1.0;
+                for (size_t head = 0; head < order.size(); ++head) {
+                    Index v = order[head];
+                    for (Index w : g.neighbors(v)) {
+                        if (dist[w] == C::kNone) { dist[w] = dist[v] + 1; order.push_back(w); }
+                        if (dist[w] == dist[v] + 1) sigma[w] += sigma[v];
+                    }
+                }
+                for (size_t j = order.size(); j-- > 0;) {
+                    Index w = order[j];
+                    double coeff = (1.0 + delta[w]) / sigma[w];
+                    for (auto slot = g.offsets[w]; slot < g.offsets[w + 1]; ++slot) {
+                        Index v = g.targets[slot];
+                        if (dist[v] + 1 != dist[w]) continue;
+                        double c = sigma[v] * coeff;
+                        delta[v] += c;
+                        ebc[slot] += c;
+                    }
+                    if (w != s) vbc[w] += delta[w];
+                }
+                for (Index v : order) { dist[v] = C::kNone; sigma[v] = 0.0; delta[v] = 0.0; }
+            }
+
+            std::lock_guard<std::mutex> lock(merge);
+            for (size_t v = 0; v < n; ++v) res.vertex[v] += vbc[v];
+            for (size_t e = 0; e < ebc.size(); ++e) res.edge[e] += ebc[e];
+        }, threads);
+
+        // Every unordered pair is seen from both endpoints; fold the two CSR slots of an edge together.
+        for (auto& x : res.vertex) x *= scale / 2.0;
+        for (Index u = 0; u < (Index)n; ++u) {
+            for (auto slot = g.offsets[u]; slot < g.offsets[u + 1]; ++slot) {
+                Index v = g.targets[slot];
+                if (v <= u) continue;
+                auto nb = g.neighbors(v);
+                auto back = std::lower_bound(nb.begin(), nb.end(), u) - g.targets.data();
+                double total = (res.edge[slot] + res.edge[back]) * scale / 2.0;
+                res.edge[slot] = res.edge[back] = total;
+            }
+        }
+        return res;
+    }
+};
@@ -0,0 +1,179 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Cores.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <mutex>
+
+// Exact maximum clique of a CompactGraph by branch and bound on bitsets
+// (Tomita's MCS colouring bound in the bit-parallel form of San Segundo's
+// BBMC). The top level branches on every vertex v in degeneracy order with
+// only the neighbours peeled after v as candidates, so each subproblem has at
+// most degeneracy vertices and gets its own bitset adjacency; subproblems are
+// handed out dynamically to the workers, which share the incumbent size.
+// Dense graphs of a few thousand vertices can take minutes; Bounded caps the
+// number of search nodes and says whether the answer is still exact.
+template <class Index>
+struct BasicClique {
+    std::vector<Index> members; // sorted compact indices
+    size_t nodes = 0;           // search nodes expanded
+    bool exact = false;         // false once the node limit stopped the search:
+                                // members is then the largest clique found so far
+};
+
+class MaxClique {
+public:
+    template <class C>
+    static std::vector<typename C::Index> Find(const C& g, unsigned threads = 0) {
+        return Bounded(g, threads, SIZE_MAX).members;
+    }
+
+    template <class C>
+    static BasicClique<typename C::Index> Bounded(const C& g, unsigned threads, size_t nodeLimit) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicClique<Index> res;
+        res.exact = true;
+        if (n == 0) return res;
+        auto cores = KCore::Decompose(g);
+        std::vector<Index> rank(n);
+        for (Index i = 0; i < n; ++i) rank[cores.order[i]] = i;
+
+        std::vector<Index> best{cores.order[n - 1]};
+        std::atomic<size_t> bestSize{1}, next{0}, nodes{0};
+        std::atomic<bool> stopped{false};
+        std::mutex record;
+        unsigned workers = Parallel::threadCount(threads);
+        Parallel::forRange(0, workers, [&](size_t, size_t) {
+            Search<C> search(g, bestSize, best, record, nodes, nodeLimit, stopped);
+            // Densest roots (peeled last) first, so a large incumbent prunes the rest early.
+            for (size_t i; !stopped.load(std::memory_order_relaxed) && (i = next.fetch_add(1, std::memory_order_relaxed)) < n;)
+                search.root(cores.order[n - 1 - i], rank, cores.core);
+        }, workers);
+        std::sort(best.begin(), best.end());
+        res.members = std::move(best);
+        res.nodes = std::min(nodes.load(), nodeLimit);
+        res.exact = !stopped.load();
+        return res;
+    }
+
+    template <class C>
+    static size_t Size(const C& g, unsigned threads = 0) { return Find(g, threads).size(); }
+
+private:
+    template <class C>
+    class Search {
+        using Index = typename C::Index;
+    public:
+        Search(const C& g, std::atomic<size_t>& bestSize, std::vector<Index>& best, std::mutex& record,
+               std::atomic<size_t>& nodes, size_t limit, std::atomic<bool>& stopped)
+            : g(g), bestSize(bestSize), best(best), record(record), nodes(nodes), limit(limit), stopped(stopped),
+              local(g.vertexCount(), C::kNone) {}
+
+        void root(Index v, const std::vector<Index>& rank, const std::vector<Index>& core) {
+            // A member of a clique larger than the incumbent has core number >= incumbent.
+            vertices.clear();
+            for (Index u : g.neighbors(v))
+                if (rank[u] > rank[v] && core[u] >= bestSize.load(std::memory_order_relaxed)) vertices.push_back(u);
+            if (vertices.size() + 1 <= bestSize.load(std::memory_order_relaxed)) return;
+            size_t s = vertices.size();
+            words = (s + 63) / 64;
+            for (size_t i = 0; i < s; ++i) local[vertices[i]] = (Index)i;
+            // Initial BBMC order: non-increasing degree inside the subproblem.
+            degree.assign(s, 0);
+            for (size_t i = 0; i < s; ++i)
+                for (Index u : g.neighbors(vertices[i])) degree[i] += local[u] != C::kNone && u != vertices[i];
+            perm.resize(s);
+            for (size_t i = 0; i < s; ++i) perm[i] = i;
+            std::stable_sort(perm.begin(), perm.end(), [&](size_t a, size_t b) { return degree[a] > degree[b]; });
+            sorted.resize(s);
+            for (size_t i = 0; i < s; ++i) { sorted[i] = vertices[perm[i]]; local[sorted[i]] = (Index)i; }
+            vertices.swap(sorted);
+            adj.assign(s * words, 0);
+            for (size_t i = 0; i < s; ++i)
+                for (Index u : g.neighbors(vertices[i])) {
+                    Index j = local[u];
+                    if (j != C::kNone && j != i) adj[i * words + j / 64] |= uint64_t(1) << (j % 64);
+                }
+            for (Index u : vertices) local[u] = C::kNone;
+
+            clique.assign(1, v);
+            uint64_t* all = level(0);
+            std::fill(all, all + words, 0);
+            for (size_t i = 0; i < s; ++i) all[i / 64] |= uint64_t(1) << (i % 64);
+            expand(0);
+        }
+
+    private:
+        const C& g;
+        std::atomic<size_t>& bestSize;
+        std::vector<Index>& best;
+        std::mutex& record;
+        std::atomic<size_t>& nodes;
+        size_t limit;
+        std::atomic<bool>& stopped;
+        std::vector<Index> local, vertices, sorted, clique;
+        std::vector<size_t> degree, perm;
+        std::vector<uint64_t> adj, levels, scratch, q;
+        std::vector<std::vector<std::pair<Index, size_t>>> branches;
+        size_t words = 0;
+
+        uint64_t* level(size_t depth) {
+            if (levels.size() < (depth + 1) * words) levels.resize((depth + 1) * words);
+            return &levels[depth * words];
+        }
+
+        // Branches on the candidates at `depth` in decreasing colour order; a
+        // candidate of colour k can extend the current clique by at most k.
+        void expand(size_t depth) {
+            if (nodes.fetch_add(1, std::memory_order_relaxed) >= limit) { stopped.store(true, std::memory_order_relaxed); return; }
+            if (branches.size() <= depth) branches.resize(depth + 1);
+            colourSort(level(depth), branches[depth]);
+            for (size_t b = branches[depth].size(); b-- > 0;) {
+                auto [v, colour] = branches[depth][b];
+                if (clique.size() + colour <= bestSize.load(std::memory_order_relaxed)) return;
+                if (stopped.load(std::memory_order_relaxed)) return;
+                uint64_t* child = level(depth + 1); // may reallocate, so fetch the parent level after it
+                const uint64_t* cand = level(depth);
+                const uint64_t* row = &adj[v * words];
+                bool empty = true;
+                for (size_t w = 0; w < words; ++w) { child[w] = cand[w] & row[w]; empty &= child[w] == 0; }
+                clique.push_back(vertices[v]);
+                if (empty) improve();
+                else expand(depth + 1);
+                clique.pop_back();
+                level(depth)[v / 64] &= ~(uint64_t(1) << (v % 64));
+            }
+        }
+
+        // Greedy sequential colouring of the candidates in bitset form; only
+        // vertices whose colour could still beat the incumbent become branches.
+        void colourSort(const uint64_t* cand, std::vector<std::pair<Index, size_t>>& out) {
+            out.clear();
+            scratch.assign(cand, cand + words);
+            q.resize(words);
+            size_t need = bestSize.load(std::memory_order_relaxed) + 1, kmin = need > clique.size() ? need - clique.size() : 1;
+            for (size_t colour = 1;; ++colour) {
+                bool any = false;
+                for (size_t w = 0; w < words; ++w) { q[w] = scratch[w]; any |= q[w] != 0; }
+                if (!any) break;
+                for (size_t w = 0; w < words; ++w)
+                    while (q[w]) {
+                        Index v = (Index)(w * 64 + __builtin_ctzll(q[w]));
+                        const uint64_t* row = &adj[v * words];
+                        for (size_t x = w; x < words; ++x) q[x] &= ~row[x];
+                        q[w] &= ~(uint64_t(1) << (v % 64));
+                        scratch[w] &= ~(uint64_t(1) << (v % 64));
+                        if (colour >= kmin) out.push_back({v, colour});
+                    }
+            }
+        }
+
+        void improve() {
+            std::lock_guard<std::mutex> lock(record);
+            if (clique.size() <= bestSize.load(std::memory_order_relaxed)) return;
+            best = clique;
+            bestSize.store(clique.size(), std::memory_order_relaxed);
+        }
+    };
+};
@@ -0,0 +1,304 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Cliques.hpp"
+#include "Cores.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <mutex>
+
+// Proper vertex colouring over compact indices: color[v] in 0..colors-1.
+// lowerBound <= chromatic number <= colors; exact means they are equal.
+template <class Index>
+struct BasicColoring {
+    std::vector<Index> color;
+    size_t colors = 0, lowerBound = 0;
+    bool exact = false;
+};
+
+using Coloring = BasicColoring<CompactGraph::Index>;
+
+// Vertex colouring of a CompactGraph; self-loops are ignored.
+class VertexColoring {
+public:
+    // Greedy colouring in reverse degeneracy order: every vertex sees at most
+    // its core number of coloured neighbours, so at most degeneracy + 1 colours.
+    template <class C>
+    static BasicColoring<typename C::Index> SmallestLast(const C& g) {
+        using Index = typename C::Index;
+        auto cores = KCore::Decompose(g);
+        BasicColoring<Index> res;
+        res.color.assign(g.vertexCount(), C::kNone);
+        std::vector<size_t> taken;
+        for (size_t i = cores.order.size(); i-- > 0;)
+            res.colors = std::max(res.colors, (size_t)(res.color[cores.order[i]] = firstFree(g, cores.order[i], res.color, taken)) + 1);
+        res.lowerBound = std::min<size_t>(res.colors, 2); // one colour exactly when there is no edge
+        res.exact = res.colors == res.lowerBound;
+        return res;
+    }
+
+    // Exact chromatic number by DSATUR branch and bound (Brelaz 1979; Sewell
+    // 1996 style): colour the most saturated vertex next, trying every used
+    // colour and one new one, pruned by the best colouring so far. The lower
+    // bound is the maximum clique, which is also precoloured to break colour
+    // symmetry; vertices of degree < clique size are peeled off first and
+    // coloured greedily afterwards, since they can never need a new colour.
+    // The first levels of the search tree are split into tasks that the
+    // workers take dynamically while sharing the incumbent. `nodeLimit` bounds
+    // the clique search and the colouring search together; once it is spent,
+    // or without any search when the remaining kernel exceeds kMaxKernel
+    // vertices, the best colouring found is returned with exact = false. The
+    // lower bound is then the largest clique found, which is still a bound.
+    template <class C>
+    static BasicColoring<typename C::Index> Exact(const C& g, unsigned threads = 0, size_t nodeLimit = 50000000) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicColoring<Index> res = SmallestLast(g);
+        if (n == 0) return res;
+        BasicClique<Index> found = MaxClique::Bounded(g, threads, nodeLimit);
+        std::vector<Index>& clique = found.members;
+        nodeLimit -= found.nodes;
+        res.lowerBound = clique.size();
+        std::vector<Index> greedy = dsatur(g, res.colors - 1);
+        if (!greedy.empty()) {
+            res.color.swap(greedy);
+            res.colors = *std::max_element(res.color.begin(), res.color.end()) + 1;
+        }
+        res.exact = res.colors == res.lowerBound;
+        if (res.exact) return res;
+
+        // Kernel: the clique-size core, renumbered 0..m-1.
+        auto cores = KCore::Decompose(g);
+        std::vector<Index> local(n, C::kNone), members;
+        for (Index v = 0; v < n; ++v)
+            if (cores.core[v] >= res.lowerBound) { local[v] = (Index)members.size(); members.push_back(v); }
+        if (members.size() > kMaxKernel) return res;
+        Kernel<Index> kernel;
+        kernel.start.assign(members.size() + 1, 0);
+        for (size_t i = 0; i < members.size(); ++i) {
+            for (Index u : g.neighbors(members[i]))
+                if (local[u] != C::kNone && u != members[i]) kernel.adj.push_back(local[u]);
+            kernel.start[i + 1] = kernel.adj.size();
+        }
+        kernel.width = res.colors;
+        for (Index v : clique)
+            if (local[v] != C::kNone) kernel.fixed.push_back(local[v]);
+
+        std::atomic<size_t> best{res.colors}, nodes{0};
+        std::vector<Index> bestColor;
+        std::mutex record;
+        unsigned workers = Parallel::threadCount(threads);
+        std::vector<std::vector<std::pair<Index, Index>>> tasks = split(kernel, workers > 1 ? 8 * workers : 1);
+        std::atomic<size_t> next{0};
+        Parallel::forRange(0, workers, [&](size_t, size_t) {
+            Search<Index> search(kernel, best, nodes, nodeLimit, res.lowerBound, bestColor, record);
+            for (size_t t; (t = next.fetch_add(1, std::memory_order_relaxed)) < tasks.size();) search.run(tasks[t]);
+        }, workers);
+
+        bool finished = nodes.load() <= nodeLimit;
+        if (!bestColor.empty()) {
+            // Kernel colouring, then the peeled vertices in reverse peeling order.
+            std::fill(res.color.begin(), res.color.end(), C::kNone);
+            for (size_t i = 0; i < members.size(); ++i) res.color[members[i]] = bestColor[i];
+            std::vector<size_t> taken;
+            res.colors = best.load();
+            for (size_t i = n; i-- > 0;) {
+                Index v = cores.order[i];
+                if (local[v] != C::kNone) continue;
+                res.color[v] = firstFree(g, v, res.color, taken);
+                res.colors = std::max(res.colors, (size_t)res.color[v] + 1);
+            }
+        }
+        if (finished) res.lowerBound = res.colors;
+        res.exact = res.colors == res.lowerBound;
+        return res;
+    }
+
+    template <class C>
+    static bool IsProper(const C& g, const std::vector<typename C::Index>& color) {
+        for (typename C::Index v = 0; v < g.vertexCount(); ++v)
+            for (auto u : g.neighbors(v))
+                if (u != v && color[u] == color[v]) return false;
+        return true;
+    }
+
+private:
+    static constexpr size_t kMaxKernel = 1 << 14;
+
+    template <class Index>
+    struct Kernel {
+        std::vector<size_t> start;
+        std::vector<Index> adj, fixed; // fixed: clique vertices, precoloured 0..|fixed|-1
+        size_t width = 0;              // colours tracked per vertex (the initial upper bound)
+    };
+
+    // Smallest colour not used by a coloured neighbour; `taken` is scratch.
+    template <class C>
+    static typename C::Index firstFree(const C& g, typename C::Index v, const std::vector<typename C::Index>& color,
+                                       std::vector<size_t>& taken) {
+        taken.assign(g.degree(v) + 1, 0);
+        for (auto u : g.neighbors(v))
+            if (u != v && color[u] != C::kNone && color[u] < taken.size()) taken[color[u]] = 1;
+        return (typename C::Index)(std::find(taken.begin(), taken.end(), 0) - taken.begin());
+    }
+
+    // Greedy DSATUR colouring with at most `limit` colours (empty if it needs
+    // more). Bucket queue by saturation with lazy deletion, O(V + E + V limit / 64);
+    // within a bucket the vertex pushed last, initially the largest degree, goes first.
+    template <class C>
+    static std::vector<typename C::Index> dsatur(const C& g, size_t limit) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        if (limit == 0) return {};
+        size_t words = (limit + 63) / 64;
+        std::vector<uint64_t> seen(n * words, 0);
+        std::vector<size_t> saturation(n, 0);
+        std::vector<Index> color(n, C::kNone), order(n);
+        for (Index v = 0; v < n; ++v) order[v] = v;
+        std::stable_sort(order.begin(), order.end(), [&g](Index a, Index b) { return g.degree(a) < g.degree(b); });
+        std::vector<std::vector<Index>> buckets(limit + 1);
+        buckets[0] = order;
+        size_t top = 0;
+        for (Index done = 0; done < n;) {
+            while (buckets[top].empty()) top--;
+            Index v = buckets[top].back();
+            buckets[top].pop_back();
+            if (color[v] != C::kNone || saturation[v] != top) continue;
+            const uint64_t* mask = &seen[v * words];
+            size_t c = 0;
+            while (c < limit && (mask[c / 64] >> (c % 64) & 1)) c++;
+            if (c == limit) return {};
+            color[v] = (Index)c;
+            done++;
+            for (Index u : g.neighbors(v)) {
+                uint64_t& word = seen[u * words + c / 64];
+                if (color[u] != C::kNone || (word >> (c % 64) & 1)) continue;
+                word |= uint64_t(1) << (c % 64);
+                buckets[++saturation[u]].push_back(u);
+                top = std::max(top, saturation[u]);
+            }
+        }
+        return color;
+    }
+
+    // DSATUR state: per vertex the number of neighbours of each colour.
+    template <class Index>
+    struct State {
+        static constexpr Index kNone = std::numeric_limits<Index>::max();
+        const Kernel<Index>& k;
+        std::vector<Index> color;
+        std::vector<uint32_t> count, saturation;
+        size_t used = 0;
+
+        explicit State(const Kernel<Index>& k)
+            : k(k), color(k.start.size() - 1, kNone), count(color.size() * k.width, 0), saturation(color.size(), 0) {
+            for (Index v : k.fixed) assign(v, (Index)used++);
+        }
+
+        void assign(Index v, Index c) {
+            color[v] = c;
+            for (size_t i = k.start[v]; i < k.start[v + 1]; ++i)
+                if (count[k.adj[i] * k.width + c]++ == 0) saturation[k.adj[i]]++;
+        }
+
+        void unassign(Index v) {
+            Index c = color[v];
+            color[v] = kNone;
+            for (size_t i = k.start[v]; i < k.start[v + 1]; ++i)
+                if (--count[k.adj[i] * k.width + c] == 0) saturation[k.adj[i]]--;
+        }
+
+        // Most saturated uncoloured vertex, ties to the larger degree.
+        Index select() const {
+            Index best = kNone;
+            for (Index v = 0; v < (Index)color.size(); ++v) {
+                if (color[v] != kNone) continue;
+                if (best == kNone || saturation[v] > saturation[best] ||
+                    (saturation[v] == saturation[best] && k.start[v + 1] - k.start[v] > k.start[best + 1] - k.start[best]))
+                    best = v;
+            }
+            return best;
+        }
+
+        bool allowed(Index v, Index c) const { return count[v * k.width + c] == 0; }
+        // Colours worth trying at v: every used colour free at v, then one new colour.
+        std::vector<Index> options(Index v, size_t limit) const {
+            std::vector<Index> res;
+            for (Index c = 0; c < used; ++c) if (allowed(v, c)) res.push_back(c);
+            if (used + 1 < limit) res.push_back((Index)used);
+            return res;
+        }
+    };
+
+    // Breadth-first expansion of the top of the search tree into at least
+    // `want` partial assignments (or the whole tree, if it is smaller).
+    template <class Index>
+    static std::vector<std::vector<std::pair<Index, Index>>> split(const Kernel<Index>& k, size_t want) {
+        std::vector<std::vector<std::pair<Index, Index>>> frontier(1);
+        for (size_t depth = 0; frontier.size() < want && depth < 16; ++depth) {
+            std::vector<std::vector<std::pair<Index, Index>>> grown;
+            for (auto& task : frontier) {
+                State<Index> s(k);
+                for (auto [v, c] : task) { s.used = std::max(s.used, (size_t)c + 1); s.assign(v, c); }
+                Index v = s.select();
+                if (v == State<Index>::kNone) { grown.push_back(task); continue; }
+                for (Index c : s.options(v, k.width)) {
+                    grown.push_back(task);
+                    grown.back().push_back({v, c});
+                }
+            }
+            frontier.swap(grown);
+        }
+        return frontier;
+    }
+
+    template <class Index>
+    class Search {
+    public:
+        Search(const Kernel<Index>& k, std::atomic<size_t>& best, std::atomic<size_t>& nodes, size_t limit,
+               size_t lowerBound, std::vector<Index>& bestColor, std::mutex& record)
+            : k(k), best(best), nodes(nodes), limit(limit), lowerBound(lowerBound), bestColor(bestColor), record(record) {}
+
+        void run(const std::vector<std::pair<Index, Index>>& task) {
+            State<Index> s(k);
+            for (auto [v, c] : task) { s.used = std::max(s.used, (size_t)c + 1); s.assign(v, c); }
+            search(s);
+        }
+
+    private:
+        const Kernel<Index>& k;
+        std::atomic<size_t>& best;
+        std::atomic<size_t>& nodes;
+        size_t limit, lowerBound;
+        std::vector<Index>& bestColor;
+        std::mutex& record;
+
+        bool stop() const {
+            size_t b = best.load(std::memory_order_relaxed);
+            return b <= lowerBound || nodes.load(std::memory_order_relaxed) > limit;
+        }
+
+        void search(State<Index>& s) {
+            if (nodes.fetch_add(1, std::memory_order_relaxed) >= limit) { nodes.store(limit + 1); return; }
+            if (s.used >= best.load(std::memory_order_relaxed) || stop()) return;
+            Index v = s.select();
+            if (v == State<Index>::kNone) { improve(s); return; }
+            for (Index c : s.options(v, best.load(std::memory_order_relaxed))) {
+                if ((size_t)c + 1 >= best.load(std::memory_order_relaxed) && (size_t)c == s.used) break;
+                size_t used = s.used;
+                s.used = std::max(used, (size_t)c + 1);
+                s.assign(v, c);
+                search(s);
+                s.unassign(v);
+                s.used = used;
+                if (stop()) return;
+            }
+        }
+
+        void improve(const State<Index>& s) {
+            std::lock_guard<std::mutex> lock(record);
+            if (s.used >= best.load(std::memory_order_relaxed)) return;
+            bestColor = s.color;
+            best.store(s.used, std::memory_order_relaxed);
+        }
+    };
+};
@@ -0,0 +1,254 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <numeric>
+#include <random>
+
+// Community assignment over compact indices: label[v] in 0..count-1.
+template <class Index>
+struct BasicCommunities {
+    std::vector<Index> label;
+    size_t count = 0;
+    double modularity = 0.0;
+    size_t levels = 0; // aggregation levels (Louvain/Leiden) or sweeps (label propagation)
+};
+
+using Communities = BasicCommunities<CompactGraph::Index>;
+
+// Community detection on a CompactGraph; edge weights are used when present.
+// Modularity is Q = sum_c [in_c / 2m - resolution * (tot_c / 2m)^2].
+class CommunityDetection {
+public:
+    // Louvain (Blondel et al. 2008) with parallel local moving: every sweep
+    // moves vertices concurrently to their best neighbouring community against
+    // atomically maintained community totals, then communities are contracted
+    // through the bulk CSR builder and the next level works on the coarse graph.
+    template <class C>
+    static BasicCommunities<typename C::Index> Louvain(const C& g, double resolution = 1.0, unsigned threads = 0) {
+        return multilevel(g, resolution, threads, false);
+    }
+
+    // Louvain with the Leiden guarantee that communities are connected
+    // (Traag et al. 2019): before contraction every community is split into
+    // its connected components.
+    template <class C>
+    static BasicCommunities<typename C::Index> Leiden(const C& g, double resolution = 1.0, unsigned threads = 0) {
+        return multilevel(g, resolution, threads, true);
+    }
+
+    // Asynchronous label propagation (Raghavan et al. 2007): every vertex takes
+    // the label of largest total edge weight among its neighbours until a sweep
+    // changes nothing. Vertices are visited in a random order and ties keep the
+    // own label, else go to a pseudo-random one, both drawn from `seed`. Cheap,
+    // with no modularity target.
+    template <class C>
+    static BasicCommunities<typename C::Index> LabelPropagation(const C& g, size_t maxSweeps = 20, unsigned threads = 0,
+                                                                uint64_t seed = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<std::atomic<Index>> label(n);
+        for (Index v = 0; v < n; ++v) label[v].store(v, std::memory_order_relaxed);
+        std::vector<Index> order(n);
+        std::iota(order.begin(), order.end(), Index(0));
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(seed));
+        BasicCommunities<Index> res;
+        for (size_t changed = 1; changed && res.levels < maxSweeps; ++res.levels) {
+            std::atomic<size_t> moved{0};
+            Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+                std::vector<std::pair<Index, double>> links;
+                size_t local = 0;
+                for (size_t i = lo; i < hi; ++i) {
+                    Index v = order[i], own = label[v].load(std::memory_order_relaxed), best = own;
+                    double bestWeight = -1.0;
+                    uint64_t bestRank = 0, salt = seed + res.levels;
+                    for (auto [l, w] : neighbourWeights(g, v, label, links)) {
+                        uint64_t rank = l == own ? 0 : mix(l ^ salt);
+                        if (w > bestWeight || (w == bestWeight && rank < bestRank)) { best = l; bestWeight = w; bestRank = rank; }
+                    }
+                    if (best != own) { label[v].store(best, std::memory_order_relaxed); local++; }
+                }
+                moved.fetch_add(local, std::memory_order_relaxed);
+            }, threads);
+            changed = moved.load();
+        }
+        res.label.resize(n);
+        for (Index v = 0; v < n; ++v) res.label[v] = label[v].load(std::memory_order_relaxed);
+        res.count = renumber(res.label);
+        res.modularity = Modularity(g, res.label);
+        return res;
+    }
+
+    template <class C>
+    static double Modularity(const C& g, const std::vector<typename C::Index>& label, double resolution = 1.0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<double> tot(n ? *std::max_element(label.begin(), label.end()) + 1 : 0, 0.0);
+        double inside = 0.0, m2 = 0.0;
+        for (Index v = 0; v < n; ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) {
+                double w = g.weight(slot);
+                tot[label[v]] += w;
+                m2 += w;
+                if (label[v] == label[g.targets[slot]]) inside += w;
+            }
+        if (m2 == 0.0) return 0.0;
+        double q = inside / m2;
+        for (double t : tot) q -= resolution * (t / m2) * (t / m2);
+        return q;
+    }
+
+private:
+    static constexpr size_t kMaxSweeps = 32;
+
+    static uint64_t mix(uint64_t x) { // splitmix64 finalizer
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return (x ^ (x >> 31)) | 1;
+    }
+
+    static void add(std::atomic<double>& a, double d) {
+        double cur = a.load(std::memory_order_relaxed);
+        while (!a.compare_exchange_weak(cur, cur + d, std::memory_order_relaxed)) {}
+    }
+
+    // Total weight from v to each neighbouring label, self-loops skipped; uses `links` as scratch.
+    template <class C, class Index = typename C::Index>
+    static const std::vector<std::pair<Index, double>>& neighbourWeights(const C& g, Index v,
+            const std::vector<std::atomic<Index>>& label, std::vector<std::pair<Index, double>>& links) {
+        links.clear();
+        for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+            if (g.targets[slot] != v) links.push_back({label[g.targets[slot]].load(std::memory_order_relaxed), g.weight(slot)});
+        std::sort(links.begin(), links.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        size_t out = 0;
+        for (size_t i = 0; i < links.size(); ++i) {
+            if (out && links[out - 1].first == links[i].first) links[out - 1].second += links[i].second;
+            else links[out++] = links[i];
+        }
+        links.resize(out);
+        return links;
+    }
+
+    // Maps labels onto 0..k-1 in order of first appearance; returns k.
+    template <class Index>
+    static size_t renumber(std::vector<Index>& label) {
+        constexpr Index kNone = std::numeric_limits<Index>::max();
+        std::vector<Index> dense(label.size(), kNone);
+        Index next = 0;
+        for (Index& l : label) {
+            if (dense[l] == kNone) dense[l] = next++;
+            l = dense[l];
+        }
+        return next;
+    }
+
+    template <class C>
+    static BasicCommunities<typename C::Index> multilevel(const C& g, double resolution, unsigned threads, bool refine) {
+        using Index = typename C::Index;
+        BasicCommunities<Index> res;
+        res.label.resize(g.vertexCount());
+        std::iota(res.label.begin(), res.label.end(), Index(0));
+        C coarse;
+        const C* cur = &g;
+        while (true) {
+            std::vector<Index> comm = moveVertices(*cur, resolution, threads);
+            if (refine) comm = splitDisconnected(*cur, comm);
+            size_t k = renumber(comm);
+            if (k == cur->vertexCount()) break;
+            for (Index& l : res.label) l = comm[l];
+            C next = aggregate(*cur, comm, (Index)k, threads);
+            coarse = std::move(next);
+            cur = &coarse;
+            res.levels++;
+        }
+        res.count = renumber(res.label);
+        res.modularity = Modularity(g, res.label, resolution);
+        return res;
+    }
+
+    // Parallel local moving phase; returns each vertex's community (not dense).
+    template <class C>
+    static std::vector<typename C::Index> moveVertices(const C& g, double resolution, unsigned threads) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<double> k(n, 0.0);
+        for (Index v = 0; v < n; ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) k[v] += g.weight(slot);
+        double m2 = std::accumulate(k.begin(), k.end(), 0.0);
+        std::vector<std::atomic<Index>> comm(n);
+        std::vector<std::atomic<double>> tot(n);
+        std::vector<std::atomic<Index>> size(n);
+        for (Index v = 0; v < n; ++v) {
+            comm[v].store(v, std::memory_order_relaxed);
+            tot[v].store(k[v], std::memory_order_relaxed);
+            size[v].store(1, std::memory_order_relaxed);
+        }
+
+        for (size_t sweep = 0; m2 > 0.0 && sweep < kMaxSweeps; ++sweep) {
+            std::atomic<size_t> moved{0};
+            Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+                std::vector<std::pair<Index, double>> links;
+                size_t local = 0;
+                for (size_t v = lo; v < hi; ++v) {
+                    Index c = comm[v].load(std::memory_order_relaxed), best = c;
+                    const auto& around = neighbourWeights(g, (Index)v, comm, links);
+                    double scale = resolution * k[v] / m2, bestGain = 0.0;
+                    for (auto [d, w] : around) if (d == c) bestGain = w;
+                    bestGain -= (tot[c].load(std::memory_order_relaxed) - k[v]) * scale;
+                    for (auto [d, w] : around) {
+                        double gain = w - tot[d].load(std::memory_order_relaxed) * scale;
+                        if (d != c && gain > bestGain) { best = d; bestGain = gain; }
+                    }
+                    // Two singletons moving into each other at once would just swap; only the larger id moves.
+                    if (best == c || (best > c && size[c].load(std::memory_order_relaxed) == 1 &&
+                                      size[best].load(std::memory_order_relaxed) == 1)) continue;
+                    add(tot[c], -k[v]);
+                    add(tot[best], k[v]);
+                    size[c].fetch_sub(1, std::memory_order_relaxed);
+                    size[best].fetch_add(1, std::memory_order_relaxed);
+                    comm[v].store(best, std::memory_order_relaxed);
+                    local++;
+                }
+                moved.fetch_add(local, std::memory_order_relaxed);
+            }, threads);
+            if (moved.load() == 0) break;
+        }
+        std::vector<Index> res(n);
+        for (Index v = 0; v < n; ++v) res[v] = comm[v].load(std::memory_order_relaxed);
+        return res;
+    }
+
+    // Relabels every community by its connected components (BFS inside the community).
+    template <class C>
+    static std::vector<typename C::Index> splitDisconnected(const C& g, const std::vector<typename C::Index>& comm) {
+        using Index = typename C::Index;
+        constexpr Index kNone = std::numeric_limits<Index>::max();
+        Index n = g.vertexCount();
+        std::vector<Index> part(n, kNone), queue;
+        Index next = 0;
+        for (Index r = 0; r < n; ++r) {
+            if (part[r] != kNone) continue;
+            part[r] = next;
+            queue.assign(1, r);
+            while (!queue.empty()) {
+                Index v = queue.back(); queue.pop_back();
+                for (Index u : g.neighbors(v))
+                    if (part[u] == kNone && comm[u] == comm[v]) { part[u] = next; queue.push_back(u); }
+            }
+            next++;
+        }
+        return part;
+    }
+
+    // Contracts every community to one vertex; inner edges become a self-loop.
+    template <class C>
+    static C aggregate(const C& g, const std::vector<typename C::Index>& comm, typename C::Index k, unsigned threads) {
+        std::vector<typename C::Arc> arcs(g.targets.size());
+        Parallel::forRange(0, g.vertexCount(), [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v)
+                for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+                    arcs[slot] = {comm[v], comm[g.targets[slot]], g.weight(slot)};
+        }, threads);
+        return C::fromArcs(k, arcs, true, threads);
+    }
+};
@@ -0,0 +1,162 @@
+#pragma once
+#include "Graph.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <numeric>
+#include <tuple>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+// Read-only CSR copy of a graph. Vertices are renumbered 0..n-1 so that
+// algorithms can keep their state in flat arrays instead of maps.
+// Every adjacency row is sorted by index. V is the original id type (indices
+// use its unsigned counterpart), O the offset type, so a graph with 32-bit ids
+// and more than 2^32 edges is BasicCompactGraph<uint32_t, uint64_t>.
+// Edge weights, when the source graph has them, sit in `weights` parallel to
+// `targets`; an empty array means every edge weighs 1.
+template <class V = Graph::Vertex, class O = size_t>
+class BasicCompactGraph {
+public:
+    using Vertex = V;
+    using Index = std::make_unsigned_t<V>;
+    using Offset = O;
+    static constexpr Index kNone = std::numeric_limits<Index>::max();
+
+    struct Neighbors {
+        const Index* first;
+        const Index* last;
+        const Index* begin() const { return first; }
+        const Index* end() const { return last; }
+        size_t size() const { return last - first; }
+    };
+
+    template <class G>
+    static BasicCompactGraph fromGraph(const G& g) {
+        BasicCompactGraph c;
+        c.ids = g.getVertices();
+        Index n = c.ids.size();
+        c.rebuildLookup();
+        c.offsets.assign(n + 1, 0);
+        for (Index i = 0; i < n; ++i)
+            c.offsets[i + 1] = c.offsets[i] + g.neighbors(c.ids[i]).size();
+        c.targets.resize(c.offsets.back());
+        if constexpr (HasEdgeWeights<G>::value) {
+            if (g.isWeighted()) { c.fillWeighted(g); return c; }
+        }
+        for (Index i = 0; i < n; ++i) {
+            Offset pos = c.offsets[i];
+            for (auto u : g.neighbors(c.ids[i])) c.targets[pos++] = *c.lookup.find(u);
+            std::sort(c.targets.begin() + c.offsets[i], c.targets.begin() + pos);
+        }
+        return c;
+    }
+
+    // Bulk build from (source, target, weight) arcs over indices 0..n-1, in
+    // parallel. Arcs are taken as given, so an undirected edge is listed in both
+    // directions; repeated arcs are merged and their weights summed. Ids are the
+    // indices themselves. With `weighted` off the weights are dropped.
+    using Arc = std::tuple<Index, Index, double>;
+    static BasicCompactGraph fromArcs(Index n, const std::vector<Arc>& arcs, bool weighted = true, unsigned threads = 0) {
+        BasicCompactGraph c;
+        c.ids.resize(n);
+        for (Index i = 0; i < n; ++i) c.ids[i] = (Vertex)i;
+        c.rebuildLookup();
+
+        std::vector<std::atomic<Offset>> cursor(n + 1);
+        Parallel::forRange(0, arcs.size(), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) cursor[std::get<0>(arcs[i]) + 1].fetch_add(1, std::memory_order_relaxed);
+        }, threads);
+        std::vector<Offset> start(n + 1, 0);
+        for (Index v = 0; v < n; ++v) start[v + 1] = start[v] + cursor[v + 1].load(std::memory_order_relaxed);
+        for (Index v = 0; v < n; ++v) cursor[v].store(start[v], std::memory_order_relaxed);
+        std::vector<std::pair<Index, double>> slots(arcs.size());
+        Parallel::forRange(0, arcs.size(), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                auto [u, v, w] = arcs[i];
+                slots[cursor[u].fetch_add(1, std::memory_order_relaxed)] = {v, w};
+            }
+        }, threads);
+
+        // Sort and merge every row in place, then compact the rows.
+        std::vector<Offset> kept(n + 1, 0);
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                auto first = slots.begin() + start[v], last = slots.begin() + start[v + 1];
+                std::sort(first, last, [](const auto& a, const auto& b) { return a.first < b.first; });
+                auto out = first;
+                for (auto it = first; it != last; ++it) {
+                    if (out != first && (out - 1)->first == it->first) (out - 1)->second += it->second;
+                    else *out++ = *it;
+                }
+                kept[v + 1] = out - first;
+            }
+        }, threads);
+        c.offsets.assign(n + 1, 0);
+        for (Index v = 0; v < n; ++v) c.offsets[v + 1] = c.offsets[v] + kept[v + 1];
+        c.targets.resize(c.offsets.back());
+        if (weighted) c.weights.resize(c.offsets.back());
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v)
+                for (Offset k = 0; k < kept[v + 1]; ++k) {
+                    c.targets[c.offsets[v] + k] = slots[start[v] + k].first;
+                    if (weighted) c.weights[c.offsets[v] + k] = slots[start[v] + k].second;
+                }
+        }, threads);
+        return c;
+    }
+
+    size_t vertexCount() const { return ids.size(); }
+    size_t edgeCount() const { return targets.size() / 2; }
+    size_t degree(Index v) const { return offsets[v + 1] - offsets[v]; }
+
+    Neighbors neighbors(Index v) const {
+        return {targets.data() + offsets[v], targets.data() + offsets[v + 1]};
+    }
+
+    bool isWeighted() const { return !weights.empty(); }
+    double weight(Offset slot) const { return weights.empty() ? 1.0 : weights[slot]; }
+
+    // Builders that fill ids/offsets/targets directly call this to enable index().
+    void rebuildLookup() {
+        lookup = FlatHashMap<Vertex, Index>();
+        lookup.reserve(ids.size());
+        for (Index i = 0; i < (Index)ids.size(); ++i) *lookup.emplace(ids[i]).first = i;
+    }
+
+    Vertex id(Index v) const { return ids[v]; }
+    Index index(Vertex v) const {
+        const Index* i = lookup.find(v);
+        if (!i) throw std::out_of_range("CompactGraph::index: unknown vertex");
+        return *i;
+    }
+
+    std::vector<Offset> offsets;
+    std::vector<Index> targets;
+    std::vector<Vertex> ids;
+    std::vector<double> weights;
+
+private:
+    template <class G>
+    void fillWeighted(const G& g) {
+        weights.resize(targets.size());
+        std::vector<std::pair<Index, double>> row;
+        for (Index i = 0; i < (Index)ids.size(); ++i) {
+            row.clear();
+            for (auto u : g.neighbors(ids[i])) row.push_back({*lookup.find(u), g.weight(ids[i], u)});
+            std::sort(row.begin(), row.end());
+            for (size_t k = 0; k < row.size(); ++k) {
+                targets[offsets[i] + k] = row[k].first;
+                weights[offsets[i] + k] = row[k].second;
+            }
+        }
+    }
+
+    FlatHashMap<Vertex, Index> lookup;
+};
+
+using CompactGraph = BasicCompactGraph<>;
+
+// CSR type matching a graph's vertex id width.
+template <class G, class O = size_t>
+using CompactOf = BasicCompactGraph<typename G::Vertex, O>;
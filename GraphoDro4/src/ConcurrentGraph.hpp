@@ -0,0 +1,129 @@
+#pragma once
+#include "Graph.hpp"
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <mutex>
+#include <numeric>
+
+// Insert-only graph that many threads can fill at once. Vertices are spread over
+// lock-striped shards by id hash; addEdge locks the two endpoint shards one after
+// the other (never both), so producers only contend when they hit the same shard.
+// Neighbour lists are plain append buffers, duplicates are removed by freeze().
+template <class V = Graph::Vertex>
+class BasicConcurrentGraph {
+public:
+    using Vertex = V;
+    using Compact = BasicCompactGraph<V>;
+
+    explicit BasicConcurrentGraph(size_t shardCount = 0) {
+        size_t want = shardCount ? shardCount : 64 * (size_t)Parallel::threadCount();
+        size_t n = 1;
+        while (n < want) n *= 2;
+        shards = std::vector<Shard>(n);
+    }
+
+    void addVertex(Vertex v) {
+        Shard& s = shardOf(v);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.slotOf(v);
+    }
+
+    void addEdge(Vertex u, Vertex v) {
+        append(u, v);
+        if (u != v) append(v, u);
+    }
+
+    // Not thread-safe with concurrent writers.
+    size_t vertexCount() const {
+        size_t n = 0;
+        for (auto& s : shards) n += s.ids.size();
+        return n;
+    }
+
+    // Read-optimized CSR snapshot: ids are numbered shard by shard, every row is
+    // deduplicated and sorted. Shards are converted in parallel. Must not run
+    // concurrently with writers.
+    Compact freeze() const {
+        Compact c;
+        std::vector<size_t> base(shards.size() + 1, 0);
+        for (size_t s = 0; s < shards.size(); ++s) base[s + 1] = base[s] + shards[s].ids.size();
+        size_t n = base.back();
+        c.ids.resize(n);
+        std::vector<std::vector<typename Compact::Index>> rows(n);
+
+        Parallel::forRange(0, shards.size(), [&](size_t lo, size_t hi) {
+            for (size_t s = lo; s < hi; ++s) {
+                const Shard& shard = shards[s];
+                for (size_t i = 0; i < shard.ids.size(); ++i) {
+                    c.ids[base[s] + i] = shard.ids[i];
+                    auto& row = rows[base[s] + i];
+                    row.reserve(shard.lists[i].size());
+                    for (Vertex u : shard.lists[i]) {
+                        size_t owner = shardIndex(u);
+                        row.push_back(base[owner] + *shards[owner].slots.find(u));
+                    }
+                    std::sort(row.begin(), row.end());
+                    row.erase(std::unique(row.begin(), row.end()), row.end());
+                }
+            }
+        });
+
+        c.offsets.assign(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) c.offsets[i + 1] = c.offsets[i] + rows[i].size();
+        c.targets.resize(c.offsets.back());
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i)
+                std::copy(rows[i].begin(), rows[i].end(), c.targets.begin() + c.offsets[i]);
+        });
+        c.rebuildLookup();
+        return c;
+    }
+
+    BasicGraph<Vertex> toGraph() const {
+        BasicGraph<Vertex> g;
+        for (auto& s : shards) for (Vertex v : s.ids) g.addVertex(v);
+        for (auto& s : shards)
+            for (size_t i = 0; i < s.ids.size(); ++i)
+                for (Vertex u : s.lists[i]) g.addEdge(s.ids[i], u);
+        return g;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        FlatHashMap<Vertex, uint32_t> slots;
+        std::vector<Vertex> ids;
+        std::vector<std::vector<Vertex>> lists;
+
+        uint32_t slotOf(Vertex v) {
+            if (v == BasicGraph<Vertex>::kNoVertex) throw std::invalid_argument("ConcurrentGraph: reserved vertex id");
+            auto [slot, inserted] = slots.emplace(v);
+            if (inserted) {
+                *slot = ids.size();
+                ids.push_back(v);
+                lists.emplace_back();
+            }
+            return *slot;
+        }
+    };
+
+    // splitmix64 finaliser; must not correlate with the Fibonacci hash used inside each shard's table.
+    size_t shardIndex(Vertex v) const {
+        uint64_t x = (uint64_t)v + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return (x ^ (x >> 31)) & (shards.size() - 1);
+    }
+
+    Shard& shardOf(Vertex v) { return shards[shardIndex(v)]; }
+
+    void append(Vertex from, Vertex to) {
+        Shard& s = shardOf(from);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.lists[s.slotOf(from)].push_back(to);
+    }
+
+    std::vector<Shard> shards;
+};
+
+using ConcurrentGraph = BasicConcurrentGraph<>;
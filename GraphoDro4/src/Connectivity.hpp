@@ -0,0 +1,325 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "MaxFlow.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <tuple>
+
+// Edge cut over compact indices: `side` is one shore (sorted), weight the
+// total weight of the edges leaving it (the edge count when unweighted).
+template <class Index>
+struct BasicCut {
+    double weight = 0.0;
+    std::vector<Index> side;
+};
+
+using Cut = BasicCut<CompactGraph::Index>;
+
+// Minimum cuts and connectivity numbers of a CompactGraph; self-loops are ignored.
+class Connectivity {
+public:
+    // Stoer-Wagner (1997): n - 1 maximum-adjacency phases, each ending in a
+    // cut-of-the-phase and the merge of its last two vertices. Adjacency lists
+    // are moved on merge and resolved through union-find, so each phase is
+    // O(m log n) with a lazy heap. A disconnected graph yields a weight-0 cut.
+    template <class C>
+    static BasicCut<typename C::Index> StoerWagner(const C& g) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicCut<Index> best;
+        best.weight = std::numeric_limits<double>::infinity();
+        if (n < 2) { best.weight = 0.0; return best; }
+        std::vector<std::vector<std::pair<Index, double>>> adj(n);
+        for (Index v = 0; v < n; ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+                if (g.targets[slot] != v) adj[v].push_back({g.targets[slot], g.weight(slot)});
+        std::vector<Index> up(n);
+        std::iota(up.begin(), up.end(), Index(0));
+        auto find = [&up](Index v) {
+            while (up[v] != v) { up[v] = up[up[v]]; v = up[v]; }
+            return v;
+        };
+        std::vector<std::vector<Index>> members(n);
+        for (Index v = 0; v < n; ++v) members[v] = {v};
+        std::vector<Index> alive(n);
+        std::iota(alive.begin(), alive.end(), Index(0));
+        std::vector<double> key(n);
+        std::vector<char> added(n);
+
+        while (alive.size() > 1) {
+            for (Index v : alive) { key[v] = 0.0; added[v] = 0; }
+            std::priority_queue<std::pair<double, Index>> heap;
+            heap.push({0.0, alive[0]});
+            Index prev = alive[0], last = alive[0];
+            double phaseCut = 0.0;
+            for (size_t count = 0; count < alive.size();) {
+                Index v = 0;
+                double k;
+                if (heap.empty()) { // disconnected: the rest is unreachable, cut weight 0
+                    for (Index u : alive) if (!added[u]) { v = u; break; }
+                    k = 0.0;
+                } else {
+                    std::tie(k, v) = heap.top();
+                    heap.pop();
+                    if (added[v] || k != key[v]) continue;
+                }
+                added[v] = 1;
+                count++;
+                prev = last; last = v; phaseCut = k;
+                for (auto& [u, w] : adj[v]) {
+                    u = find(u);
+                    if (added[u] || u == v) continue;
+                    key[u] += w;
+                    heap.push({key[u], u});
+                }
+            }
+            if (phaseCut < best.weight) { best.weight = phaseCut; best.side = members[last]; }
+            // Merge `last` into `prev`.
+            up[last] = prev;
+            members[prev].insert(members[prev].end(), members[last].begin(), members[last].end());
+            members[last].clear();
+            adj[prev].insert(adj[prev].end(), adj[last].begin(), adj[last].end());
+            adj[last].clear();
+            adj[last].shrink_to_fit();
+            alive.erase(std::find(alive.begin(), alive.end(), last));
+            if (best.weight == 0.0) break;
+        }
+        std::sort(best.side.begin(), best.side.end());
+        return best;
+    }
+
+    // Karger-Stein (1996) recursive contraction: contract to n / sqrt(2) + 1
+    // vertices twice, recurse on both, keep the lighter cut; branches of at most
+    // kExactLimit vertices are solved exactly. Contraction order
+    // is an exponential clock per edge (rate = weight), i.e. Karger's weighted
+    // random contraction. Each trial finds a minimum cut with probability
+    // Omega(1 / log n); trials (default ceil(log2 n)^2) run in parallel and the
+    // result is the lightest cut, lowest trial index on ties.
+    template <class C>
+    static BasicCut<typename C::Index> KargerStein(const C& g, size_t trials = 0, unsigned threads = 0,
+                                                   uint64_t seed = std::random_device{}()) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicCut<Index> best;
+        if (n < 2) return best;
+        std::vector<WeightedEdge> edges;
+        for (Index v = 0; v < n; ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+                if (v < g.targets[slot]) edges.push_back({(uint32_t)v, (uint32_t)g.targets[slot], g.weight(slot)});
+        if (trials == 0) {
+            size_t lg = (size_t)std::ceil(std::log2((double)n));
+            trials = std::max<size_t>(1, lg * lg);
+        }
+        std::vector<std::pair<double, std::vector<char>>> found(trials);
+        Parallel::forRange(0, trials, [&](size_t lo, size_t hi) {
+            for (size_t t = lo; t < hi; ++t) {
+                std::mt19937_64 rng(seed ^ (0x9e3779b97f4a7c15ULL * (t + 1)));
+                found[t] = recursiveContract(edges, (uint32_t)n, rng);
+            }
+        }, threads);
+        size_t pick = 0;
+        for (size_t t = 1; t < trials; ++t) if (found[t].first < found[pick].first) pick = t;
+        best.weight = found[pick].first;
+        const auto& shore = found[pick].second;
+        for (Index v = 0; v < n; ++v) if (shore[v] == shore[0]) best.side.push_back(v);
+        return best;
+    }
+
+    // Minimum s-t cut by Dinic on the graph with each edge a two-way arc of its weight.
+    template <class C>
+    static BasicCut<typename C::Index> MinimumCut(const C& g, typename C::Index s, typename C::Index t) {
+        using Index = typename C::Index;
+        FlowNetwork net(g.vertexCount());
+        for (Index v = 0; v < g.vertexCount(); ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+                if (v < g.targets[slot]) net.addEdge(v, g.targets[slot], g.weight(slot), g.weight(slot));
+        BasicCut<Index> cut;
+        cut.weight = net.maxFlow(s, t);
+        std::vector<char> side = net.sourceSide(s);
+        for (Index v = 0; v < g.vertexCount(); ++v) if (side[v]) cut.side.push_back(v);
+        return cut;
+    }
+
+    // Edge connectivity lambda(G): the fewest edges whose removal disconnects
+    // G, ignoring weights. lambda = min over v != s of the s-v flow with unit
+    // capacities, each flow capped at the best value so far (at most the
+    // minimum degree); targets are split over the workers.
+    template <class C>
+    static size_t EdgeConnectivity(const C& g, unsigned threads = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        if (n < 2) return 0;
+        size_t minDegree = n;
+        for (Index v = 0; v < n; ++v) minDegree = std::min(minDegree, simpleDegree(g, v));
+        std::atomic<size_t> best{minDegree};
+        Parallel::forRange(1, n, [&](size_t lo, size_t hi) {
+            FlowNetwork net(n);
+            for (Index v = 0; v < n; ++v)
+                for (Index u : g.neighbors(v)) if (v < u) net.addEdge(v, u, 1.0, 1.0);
+            for (size_t t = lo; t < hi && best.load(std::memory_order_relaxed) > 0; ++t) {
+                net.reset();
+                lower(best, (size_t)std::llround(net.maxFlow(0, t, (double)best.load(std::memory_order_relaxed))));
+            }
+        }, threads);
+        return best.load();
+    }
+
+    // Vertex connectivity kappa(G): the fewest vertices whose removal
+    // disconnects G (n - 1 for complete graphs). Local connectivities come
+    // from unit flows on the split graph (v_in -> v_out of capacity 1), and
+    // by Even's argument only pairs (v_i, v_j), i <= kappa, need checking:
+    // some v_i with i <= kappa avoids any minimum separator.
+    template <class C>
+    static size_t VertexConnectivity(const C& g, unsigned threads = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        if (n < 2) return 0;
+        size_t minDegree = n;
+        for (Index v = 0; v < n; ++v) minDegree = std::min(minDegree, simpleDegree(g, v));
+        std::atomic<size_t> best{std::min<size_t>(minDegree, n - 1)};
+        auto adjacent = [&g](Index a, Index b) {
+            auto row = g.neighbors(a);
+            return std::binary_search(row.begin(), row.end(), b);
+        };
+        for (size_t i = 0; i < n && i <= best.load(); ++i) {
+            Parallel::forRange(i + 1, n, [&](size_t lo, size_t hi) {
+                FlowNetwork net(2 * (size_t)n);
+                for (Index v = 0; v < n; ++v) {
+                    net.addEdge(2 * (size_t)v, 2 * (size_t)v + 1, 1.0);
+                    for (Index u : g.neighbors(v)) if (u != v) net.addEdge(2 * (size_t)v + 1, 2 * (size_t)u, (double)n);
+                }
+                for (size_t j = lo; j < hi && best.load(std::memory_order_relaxed) > 0; ++j) {
+                    if (adjacent((Index)i, (Index)j)) continue;
+                    net.reset();
+                    double k = net.maxFlow(2 * i + 1, 2 * j, (double)best.load(std::memory_order_relaxed));
+                    lower(best, (size_t)std::llround(k));
+                }
+            }, threads);
+        }
+        return best.load();
+    }
+
+private:
+    static constexpr uint32_t kExactLimit = 32;
+
+    struct WeightedEdge {
+        uint32_t u, v;
+        double w;
+    };
+
+    template <class C>
+    static size_t simpleDegree(const C& g, typename C::Index v) {
+        auto row = g.neighbors(v);
+        return g.degree(v) - std::binary_search(row.begin(), row.end(), v);
+    }
+
+    static void lower(std::atomic<size_t>& a, size_t value) {
+        size_t cur = a.load(std::memory_order_relaxed);
+        while (value < cur && !a.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+    }
+
+    // Contracts the multigraph on `n` super-vertices down to `target` by exponential
+    // clocks; `dense` receives the super-vertex each current vertex lands in.
+    // Returns the contracted edge list over 0..target-1, self-loops dropped and
+    // parallel edges merged, so it never exceeds target^2 / 2 entries.
+    static std::vector<WeightedEdge> contract(const std::vector<WeightedEdge>& edges, uint32_t n, uint32_t target,
+                                              std::vector<uint32_t>& dense, std::mt19937_64& rng) {
+        std::vector<std::pair<double, uint32_t>> clock(edges.size());
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        for (uint32_t e = 0; e < edges.size(); ++e)
+            clock[e] = {edges[e].w > 0 ? -std::log1p(-unit(rng)) / edges[e].w : std::numeric_limits<double>::infinity(), e};
+        std::sort(clock.begin(), clock.end());
+        std::vector<uint32_t> up(n);
+        std::iota(up.begin(), up.end(), 0u);
+        auto find = [&up](uint32_t v) {
+            while (up[v] != v) { up[v] = up[up[v]]; v = up[v]; }
+            return v;
+        };
+        uint32_t parts = n;
+        for (size_t i = 0; i < clock.size() && parts > target; ++i) {
+            uint32_t a = find(edges[clock[i].second].u), b = find(edges[clock[i].second].v);
+            if (a != b) { up[std::max(a, b)] = std::min(a, b); parts--; }
+        }
+        // Disconnected leftovers beyond `target` are merged arbitrarily; that only
+        // happens when the current graph already has a weight-0 cut.
+        dense.assign(n, UINT32_MAX);
+        uint32_t next = 0;
+        for (uint32_t v = 0; v < n; ++v) {
+            uint32_t r = find(v);
+            if (dense[r] == UINT32_MAX) dense[r] = next < target ? next++ : target - 1;
+            dense[v] = dense[r];
+        }
+        std::vector<WeightedEdge> out;
+        for (const WeightedEdge& e : edges)
+            if (dense[e.u] != dense[e.v]) out.push_back({std::min(dense[e.u], dense[e.v]), std::max(dense[e.u], dense[e.v]), e.w});
+        std::sort(out.begin(), out.end(), [](const WeightedEdge& a, const WeightedEdge& b) {
+            return std::tie(a.u, a.v) < std::tie(b.u, b.v);
+        });
+        size_t kept = 0;
+        for (size_t i = 0; i < out.size(); ++i) {
+            if (kept && out[kept - 1].u == out[i].u && out[kept - 1].v == out[i].v) out[kept - 1].w += out[i].w;
+            else out[kept++] = out[i];
+        }
+        out.resize(kept);
+        return out;
+    }
+
+    // Stoer-Wagner on an adjacency matrix: O(n^3), used once a recursion branch
+    // is down to kExactLimit super-vertices. Same result shape as recursiveContract.
+    static std::pair<double, std::vector<char>> denseMinCut(const std::vector<WeightedEdge>& edges, uint32_t n) {
+        std::pair<double, std::vector<char>> best{std::numeric_limits<double>::infinity(), std::vector<char>(n, 1)};
+        if (n < 2) { best.first = 0.0; return best; }
+        std::vector<double> w((size_t)n * n, 0.0), key(n);
+        for (const WeightedEdge& e : edges) { w[(size_t)e.u * n + e.v] += e.w; w[(size_t)e.v * n + e.u] += e.w; }
+        std::vector<uint32_t> group(n), alive(n);
+        std::iota(group.begin(), group.end(), 0u);
+        std::iota(alive.begin(), alive.end(), 0u);
+        std::vector<char> added(n);
+        while (alive.size() > 1) {
+            for (uint32_t v : alive) { key[v] = 0.0; added[v] = 0; }
+            uint32_t prev = alive[0], last = alive[0];
+            for (size_t step = 0; step < alive.size(); ++step) {
+                uint32_t pick = 0;
+                double top = -1.0;
+                for (uint32_t v : alive) if (!added[v] && key[v] > top) { top = key[v]; pick = v; }
+                added[pick] = 1;
+                prev = last; last = pick;
+                for (uint32_t v : alive) if (!added[v]) key[v] += w[(size_t)pick * n + v];
+            }
+            if (key[last] < best.first) {
+                best.first = key[last];
+                for (uint32_t v = 0; v < n; ++v) best.second[v] = group[v] == last;
+            }
+            for (uint32_t v : alive) { w[(size_t)prev * n + v] += w[(size_t)last * n + v]; w[(size_t)v * n + prev] = w[(size_t)prev * n + v]; }
+            w[(size_t)prev * n + prev] = 0.0;
+            for (uint32_t& g : group) if (g == last) g = prev;
+            alive.erase(std::find(alive.begin(), alive.end(), last));
+        }
+        return best;
+    }
+
+    // Returns the cut weight and its shore as a 0/1 flag per vertex 0..n-1.
+    // Shores are mapped back one level at a time, so no call touches more than
+    // its own n vertices.
+    static std::pair<double, std::vector<char>> recursiveContract(const std::vector<WeightedEdge>& edges, uint32_t n,
+                                                                  std::mt19937_64& rng) {
+        if (n <= kExactLimit) return denseMinCut(edges, n);
+        uint32_t target = (uint32_t)std::ceil(1.0 + n / std::sqrt(2.0));
+        std::pair<double, std::vector<char>> best{std::numeric_limits<double>::infinity(), std::vector<char>(n, 1)};
+        std::vector<uint32_t> dense;
+        for (int branch = 0; branch < 2; ++branch) {
+            std::vector<WeightedEdge> contracted = contract(edges, n, target, dense, rng);
+            auto candidate = recursiveContract(contracted, target, rng);
+            if (candidate.first < best.first) {
+                best.first = candidate.first;
+                for (uint32_t v = 0; v < n; ++v) best.second[v] = candidate.second[dense[v]];
+            }
+        }
+        return best;
+    }
+};
@@ -0,0 +1,170 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+// Fibonacci hashing: spreads consecutive ids over the whole table.
+template <class T>
+inline size_t flatHash(T key, unsigned shift) {
+    return (size_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+// Keys equal to emptyKey<T>() cannot be stored; it marks free slots.
+template <class T>
+constexpr T emptyKey() {
+    return std::numeric_limits<T>::is_signed ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+}
+
+// Open-addressing set with linear probing, no deletion.
+template <class T>
+class FlatHashSet {
+public:
+    bool contains(T key) const {
+        if (slots.empty()) return false;
+        for (size_t i = flatHash(key, shift);; i = (i + 1) & mask()) {
+            if (slots[i] == key) return true;
+            if (slots[i] == emptyKey<T>()) return false;
+        }
+    }
+
+    bool insert(T key) {
+        if ((count + 1) * 2 > slots.size()) rehash(std::max<size_t>(16, slots.size() * 2));
+        for (size_t i = flatHash(key, shift);; i = (i + 1) & mask()) {
+            if (slots[i] == key) return false;
+            if (slots[i] == emptyKey<T>()) { slots[i] = key; count++; return true; }
+        }
+    }
+
+    size_t size() const { return count; }
+
+private:
+    size_t mask() const { return slots.size() - 1; }
+
+    void rehash(size_t capacity) {
+        std::vector<T> old(capacity, emptyKey<T>());
+        old.swap(slots);
+        shift = 64 - __builtin_ctzll(capacity);
+        count = 0;
+        for (T k : old) if (k != emptyKey<T>()) insert(k);
+    }
+
+    std::vector<T> slots;
+    size_t count = 0;
+    unsigned shift = 64;
+};
+
+// Open-addressing map with linear probing, no deletion.
+template <class K, class V>
+class FlatHashMap {
+public:
+    const V* find(K key) const {
+        if (keys.empty()) return nullptr;
+        for (size_t i = flatHash(key, shift);; i = (i + 1) & mask()) {
+            if (keys[i] == key) return &values[i];
+            if (keys[i] == emptyKey<K>()) return nullptr;
+        }
+    }
+
+    // Returns the value slot for key and whether it was newly created (value-initialized).
+    std::pair<V*, bool> emplace(K key) {
+        if ((count + 1) * 10 > keys.size() * 7) rehash(std::max<size_t>(16, keys.size() * 2));
+        for (size_t i = flatHash(key, shift);; i = (i + 1) & mask()) {
+            if (keys[i] == key) return {&values[i], false};
+            if (keys[i] == emptyKey<K>()) {
+                keys[i] = key;
+                count++;
+                return {&values[i], true};
+            }
+        }
+    }
+
+    void reserve(size_t n) {
+        size_t capacity = 16;
+        while (capacity * 7 < n * 10) capacity *= 2;
+        if (capacity > keys.size()) rehash(capacity);
+    }
+
+    size_t size() const { return count; }
+
+private:
+    size_t mask() const { return keys.size() - 1; }
+
+    void rehash(size_t capacity) {
+        std::vector<K> oldKeys(capacity, emptyKey<K>());
+        std::vector<V> oldValues(capacity);
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+        shift = 64 - __builtin_ctzll(capacity);
+        count = 0;
+        for (size_t i = 0; i < oldKeys.size(); ++i)
+            if (oldKeys[i] != emptyKey<K>()) *emplace(oldKeys[i]).first = std::move(oldValues[i]);
+    }
+
+    std::vector<K> keys;
+    std::vector<V> values;
+    size_t count = 0;
+    unsigned shift = 64;
+};
+
+// Vector that keeps up to N trivially copyable elements inline before it allocates.
+template <class T, unsigned N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector stores raw copies");
+public:
+    SmallVector() = default;
+    SmallVector(const SmallVector& other) { *this = other; }
+    SmallVector(SmallVector&& other) noexcept { *this = std::move(other); }
+    ~SmallVector() { if (heap) delete[] heap; }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this == &other) return *this;
+        clear();
+        reserve(other.len);
+        std::memcpy(data(), other.data(), other.len * sizeof(T));
+        len = other.len;
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this == &other) return *this;
+        if (heap) delete[] heap;
+        heap = other.heap; cap = other.cap; len = other.len;
+        if (!heap) std::memcpy(local, other.local, len * sizeof(T));
+        other.heap = nullptr; other.cap = N; other.len = 0;
+        return *this;
+    }
+
+    void push_back(T x) {
+        if (len == cap) reserve(cap * 2);
+        data()[len++] = x;
+    }
+
+    void reserve(uint32_t n) {
+        if (n <= cap) return;
+        T* grown = new T[n];
+        std::memcpy(grown, data(), len * sizeof(T));
+        if (heap) delete[] heap;
+        heap = grown;
+        cap = n;
+    }
+
+    void clear() { len = 0; }
+
+    T* data() { return heap ? heap : local; }
+    const T* data() const { return heap ? heap : local; }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + len; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    const T& operator[](size_t i) const { return data()[i]; }
+
+private:
+    T* heap = nullptr;
+    uint32_t cap = N, len = 0;
+    T local[N];
+};
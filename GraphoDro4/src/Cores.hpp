@@ -0,0 +1,115 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <mutex>
+
+template <class Index>
+struct BasicCoreResult {
+    std::vector<Index> core;  // core number per compact index
+    std::vector<Index> order; // degeneracy ordering (peeling order)
+    Index degeneracy = 0;
+};
+
+using CoreResult = BasicCoreResult<CompactGraph::Index>;
+
+class KCore {
+public:
+    // Batagelj-Zaversnik bucket queue, O(V + E).
+    template <class C>
+    static BasicCoreResult<typename C::Index> Decompose(const C& g) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicCoreResult<Index> res;
+        res.core.resize(n);
+        res.order.resize(n);
+        if (n == 0) return res;
+
+        std::vector<Index> deg(n), pos(n);
+        Index maxDeg = 0;
+        for (Index v = 0; v < n; ++v) maxDeg = std::max(maxDeg, deg[v] = (Index)g.degree(v));
+
+        std::vector<Index> bin(maxDeg + 1, 0);
+        for (Index v = 0; v < n; ++v) bin[deg[v]]++;
+        for (Index d = 0, start = 0; d <= maxDeg; ++d) {
+            Index cnt = bin[d];
+            bin[d] = start;
+            start += cnt;
+        }
+        auto& vert = res.order;
+        for (Index v = 0; v < n; ++v) {
+            pos[v] = bin[deg[v]]++;
+            vert[pos[v]] = v;
+        }
+        for (Index d = maxDeg; d > 0; --d) bin[d] = bin[d - 1];
+        bin[0] = 0;
+
+        for (Index i = 0; i < n; ++i) {
+            Index v = vert[i];
+            res.core[v] = deg[v];
+            res.degeneracy = std::max(res.degeneracy, deg[v]);
+            for (Index u : g.neighbors(v)) {
+                if (deg[u] <= deg[v]) continue;
+                Index du = deg[u], pu = pos[u], pw = bin[du];
+                Index w = vert[pw];
+                if (u != w) {
+                    pos[u] = pw; vert[pu] = w;
+                    pos[w] = pu; vert[pw] = u;
+                }
+                bin[du]++;
+                deg[u]--;
+            }
+        }
+        return res;
+    }
+
+    // Level-synchronous peeling: every vertex whose degree drops to k is
+    // removed in the same round, neighbours are decremented concurrently.
+    template <class C>
+    static BasicCoreResult<typename C::Index> DecomposeParallel(const C& g, unsigned threads = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicCoreResult<Index> res;
+        res.core.resize(n);
+        res.order.reserve(n);
+        if (n == 0) return res;
+
+        std::vector<std::atomic<Index>> deg(n);
+        std::vector<char> done(n, 0);
+        for (Index v = 0; v < n; ++v) deg[v].store((Index)g.degree(v), std::memory_order_relaxed);
+
+        std::vector<Index> remaining(n);
+        for (Index v = 0; v < n; ++v) remaining[v] = v;
+        std::vector<Index> frontier;
+        std::mutex merge;
+
+        Index k = 0;
+        while (!remaining.empty()) {
+            k = deg[remaining[0]].load(std::memory_order_relaxed);
+            for (Index v : remaining) k = std::min(k, deg[v].load(std::memory_order_relaxed));
+            frontier.clear();
+            for (Index v : remaining) if (deg[v].load(std::memory_order_relaxed) <= k) frontier.push_back(v);
+
+            while (!frontier.empty()) {
+                for (Index v : frontier) { done[v] = 1; res.core[v] = k; res.order.push_back(v); }
+                std::vector<Index> next;
+                Parallel::forRange(0, frontier.size(), [&](size_t lo, size_t hi) {
+                    std::vector<Index> local;
+                    for (size_t i = lo; i < hi; ++i) {
+                        for (Index u : g.neighbors(frontier[i])) {
+                            if (done[u]) continue;
+                            if (deg[u].fetch_sub(1, std::memory_order_relaxed) == k + 1) local.push_back(u);
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(merge);
+                    next.insert(next.end(), local.begin(), local.end());
+                }, threads);
+                frontier.swap(next);
+            }
+            res.degeneracy = k;
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                           [&](Index v) { return done[v]; }), remaining.end());
+        }
+        return res;
+    }
+};
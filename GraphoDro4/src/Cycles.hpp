@@ -0,0 +1,295 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "SpanningTrees.hpp"
+#include "Scheduler.hpp"
+#include <atomic>
+#include <random>
+
+// Cycle structure of a CompactGraph. A cycle is the sequence of its vertices by
+// compact index, the edge from the last vertex back to the first is implied.
+// Lengths count edges; weights are not taken into account.
+class Cycles {
+public:
+    template <class C>
+    using Cycle = std::vector<typename C::Index>;
+
+    // Some cycle, or an empty sequence for a forest. Iterative DFS keeping each
+    // vertex's position on the current path, so a back edge is resolved in O(1)
+    // and the whole search is O(V + E).
+    template <class C>
+    static Cycle<C> Find(const C& g) { return find(g, nullptr); }
+
+    // Same with a random start vertex and a random rotation of every adjacency row.
+    template <class C>
+    static Cycle<C> Random(const C& g, uint64_t seed = std::random_device{}()) {
+        std::mt19937_64 rng(seed);
+        return find(g, &rng);
+    }
+
+    // Length of the shortest cycle, 0 for a forest. One BFS per source, sources
+    // split over the scheduler; every search stops once it cannot beat the best
+    // cycle any search has found so far.
+    template <class C>
+    static size_t Girth(const C& g, unsigned threads = 0) { return shortest(g, threads).length; }
+
+    template <class C>
+    static Cycle<C> Shortest(const C& g, unsigned threads = 0) {
+        using Index = typename C::Index;
+        Best best = shortest(g, threads);
+        if (!best.length) return {};
+        Search<C> bfs(g);
+        auto [v, u] = bfs.run((Index)best.source, best.length + 1);
+        return join(bfs.parent, v, u);
+    }
+
+    // m - n + components: the dimension of the cycle space.
+    template <class C>
+    static size_t Rank(const C& g) {
+        return g.edgeCount() - g.vertexCount() + SpanningTrees::BFS(g).trees;
+    }
+
+    // One cycle per non-tree edge of a BFS spanning forest.
+    template <class C>
+    static std::vector<Cycle<C>> FundamentalBasis(const C& g) {
+        using Index = typename C::Index;
+        auto forest = SpanningTrees::BFS(g);
+        std::vector<Index> depth = depths(forest.parent);
+        std::vector<Cycle<C>> basis;
+        for (Index v = 0; v < (Index)g.vertexCount(); ++v)
+            for (Index u : g.neighbors(v))
+                if (v < u && !forest.contains(v, u)) basis.push_back(treeCycle(forest.parent, depth, v, u));
+        return basis;
+    }
+
+    // Minimum cycle basis (Horton 1987): the candidates are P(x, u) + (u, v) + P(v, x)
+    // over BFS trees from every x, taken shortest first and kept when independent of
+    // the cycles kept so far. Independence is Gaussian elimination over GF(2) on
+    // edge bitsets. Memory is dominated by the candidate list, up to one entry per
+    // edge per root, so O(V E); on top come one BFS parent array per vertex (O(V^2))
+    // and the elimination rows (O((E - V) E / 64) words). Meant for sparse graphs of
+    // up to a few thousand vertices.
+    template <class C>
+    static std::vector<Cycle<C>> MinimumBasis(const C& g) {
+        using Index = typename C::Index;
+        using Offset = typename C::Offset;
+        size_t n = g.vertexCount(), dim = Rank(g);
+        std::vector<Cycle<C>> basis;
+        if (dim == 0) return basis;
+
+        struct Candidate { size_t length; Index root; Index v; Offset slot; };
+        std::vector<Candidate> candidates;
+        std::vector<std::vector<Index>> parents(n);
+        std::vector<Index> branch(n);
+        Search<C> bfs(g);
+        for (Index x = 0; x < (Index)n; ++x) {
+            bfs.run(x, SIZE_MAX, false);
+            parents[x] = bfs.parent;
+            const auto& p = parents[x];
+            for (Index w : bfs.order) branch[w] = w == x || p[w] == x ? w : branch[p[w]];
+            for (Index v : bfs.order)
+                for (Offset slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) {
+                    Index u = g.targets[slot];
+                    if (v < u && p[u] != v && p[v] != u && branch[u] != branch[v])
+                        candidates.push_back({(size_t)bfs.dist[v] + bfs.dist[u] + 1, x, v, slot});
+                }
+        }
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const Candidate& a, const Candidate& b) { return a.length < b.length; });
+
+        std::vector<Offset> edgeId = edgeIds(g);
+        size_t words = (g.edgeCount() + 63) / 64;
+        std::vector<std::vector<uint64_t>> rows;
+        std::vector<size_t> pivotRow(g.edgeCount(), SIZE_MAX);
+        std::vector<uint64_t> bits(words);
+        for (const Candidate& cand : candidates) {
+            Cycle<C> cycle = join(parents[cand.root], cand.v, g.targets[cand.slot]);
+            std::fill(bits.begin(), bits.end(), 0);
+            for (size_t i = 0; i < cycle.size(); ++i) {
+                size_t e = edgeId[slotOf(g, cycle[i], cycle[(i + 1) % cycle.size()])];
+                bits[e / 64] |= uint64_t(1) << (e % 64);
+            }
+            // Reduce by the rows whose lowest bit (pivot) is set; a fresh pivot means independent.
+            for (size_t w = 0; w < words; ++w) {
+                while (bits[w]) {
+                    size_t e = w * 64 + __builtin_ctzll(bits[w]);
+                    if (pivotRow[e] == SIZE_MAX) {
+                        pivotRow[e] = rows.size();
+                        rows.push_back(bits);
+                        basis.push_back(std::move(cycle));
+                        if (basis.size() == dim) return basis;
+                        goto next;
+                    }
+                    const auto& row = rows[pivotRow[e]];
+                    for (size_t k = w; k < words; ++k) bits[k] ^= row[k];
+                }
+            }
+        next:;
+        }
+        return basis;
+    }
+
+    // Position of the edge (v, u) in v's adjacency row; the edge must exist.
+    template <class C>
+    static typename C::Offset slotOf(const C& g, typename C::Index v, typename C::Index u) {
+        auto row = g.neighbors(v);
+        return std::lower_bound(row.begin(), row.end(), u) - g.targets.data();
+    }
+
+    // Undirected edge number 0..m-1 of every CSR slot; both directions share it.
+    template <class C>
+    static std::vector<typename C::Offset> edgeIds(const C& g) {
+        using Index = typename C::Index;
+        std::vector<typename C::Offset> id(g.targets.size());
+        typename C::Offset next = 0;
+        for (Index v = 0; v < (Index)g.vertexCount(); ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+                if (v < g.targets[slot]) id[slot] = next++;
+        for (Index v = 0; v < (Index)g.vertexCount(); ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+                if (v > g.targets[slot]) id[slot] = id[slotOf(g, g.targets[slot], v)];
+        return id;
+    }
+
+private:
+    struct Best {
+        size_t length = 0; // 0: no cycle
+        size_t source = 0;
+    };
+
+    // BFS that also reports the shortest cycle through its source, giving up on
+    // cycles of `bound` edges or more. With prune off the whole component is searched.
+    template <class C>
+    struct Search {
+        using Index = typename C::Index;
+        static constexpr Index kNone = C::kNone;
+
+        explicit Search(const C& g) : g(g), dist(g.vertexCount(), kNone), parent(g.vertexCount(), kNone) {}
+
+        // Returns the closing edge (v, u) of the best cycle, (kNone, kNone) if none.
+        std::pair<Index, Index> run(Index s, size_t bound, bool prune = true) {
+            for (Index v : order) { dist[v] = kNone; parent[v] = kNone; }
+            order.assign(1, s);
+            dist[s] = 0;
+            length = bound;
+            std::pair<Index, Index> closing{kNone, kNone};
+            for (size_t head = 0; head < order.size(); ++head) {
+                Index v = order[head];
+                if (prune && 2 * (size_t)dist[v] + 1 >= length) break;
+                for (Index u : g.neighbors(v)) {
+                    if (u == v) continue;
+                    if (dist[u] == kNone) { dist[u] = dist[v] + 1; parent[u] = v; order.push_back(u); }
+                    else if (u != parent[v] && (size_t)dist[v] + dist[u] + 1 < length) {
+                        length = (size_t)dist[v] + dist[u] + 1;
+                        closing = {v, u};
+                    }
+                }
+            }
+            return closing;
+        }
+
+        const C& g;
+        std::vector<Index> dist, parent, order;
+        size_t length = 0;
+    };
+
+    template <class C>
+    static Best shortest(const C& g, unsigned threads) {
+        using Index = typename C::Index;
+        size_t n = g.vertexCount();
+        std::atomic<size_t> bound{SIZE_MAX};
+        size_t chunks = threads ? threads : 4 * (size_t)Parallel::threadCount();
+        size_t grain = std::max<size_t>(1, (n + chunks - 1) / chunks);
+        Best best = TaskScheduler::instance().parallelReduce(0, n, Best{},
+            [&](size_t lo, size_t hi) {
+                Search<C> bfs(g);
+                Best local;
+                for (size_t s = lo; s < hi; ++s) {
+                    if (bfs.run((Index)s, bound.load(std::memory_order_relaxed)).first == C::kNone) continue;
+                    local = {bfs.length, s};
+                    size_t cur = bound.load(std::memory_order_relaxed);
+                    while (bfs.length < cur && !bound.compare_exchange_weak(cur, bfs.length, std::memory_order_relaxed)) {}
+                }
+                return local;
+            },
+            [](Best a, Best b) { return !a.length || (b.length && b.length < a.length) ? b : a; }, grain);
+        return best;
+    }
+
+    template <class C>
+    static Cycle<C> find(const C& g, std::mt19937_64* rng) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<Index> pos(n, C::kNone), path;
+        std::vector<char> done(n, 0);
+        struct Frame { Index v; size_t next, rotation; };
+        std::vector<Frame> stack;
+        auto enter = [&](Index v) {
+            pos[v] = path.size();
+            path.push_back(v);
+            stack.push_back({v, 0, rng && g.degree(v) ? (*rng)() % g.degree(v) : 0});
+        };
+        Index first = rng && n ? (*rng)() % n : 0;
+        for (Index i = 0; i < n; ++i) {
+            Index r = i < n - first ? first + i : i - (n - first);
+            if (done[r]) continue;
+            enter(r);
+            while (!stack.empty()) {
+                Frame& f = stack.back();
+                size_t d = g.degree(f.v);
+                if (f.next == d) {
+                    pos[f.v] = C::kNone;
+                    done[f.v] = 1;
+                    path.pop_back();
+                    stack.pop_back();
+                    continue;
+                }
+                Index v = f.v, u = g.targets[g.offsets[v] + (f.next++ + f.rotation) % d];
+                if (u == v || done[u] || (pos[u] != C::kNone && pos[u] + 1 == pos[v])) continue;
+                if (pos[u] != C::kNone) return Cycle<C>(path.begin() + pos[u], path.end());
+                enter(u);
+            }
+        }
+        return {};
+    }
+
+    // Cycle closed by (v, u) in a tree given by parents: v up to the common ancestor, then down to u.
+    template <class Index>
+    static std::vector<Index> join(const std::vector<Index>& parent, Index v, Index u) {
+        std::vector<Index> up, down;
+        for (Index a = v; a != BasicSpanningForest<Index>::kNone; a = parent[a]) up.push_back(a);
+        for (Index b = u; b != BasicSpanningForest<Index>::kNone; b = parent[b]) down.push_back(b);
+        // Both climbs end at the root; drop the shared tail but keep the meeting vertex once.
+        while (up.size() > 1 && down.size() > 1 && up[up.size() - 2] == down[down.size() - 2]) {
+            up.pop_back();
+            down.pop_back();
+        }
+        down.pop_back();
+        up.insert(up.end(), down.rbegin(), down.rend());
+        return up;
+    }
+
+    template <class Index>
+    static std::vector<Index> depths(const std::vector<Index>& parent) {
+        constexpr Index kNone = BasicSpanningForest<Index>::kNone;
+        std::vector<Index> depth(parent.size(), kNone), chain;
+        for (Index v = 0; v < (Index)parent.size(); ++v) {
+            Index a = v;
+            while (depth[a] == kNone && parent[a] != kNone) { chain.push_back(a); a = parent[a]; }
+            if (depth[a] == kNone) depth[a] = 0;
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it) depth[*it] = depth[parent[*it]] + 1;
+            chain.clear();
+        }
+        return depth;
+    }
+
+    template <class Index>
+    static std::vector<Index> treeCycle(const std::vector<Index>& parent, const std::vector<Index>& depth, Index v, Index u) {
+        std::vector<Index> left{v}, right{u};
+        while (depth[v] > depth[u]) left.push_back(v = parent[v]);
+        while (depth[u] > depth[v]) right.push_back(u = parent[u]);
+        while (v != u) { left.push_back(v = parent[v]); right.push_back(u = parent[u]); }
+        right.pop_back();
+        left.insert(left.end(), right.rbegin(), right.rend());
+        return left;
+    }
+};
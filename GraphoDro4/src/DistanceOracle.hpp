@@ -0,0 +1,201 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Traversal.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <cstring>
+#include <stdexcept>
+
+// Exact unweighted s-t distances by pruned landmark labeling (Akiba, Iwata,
+// Yoshida 2013). Landmarks are taken by decreasing degree; every vertex keeps a
+// label of (landmark rank, distance) pairs sorted by rank and a query is one
+// merge of two labels. The build runs pruned BFS from a batch of landmarks at a
+// time on the scheduler, pruning only with labels committed by earlier batches:
+// labels can grow slightly over the sequential build, answers stay exact.
+template <class V = Graph::Vertex>
+class BasicDistanceOracle {
+public:
+    using Vertex = V;
+    using Index = std::make_unsigned_t<V>;
+    static constexpr size_t kUnreachable = SIZE_MAX;
+
+    template <class C>
+    static BasicDistanceOracle Build(const C& g, unsigned threads = 0) {
+        static_assert(std::is_same<typename C::Index, Index>::value, "DistanceOracle: index width mismatch");
+        Index n = g.vertexCount();
+        BasicDistanceOracle o;
+        o.ids = g.ids;
+        o.rebuildLookup();
+
+        std::vector<Index> byRank(n), rank(n);
+        std::iota(byRank.begin(), byRank.end(), Index(0));
+        std::stable_sort(byRank.begin(), byRank.end(), [&g](Index a, Index b) { return g.degree(a) > g.degree(b); });
+        for (Index r = 0; r < n; ++r) rank[byRank[r]] = r;
+
+        using Label = std::vector<std::pair<Index, Index>>; // (hub rank, distance)
+        std::vector<Label> labels(n);
+        size_t batch = Parallel::threadCount(threads);
+        struct Workspace {
+            explicit Workspace(const C& g, Index n) : bfs(g), rootDist(n, kNone) {}
+            BreadthFirstSearch<C> bfs;
+            std::vector<Index> rootDist;           // distance from the root to each hub, by hub rank
+            std::vector<std::pair<Index, Index>> found; // (vertex, distance) labels to commit
+        };
+        std::vector<Workspace> work;
+        work.reserve(batch);
+        for (size_t i = 0; i < std::min<size_t>(batch, n); ++i) work.emplace_back(g, n);
+
+        for (Index first = 0; first < n; first += (Index)batch) {
+            size_t count = std::min<size_t>(batch, n - first);
+            Parallel::forRange(0, count, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    Workspace& w = work[i];
+                    Index root = byRank[first + i];
+                    w.found.clear();
+                    for (auto [h, d] : labels[root]) w.rootDist[h] = d;
+                    w.bfs.run(root, [&](Index v, Index d) {
+                        for (auto [h, dh] : labels[v])
+                            if (w.rootDist[h] != kNone && w.rootDist[h] + dh <= d) return false;
+                        w.found.push_back({v, d});
+                        return true;
+                    });
+                    for (auto [h, d] : labels[root]) w.rootDist[h] = kNone;
+                }
+            }, threads);
+            for (size_t i = 0; i < count; ++i)
+                for (auto [v, d] : work[i].found) labels[v].push_back({(Index)(first + i), d});
+        }
+
+        o.offsets.assign(n + 1, 0);
+        for (Index v = 0; v < n; ++v) o.offsets[v + 1] = o.offsets[v] + labels[v].size();
+        o.hubs.resize(o.offsets.back());
+        o.dists.resize(o.offsets.back());
+        for (Index v = 0; v < n; ++v) {
+            uint64_t pos = o.offsets[v];
+            for (auto [h, d] : labels[v]) { o.hubs[pos] = h; o.dists[pos++] = d; }
+        }
+        return o;
+    }
+
+    template <class G>
+    static BasicDistanceOracle FromGraph(const G& g, unsigned threads = 0) {
+        return Build(BasicCompactGraph<V>::fromGraph(g), threads);
+    }
+
+    // Distance between two vertex ids, kUnreachable if they are disconnected.
+    size_t distance(Vertex s, Vertex t) const { return distanceIndex(index(s), index(t)); }
+
+    size_t distanceIndex(Index s, Index t) const {
+        uint64_t i = offsets[s], iEnd = offsets[s + 1], j = offsets[t], jEnd = offsets[t + 1];
+        size_t best = kUnreachable;
+        while (i < iEnd && j < jEnd) {
+            if (hubs[i] < hubs[j]) ++i;
+            else if (hubs[i] > hubs[j]) ++j;
+            else { best = std::min<size_t>(best, (size_t)dists[i] + dists[j]); ++i; ++j; }
+        }
+        return best;
+    }
+
+    // Batch mode: answers all queries in parallel, in input order.
+    std::vector<size_t> distances(const std::vector<std::pair<Vertex, Vertex>>& queries, unsigned threads = 0) const {
+        std::vector<size_t> res(queries.size());
+        Parallel::forRange(0, queries.size(), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) res[i] = distance(queries[i].first, queries[i].second);
+        }, threads);
+        return res;
+    }
+
+    size_t vertexCount() const { return ids.size(); }
+    size_t labelCount() const { return hubs.size(); }
+    bool hasVertex(Vertex v) const { return lookup.find(v) != nullptr; }
+
+    // Binary layout: magic, id/index widths, n, label count, ids, offsets, hubs, distances.
+    void save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) throw std::runtime_error("cannot write " + path);
+        uint32_t widths[2] = {sizeof(Vertex), sizeof(Index)};
+        uint64_t sizes[2] = {ids.size(), hubs.size()};
+        out.write(kMagic, sizeof(kMagic));
+        out.write((const char*)widths, sizeof(widths));
+        out.write((const char*)sizes, sizeof(sizes));
+        writeArray(out, ids);
+        writeArray(out, offsets);
+        writeArray(out, hubs);
+        writeArray(out, dists);
+        if (!out) throw std::runtime_error("failed writing " + path);
+    }
+
+    static BasicDistanceOracle Load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        char magic[sizeof(kMagic)];
+        uint32_t widths[2];
+        uint64_t sizes[2];
+        in.read(magic, sizeof(magic));
+        in.read((char*)widths, sizeof(widths));
+        in.read((char*)sizes, sizeof(sizes));
+        if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+            throw std::runtime_error(path + " is not a distance index");
+        if (widths[0] != sizeof(Vertex) || widths[1] != sizeof(Index))
+            throw std::runtime_error(path + ": vertex id width mismatch");
+        // Check the counts against the bytes left before allocating for them.
+        auto start = in.tellg();
+        in.seekg(0, std::ios::end);
+        uint64_t left = (uint64_t)(in.tellg() - start);
+        in.seekg(start);
+        uint64_t perVertex = sizeof(Vertex) + sizeof(uint64_t), perLabel = 2 * sizeof(Index);
+        if (sizes[0] > left / perVertex || sizes[1] > left / perLabel ||
+            sizes[0] * perVertex + sizeof(uint64_t) + sizes[1] * perLabel > left)
+            throw std::runtime_error(path + ": truncated distance index");
+        BasicDistanceOracle o;
+        readArray(in, o.ids, sizes[0]);
+        readArray(in, o.offsets, sizes[0] + 1);
+        readArray(in, o.hubs, sizes[1]);
+        readArray(in, o.dists, sizes[1]);
+        if (!in) throw std::runtime_error(path + ": truncated distance index");
+        // Labels must tile the hub array, or distanceIndex would read past it.
+        if (o.offsets.front() != 0 || o.offsets.back() != o.hubs.size() ||
+            !std::is_sorted(o.offsets.begin(), o.offsets.end()))
+            throw std::runtime_error(path + ": corrupt label offsets");
+        o.rebuildLookup();
+        return o;
+    }
+
+private:
+    static constexpr Index kNone = std::numeric_limits<Index>::max();
+    static constexpr char kMagic[8] = {'G', 'D', '4', 'P', 'L', 'L', '0', '1'};
+
+    Index index(Vertex v) const {
+        const Index* i = lookup.find(v);
+        if (!i) throw std::out_of_range("DistanceOracle: unknown vertex");
+        return *i;
+    }
+
+    void rebuildLookup() {
+        lookup = FlatHashMap<Vertex, Index>();
+        lookup.reserve(ids.size());
+        for (Index i = 0; i < (Index)ids.size(); ++i) *lookup.emplace(ids[i]).first = i;
+    }
+
+    template <class T>
+    static void writeArray(std::ofstream& out, const std::vector<T>& a) {
+        out.write((const char*)a.data(), a.size() * sizeof(T));
+    }
+
+    template <class T>
+    static void readArray(std::ifstream& in, std::vector<T>& a, uint64_t count) {
+        a.resize(count);
+        in.read((char*)a.data(), count * sizeof(T));
+    }
+
+    std::vector<Vertex> ids;
+    std::vector<uint64_t> offsets;
+    std::vector<Index> hubs;  // landmark rank, increasing within each label
+    std::vector<Index> dists;
+    FlatHashMap<Vertex, Index> lookup;
+};
+
+using DistanceOracle = BasicDistanceOracle<>;
@@ -0,0 +1,128 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include <random>
+#include <cstdint>
+
+struct EdgeCutResult {
+    size_t bridges = 0;
+    size_t twoEdgeCuts = 0;             // minimal cuts made of two non-bridge edges
+    std::vector<size_t> threeEdgeClass; // per compact index, id of its 3-edge-connected class
+    size_t threeEdgeClassCount = 0;
+};
+
+// Cut-space hashing: every back edge gets a random 64-bit weight and every tree
+// edge the XOR of the back edges covering it. A tree edge labelled 0 is a bridge,
+// two non-bridge edges form a cut iff their labels are equal.
+class EdgeCutAnalyzer {
+public:
+    template <class C>
+    static EdgeCutResult Analyze(const C& g, uint64_t seed = std::random_device{}()) {
+        using Index = typename C::Index;
+        constexpr Index kNone = C::kNone;
+        Index n = g.vertexCount();
+        std::mt19937_64 rng(seed);
+        EdgeCutResult res;
+
+        // Iterative DFS; for every vertex remember the label of its parent edge.
+        std::vector<Index> parent(n, kNone), order, root(n, kNone), depth(n, kNone);
+        std::vector<uint64_t> down(n, 0);          // XOR of back edges leaving the subtree
+        std::vector<uint64_t> backLabels;
+        std::vector<std::pair<Index, typename C::Offset>> stack;
+        order.reserve(n);
+        for (Index r = 0; r < n; ++r) {
+            if (depth[r] != kNone) continue;
+            depth[r] = 0; root[r] = r;
+            order.push_back(r);
+            stack.push_back({r, g.offsets[r]});
+            while (!stack.empty()) {
+                auto& [v, slot] = stack.back();
+                if (slot == g.offsets[v + 1]) { stack.pop_back(); continue; }
+                Index u = g.targets[slot++];
+                if (depth[u] == kNone) {
+                    depth[u] = depth[v] + 1; parent[u] = v; root[u] = r;
+                    order.push_back(u);
+                    stack.push_back({u, g.offsets[u]});
+                } else if (depth[u] < depth[v] && u != parent[v]) {
+                    uint64_t w = rng();
+                    if (w == 0) w = 1;
+                    down[v] ^= w;
+                    down[u] ^= w;
+                    backLabels.push_back(w);
+                }
+            }
+        }
+        // Children finish before parents in reverse preorder.
+        for (size_t i = order.size(); i-- > 0;) {
+            Index v = order[i];
+            if (parent[v] != kNone) down[parent[v]] ^= down[v];
+        }
+
+        // Collect labels of all non-bridge edges; tree edges carry their child vertex.
+        std::vector<std::pair<uint64_t, Index>> labels; // (label, child or kNone for back edge)
+        labels.reserve(n + backLabels.size());
+        for (Index v = 0; v < n; ++v) {
+            if (parent[v] == kNone) continue;
+            if (down[v] == 0) res.bridges++;
+            else labels.push_back({down[v], v});
+        }
+        for (uint64_t w : backLabels) labels.push_back({w, kNone});
+        radixSort(labels);
+
+        // Vertex signature: XOR of random tokens of every separating tree edge above it.
+        std::vector<uint64_t> token(n, 0);
+        for (Index v = 0; v < n; ++v)
+            if (parent[v] != kNone && down[v] == 0) token[v] = rng() | 1;
+        for (size_t i = 0; i < labels.size();) {
+            size_t j = i;
+            while (j < labels.size() && labels[j].first == labels[i].first) ++j;
+            size_t size = j - i;
+            res.twoEdgeCuts += size * (size - 1) / 2;
+            if (size > 1) {
+                // Tree edges of one class lie on a single root path. Without a back
+                // edge in the class the segment below the deepest edge rejoins the
+                // top one, so the tokens must cancel out along the whole path.
+                std::vector<Index> tree;
+                bool hasBack = false;
+                for (size_t k = i; k < j; ++k) {
+                    if (labels[k].second == kNone) hasBack = true;
+                    else tree.push_back(labels[k].second);
+                }
+                uint64_t acc = 0;
+                for (size_t k = 0; k < tree.size(); ++k) {
+                    uint64_t t = (k + 1 == tree.size() && !hasBack) ? acc : (rng() | 1);
+                    token[tree[k]] ^= t;
+                    acc ^= t;
+                }
+            }
+            i = j;
+        }
+        for (Index v : order) if (parent[v] != kNone) token[v] ^= token[parent[v]];
+
+        std::vector<std::pair<uint64_t, Index>> keys(n);
+        for (Index v = 0; v < n; ++v) keys[v] = {token[v] ^ (uint64_t)root[v] * 0x9E3779B97F4A7C15ull, v};
+        radixSort(keys);
+        res.threeEdgeClass.assign(n, 0);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (i > 0 && keys[i].first != keys[i - 1].first) res.threeEdgeClassCount++;
+            res.threeEdgeClass[keys[i].second] = res.threeEdgeClassCount;
+        }
+        if (n > 0) res.threeEdgeClassCount++;
+        return res;
+    }
+
+private:
+    // LSD radix sort on the 64-bit key, 16 bits per pass.
+    template <class T>
+    static void radixSort(std::vector<std::pair<uint64_t, T>>& a) {
+        std::vector<std::pair<uint64_t, T>> tmp(a.size());
+        std::vector<size_t> count(1 << 16);
+        for (int shift = 0; shift < 64; shift += 16) {
+            std::fill(count.begin(), count.end(), 0);
+            for (auto& x : a) count[(x.first >> shift) & 0xFFFF]++;
+            size_t sum = 0;
+            for (auto& c : count) { size_t t = c; c = sum; sum += t; }
+            for (auto& x : a) tmp[count[(x.first >> shift) & 0xFFFF]++] = x;
+            a.swap(tmp);
+        }
+    }
+};
@@ -1,112 +1,146 @@
-#pragma once
-#include "Graph.hpp"
-#include <random>
-#include <numeric>
-
-class GraphGenerator {
-public:
-    static Graph Complete(int n) {
-        Graph g;
-        for (int i = 0; i < n; ++i)
-            for (int j = i + 1; j < n; ++j) g.addEdge(i, j);
-        return g;
-    }
-
-    static Graph CompleteBipartite(int n, int m) {
-        Graph g;
-        for (int i = 0; i < n; ++i)
-            for (int j = 0; j < m; ++j) g.addEdge(i, n + j);
-        return g;
-    }
-
-    static Graph Star(int n) {
-        Graph g;
-        for (int i = 1; i < n; ++i) g.addEdge(0, i);
-        return g;
-    }
-
-    static Graph Cycle(int n) {
-        Graph g;
-        for (int i = 0; i < n; ++i) g.addEdge(i, (i + 1) % n);
-        return g;
-    }
-
-    static Graph Path(int n) {
-        Graph g;
-        for (int i = 0; i < n - 1; ++i) g.addEdge(i, i + 1);
-        return g;
-    }
-
-    static Graph Wheel(int n) {
-        Graph g = Cycle(n - 1);
-        for (int i = 0; i < n - 1; ++i) g.addEdge(n - 1, i);
-        return g;
-    }
-
-    static Graph Random(int n, double p) {
-        Graph g;
-        std::mt19937 gen(std::random_device{}());
-        std::uniform_real_distribution<> dis(0.0, 1.0);
-        for (int i = 0; i < n; ++i)
-            for (int j = i + 1; j < n; ++j)
-                if (dis(gen) < p) g.addEdge(i, j);
-        return g;
-    }
-
-    static Graph WithConnectedComponents(int n, int k) {
-        Graph g;
-        if (k > n || k < 1) return g;
-        int compSize = n / k, v = 0;
-        for (int i = 0; i < k; ++i) {
-            int currentSize = (i == k - 1) ? (n - v) : compSize;
-            for (int j = 0; j < currentSize - 1; ++j) g.addEdge(v + j, v + j + 1);
-            v += currentSize;
-        }
-        return g;
-    }
-
-    static Graph WithBridges(int n, int b) {
-        Graph g;
-        for (int i = 0; i < b; ++i) g.addEdge(i, i + 1);
-        if (n > b + 1) {
-            for (int i = b; i < n - 1; ++i) g.addEdge(i, i + 1);
-            if (n - b > 2) g.addEdge(n - 1, b); 
-        }
-        return g;
-    }
-
-    static Graph Cubic(int n) {
-        Graph g;
-        if (n % 2 != 0 || n < 4) return g; 
-        for (int i = 0; i < n; ++i) {
-            g.addEdge(i, (i + 1) % n); 
-            g.addEdge(i, (i + n / 2) % n); 
-        }
-        return g;
-    }
-
-    static Graph WithArticulationPoints(int n, int k) {
-        Graph g;
-        if (n < k + 2) return g;
-        for (int i = 0; i < k; ++i) g.addEdge(i, i + 1);
-        if (n > k + 1) {
-            for (int i = k + 1; i < n - 1; ++i) g.addEdge(i, i + 1);
-            g.addEdge(n - 1, k + 1);
-            g.addEdge(k, k + 1);
-            if(n - k > 2) g.addEdge(k, n - 1);
-        }
-        return g;
-    }
-
-    static Graph With2Bridges(int n) {
-        Graph g;
-        if (n < 6) return Cycle(n); 
-        int half = n / 2;
-        for(int i=0; i<half-1; ++i) g.addEdge(i, i+1);
-        g.addEdge(half-1, 0); 
-        for(int i=half; i<n-1; ++i) g.addEdge(i, i+1);
-        g.addEdge(n-1, half); 
-        g.addEdge(0, half); 
-        return g;
-    }
-};
\ No newline at end of file
+#pragma once
+#include "Graph.hpp"
+#include "ConcurrentGraph.hpp"
+#include <random>
+#include <numeric>
+
+// Every generator builds a Graph by default; pass another graph type, e.g.
+// GraphGenerator::Cycle<Graph64>(n), to pick a different vertex id width.
+class GraphGenerator {
+public:
+    template <class G = Graph>
+    static G Complete(typename G::Vertex n) {
+        G g;
+        for (typename G::Vertex i = 0; i < n; ++i)
+            for (auto j = i + 1; j < n; ++j) g.addEdge(i, j);
+        return g;
+    }
+
+    template <class G = Graph>
+    static G CompleteBipartite(typename G::Vertex n, typename G::Vertex m) {
+        G g;
+        for (typename G::Vertex i = 0; i < n; ++i)
+            for (typename G::Vertex j = 0; j < m; ++j) g.addEdge(i, n + j);
+        return g;
+    }
+
+    template <class G = Graph>
+    static G Star(typename G::Vertex n) {
+        G g;
+        for (typename G::Vertex i = 1; i < n; ++i) g.addEdge(0, i);
+        return g;
+    }
+
+    template <class G = Graph>
+    static G Cycle(typename G::Vertex n) {
+        G g;
+        for (typename G::Vertex i = 0; i < n; ++i) g.addEdge(i, (i + 1) % n);
+        return g;
+    }
+
+    template <class G = Graph>
+    static G Path(typename G::Vertex n) {
+        G g;
+        for (typename G::Vertex i = 0; i + 1 < n; ++i) g.addEdge(i, i + 1);
+        return g;
+    }
+
+    template <class G = Graph>
+    static G Wheel(typename G::Vertex n) {
+        if (n < 1) return G();
+        G g = Cycle<G>(n - 1);
+        for (typename G::Vertex i = 0; i + 1 < n; ++i) g.addEdge(n - 1, i);
+        return g;
+    }
+
+    template <class G = Graph>
+    static G Random(typename G::Vertex n, double p) {
+        G g;
+        std::mt19937 gen(std::random_device{}());
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+        for (typename G::Vertex i = 0; i < n; ++i)
+            for (auto j = i + 1; j < n; ++j)
+                if (dis(gen) < p) g.addEdge(i, j);
+        return g;
+    }
+
+    // G(n, p) produced by parallel tasks, one block of rows each, all inserting into
+    // the shared concurrent graph.
+    template <class V>
+    static void RandomInto(BasicConcurrentGraph<V>& g, V n, double p, uint64_t seed = std::random_device{}()) {
+        for (V i = 0; i < n; ++i) g.addVertex(i);
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            std::mt19937_64 gen(seed ^ (0x9E3779B97F4A7C15ull * (lo + 1)));
+            std::uniform_real_distribution<> dis(0.0, 1.0);
+            for (V i = lo; i < (V)hi; ++i)
+                for (V j = i + 1; j < n; ++j)
+                    if (dis(gen) < p) g.addEdge(i, j);
+        });
+    }
+
+    template <class G = Graph>
+    static G WithConnectedComponents(typename G::Vertex n, typename G::Vertex k) {
+        using V = typename G::Vertex;
+        G g;
+        if (k > n || k < 1) return g;
+        V compSize = n / k, v = 0;
+        for (V i = 0; i < k; ++i) {
+            V currentSize = (i == k - 1) ? (n - v) : compSize;
+            for (V j = 0; j + 1 < currentSize; ++j) g.addEdge(v + j, v + j + 1);
+            v += currentSize;
+        }
+        return g;
+    }
+
+    template <class G = Graph>
+    static G WithBridges(typename G::Vertex n, typename G::Vertex b) {
+        using V = typename G::Vertex;
+        G g;
+        for (V i = 0; i < b; ++i) g.addEdge(i, i + 1);
+        if (n > b + 1) {
+            for (V i = b; i < n - 1; ++i) g.addEdge(i, i + 1);
+            if (n - b > 2) g.addEdge(n - 1, b); 
+        }
+        return g;
+    }
+
+    template <class G = Graph>
+    static G Cubic(typename G::Vertex n) {
+        G g;
+        if (n % 2 != 0 || n < 4) return g; 
+        for (typename G::Vertex i = 0; i < n; ++i) {
+            g.addEdge(i, (i + 1) % n); 
+            g.addEdge(i, (i + n / 2) % n); 
+        }
+        return g;
+    }
+
+    template <class G = Graph>
+    static G WithArticulationPoints(typename G::Vertex n, typename G::Vertex k) {
+        using V = typename G::Vertex;
+        G g;
+        if (n < k + 2) return g;
+        for (V i = 0; i < k; ++i) g.addEdge(i, i + 1);
+        if (n > k + 1) {
+            for (V i = k + 1; i < n - 1; ++i) g.addEdge(i, i + 1);
+            g.addEdge(n - 1, k + 1);
+            g.addEdge(k, k + 1);
+            if(n - k > 2) g.addEdge(k, n - 1);
+        }
+        return g;
+    }
+
+    template <class G = Graph>
+    static G With2Bridges(typename G::Vertex n) {
+        using V = typename G::Vertex;
+        G g;
+        if (n < 6) return Cycle<G>(n); 
+        V half = n / 2;
+        for(V i=0; i<half-1; ++i) g.addEdge(i, i+1);
+        g.addEdge(half-1, 0); 
+        for(V i=half; i<n-1; ++i) g.addEdge(i, i+1);
+        g.addEdge(n-1, half); 
+        g.addEdge(0, half); 
+        return g;
+    }
+};
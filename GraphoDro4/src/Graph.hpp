@@ -1,73 +1,245 @@
-#pragma once
-#include <map>
-#include <set>
-#include <vector>
-#include <stdexcept>
-#include <algorithm>
-
-class GraphVisitor {
-public:
-    virtual void discoverVertex(int v) {}
-    virtual void examineEdge(int u, int v) {}
-    virtual void finishVertex(int v) {}
-    virtual ~GraphVisitor() = default;
-};
-
-class Graph {
-public:
-    using Vertex = int;
-
-    void addVertex(Vertex v) {
-        if (adj.find(v) == adj.end()) adj[v] = std::set<Vertex>();
-    }
-
-    void addEdge(Vertex u, Vertex v) {
-        addVertex(u); addVertex(v);
-        adj[u].insert(v);
-        adj[v].insert(u);
-    }
-
-    bool hasVertex(Vertex v) const { return adj.count(v); }
-    bool hasEdge(Vertex u, Vertex v) const {
-        if (!hasVertex(u)) return false;
-        return adj.at(u).count(v);
-    }
-
-    const std::set<Vertex>& neighbors(Vertex v) const { return adj.at(v); }
-    
-    std::vector<Vertex> getVertices() const {
-        std::vector<Vertex> res;
-        for (const auto& [v, _] : adj) res.push_back(v);
-        return res;
-    }
-
-    size_t vertexCount() const { return adj.size(); }
-    size_t edgeCount() const {
-        size_t count = 0;
-        for (const auto& [v, nbs] : adj) count += nbs.size();
-        return count / 2;
-    }
-
-    bool isLeaf(Vertex v) const { return hasVertex(v) && adj.at(v).size() == 1; }
-
-    void merge(const Graph& other) {
-        for (auto v : other.getVertices()) {
-            for (auto u : other.neighbors(v)) addEdge(v, u);
-        }
-    }
-
-    void dfs(Vertex start, GraphVisitor& visitor, std::set<Vertex>& visited) const {
-        visited.insert(start);
-        visitor.discoverVertex(start);
-        for (auto neighbor : neighbors(start)) {
-            visitor.examineEdge(start, neighbor);
-            if (visited.find(neighbor) == visited.end()) {
-                dfs(neighbor, visitor, visited);
-            }
-        }
-        visitor.finishVertex(start);
-    }
-
-private:
-    std::map<Vertex, std::set<Vertex>> adj;
-};
\ No newline at end of file
+#pragma once
+#include <map>
+#include <set>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include "Containers.hpp"
+#include "Parallel.hpp"
+
+template <class V>
+class BasicGraphVisitor {
+public:
+    virtual void discoverVertex(V v) {}
+    virtual void examineEdge(V u, V v) {}
+    virtual void finishVertex(V v) {}
+    virtual ~BasicGraphVisitor() = default;
+};
+
+// Neighbours of one vertex in insertion order. Low-degree vertices are scanned
+// linearly; above kIndexThreshold a flat hash index (neighbour -> position)
+// makes lookups O(1).
+template <class Vertex>
+class NeighborSet {
+public:
+    static constexpr size_t kIndexThreshold = 16;
+    static constexpr size_t npos = SIZE_MAX;
+
+    NeighborSet() = default;
+    NeighborSet(const NeighborSet& other)
+        : items(other.items), index(other.index ? std::make_unique<FlatHashMap<Vertex, uint32_t>>(*other.index) : nullptr) {}
+    NeighborSet(NeighborSet&&) noexcept = default;
+    NeighborSet& operator=(const NeighborSet& other) {
+        if (this != &other) { NeighborSet copy(other); *this = std::move(copy); }
+        return *this;
+    }
+    NeighborSet& operator=(NeighborSet&&) noexcept = default;
+
+    bool insert(Vertex v) {
+        if (index) {
+            auto [pos, inserted] = index->emplace(v);
+            if (!inserted) return false;
+            *pos = items.size();
+        } else {
+            if (std::find(items.begin(), items.end(), v) != items.end()) return false;
+            if (items.size() == kIndexThreshold) {
+                index = std::make_unique<FlatHashMap<Vertex, uint32_t>>();
+                for (uint32_t i = 0; i < items.size(); ++i) *index->emplace(items[i]).first = i;
+                *index->emplace(v).first = items.size();
+            }
+        }
+        items.push_back(v);
+        return true;
+    }
+
+    size_t count(Vertex v) const { return position(v) != npos; }
+
+    // Insertion position of v, npos if absent.
+    size_t position(Vertex v) const {
+        if (index) {
+            const uint32_t* pos = index->find(v);
+            return pos ? *pos : npos;
+        }
+        auto it = std::find(items.begin(), items.end(), v);
+        return it == items.end() ? npos : it - items.begin();
+    }
+
+    const Vertex* begin() const { return items.begin(); }
+    const Vertex* end() const { return items.end(); }
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+private:
+    SmallVector<Vertex, 4> items;
+    std::unique_ptr<FlatHashMap<Vertex, uint32_t>> index;
+};
+
+// Graph types that may carry edge weights expose isWeighted() and weight(u, v).
+template <class G, class = void>
+struct HasEdgeWeights : std::false_type {};
+template <class G>
+struct HasEdgeWeights<G, std::void_t<decltype(std::declval<const G&>().isWeighted())>> : std::true_type {};
+
+// Mutable undirected graph over vertex ids of type V. Vertices live in dense
+// slots (insertion order) found through an open-addressing id table; slot numbers
+// use the unsigned type of the same width, so 32-bit ids keep the whole structure
+// 32-bit. The id kNoVertex (emptyKey<V>()) is reserved and doubles as "no vertex".
+// Edge weights are optional: the table is only allocated by the first weighted
+// addEdge, until then every edge weighs 1.
+template <class V>
+class BasicGraph {
+public:
+    using Vertex = V;
+    using Slot = std::make_unsigned_t<V>;
+    using Neighbors = NeighborSet<Vertex>;
+    using Visitor = BasicGraphVisitor<Vertex>;
+    static constexpr Vertex kNoVertex = emptyKey<Vertex>();
+
+    void addVertex(Vertex v) { slotOf(v); }
+
+    void addEdge(Vertex u, Vertex v) {
+        size_t su = slotOf(u), sv = slotOf(v);
+        link(su, v);
+        if (u != v) link(sv, u);
+    }
+
+    // Adds the edge if needed and sets its weight.
+    void addEdge(Vertex u, Vertex v, double w) {
+        if (!weighted) enableWeights();
+        addEdge(u, v);
+        size_t su = *slots.find(u), sv = *slots.find(v);
+        weights[su][adj[su].position(v)] = w;
+        weights[sv][adj[sv].position(u)] = w;
+    }
+
+    // Unweighted graph from neighbour rows: rows[i] lists the neighbours of
+    // vertices[i], and each edge must appear in the rows of both endpoints, as
+    // graph views report them. Slots are assigned in order, then the rows are
+    // stored in parallel since each one only touches its own slot.
+    static BasicGraph fromRows(const std::vector<Vertex>& vertices, const std::vector<std::vector<Vertex>>& rows,
+                               unsigned threads = 0) {
+        return fillRows(vertices, rows, false, threads);
+    }
+
+    // Weighted variant: rows of (neighbour, weight), the same weight in both rows of an edge.
+    static BasicGraph fromRows(const std::vector<Vertex>& vertices,
+                               const std::vector<std::vector<std::pair<Vertex, double>>>& rows, unsigned threads = 0) {
+        return fillRows(vertices, rows, true, threads);
+    }
+
+    bool isWeighted() const { return weighted; }
+
+    double weight(Vertex u, Vertex v) const {
+        const Slot* s = slots.find(u);
+        size_t pos = s ? adj[*s].position(v) : Neighbors::npos;
+        if (pos == Neighbors::npos) throw std::out_of_range("Graph::weight: no such edge");
+        return weighted ? weights[*s][pos] : 1.0;
+    }
+
+    bool hasVertex(Vertex v) const { return slots.find(v) != nullptr; }
+    bool hasEdge(Vertex u, Vertex v) const {
+        const Slot* s = slots.find(u);
+        return s && adj[*s].count(v);
+    }
+
+    const Neighbors& neighbors(Vertex v) const {
+        const Slot* s = slots.find(v);
+        if (!s) throw std::out_of_range("Graph::neighbors: unknown vertex");
+        return adj[*s];
+    }
+
+    std::vector<Vertex> getVertices() const { return ids; }
+
+    size_t vertexCount() const { return ids.size(); }
+    size_t edgeCount() const { return degreeSum / 2; }
+
+    bool isLeaf(Vertex v) const { return hasVertex(v) && neighbors(v).size() == 1; }
+
+    // Copies every edge of `other` (a graph or a view) into this graph; see
+    // GraphViews::Union for a zero-copy alternative.
+    template <class G>
+    void merge(const G& other) {
+        for (auto v : other.getVertices()) {
+            for (auto u : other.neighbors(v)) {
+                if constexpr (HasEdgeWeights<G>::value) {
+                    if (other.isWeighted()) { addEdge(v, u, other.weight(v, u)); continue; }
+                }
+                addEdge(v, u);
+            }
+        }
+    }
+
+    void dfs(Vertex start, Visitor& visitor, std::set<Vertex>& visited) const {
+        visited.insert(start);
+        visitor.discoverVertex(start);
+        for (auto neighbor : neighbors(start)) {
+            visitor.examineEdge(start, neighbor);
+            if (visited.find(neighbor) == visited.end()) {
+                dfs(neighbor, visitor, visited);
+            }
+        }
+        visitor.finishVertex(start);
+    }
+
+private:
+    static std::pair<Vertex, double> rowEntry(Vertex u) { return {u, 1.0}; }
+    static std::pair<Vertex, double> rowEntry(const std::pair<Vertex, double>& e) { return e; }
+
+    template <class Row>
+    static BasicGraph fillRows(const std::vector<Vertex>& vertices, const std::vector<Row>& rows, bool weighted,
+                               unsigned threads) {
+        BasicGraph g;
+        g.weighted = weighted;
+        std::vector<size_t> slot(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) slot[i] = g.slotOf(vertices[i]);
+        Parallel::forRange(0, vertices.size(), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                size_t s = slot[i];
+                for (const auto& entry : rows[i]) {
+                    auto [u, w] = rowEntry(entry);
+                    if (!g.hasVertex(u)) throw std::invalid_argument("Graph::fromRows: neighbour is not a vertex");
+                    if (g.adj[s].insert(u)) { if (weighted) g.weights[s].push_back(w); }
+                    else if (weighted) g.weights[s][g.adj[s].position(u)] = w;
+                }
+            }
+        }, threads);
+        for (const auto& row : g.adj) g.degreeSum += row.size();
+        return g;
+    }
+
+    size_t slotOf(Vertex v) {
+        if (v == kNoVertex) throw std::invalid_argument("Graph: reserved vertex id");
+        auto [slot, inserted] = slots.emplace(v);
+        if (inserted) {
+            *slot = ids.size();
+            ids.push_back(v);
+            adj.emplace_back();
+            if (weighted) weights.emplace_back();
+        }
+        return *slot;
+    }
+
+    void link(size_t s, Vertex v) {
+        if (!adj[s].insert(v)) return;
+        degreeSum++;
+        if (weighted) weights[s].push_back(1.0);
+    }
+
+    void enableWeights() {
+        weighted = true;
+        weights.resize(adj.size());
+        for (size_t s = 0; s < adj.size(); ++s) weights[s].assign(adj[s].size(), 1.0);
+    }
+
+    std::vector<Vertex> ids;
+    std::vector<Neighbors> adj;
+    FlatHashMap<Vertex, Slot> slots;
+    size_t degreeSum = 0;
+    bool weighted = false;
+    std::vector<std::vector<double>> weights; // parallel to adj, filled once weighted
+};
+
+using Graph = BasicGraph<int>;
+using Graph32 = BasicGraph<uint32_t>; // up to 2^32 - 1 vertices at 4 bytes per id
+using Graph64 = BasicGraph<uint64_t>;
+using GraphVisitor = BasicGraphVisitor<Graph::Vertex>;
@@ -1,136 +1,274 @@
-#pragma once
-#include "Graph.hpp"
-#include <iostream>
-#include <sstream>
-#include <string>
-#include <random>
-#include <algorithm>
-
-class EdgeListParser {
-public:
-    static Graph parse(std::istream& in) {
-        Graph g; int u, v;
-        while (in >> u >> v) g.addEdge(u, v);
-        return g;
-    }
-};
-
-class MatrixParser {
-public:
-    static Graph parse(std::istream& in) {
-        Graph g; int n;
-        if (!(in >> n)) return g;
-        for (int i=0; i<n; ++i)
-            for (int j=0; j<n; ++j) {
-                int e; in >> e;
-                if (e && i < j) g.addEdge(i, j);
-            }
-        return g;
-    }
-};
-
-class DimacsParser {
-public:
-    static Graph parse(std::istream& in) {
-        Graph g; std::string line;
-        while (std::getline(in, line)) {
-            if (line.empty() || line[0] == 'c' || line[0] == 'p') continue;
-            std::stringstream ss(line);
-            char type; ss >> type;
-            if (type == 'e') { int u, v; ss >> u >> v; g.addEdge(u, v); }
-        }
-        return g;
-    }
-};
-
-class GraphVizSerializer {
-public:
-    enum HighlightMode { NONE, SPANNING_TREE, RANDOM_CYCLE };
-
-    static std::string serialize(const Graph& g, HighlightMode mode = NONE) {
-        std::stringstream ss;
-        ss << "graph G {\n";
-        std::set<std::pair<int, int>> seen, highlightEdges;
-        std::set<int> visited;
-        
-        auto vertices = g.getVertices();
-        if (!vertices.empty()) {
-            if (mode == SPANNING_TREE) {
-                buildRandomTree(g, vertices[0], visited, highlightEdges);
-            } else if (mode == RANDOM_CYCLE) {
-                std::vector<int> path;
-                findRandomCycle(g, vertices[0], -1, path, visited, highlightEdges);
-            }
-        }
-
-        for (auto u : vertices) {
-            ss << "  " << u << ";\n";
-            for (auto v : g.neighbors(u)) {
-                if (seen.count({v, u}) || seen.count({u, v})) continue;
-                seen.insert({u, v});
-                ss << "  " << u << " -- " << v;
-                if ((highlightEdges.count({u,v}) || highlightEdges.count({v,u}))) {
-                    if (mode == SPANNING_TREE) ss << " [color=\"red\", penwidth=2.0]";
-                    if (mode == RANDOM_CYCLE) ss << " [color=\"blue\", penwidth=2.0]";
-                }
-                ss << ";\n";
-            }
-        }
-        ss << "}\n";
-        return ss.str();
-    }
-private:
-    static void buildRandomTree(const Graph& g, int v, std::set<int>& vis, std::set<std::pair<int,int>>& edges) {
-        vis.insert(v);
-        std::vector<int> nbs(g.neighbors(v).begin(), g.neighbors(v).end());
-        std::shuffle(nbs.begin(), nbs.end(), std::mt19937{std::random_device{}()});
-        for(auto n : nbs) {
-            if(vis.find(n) == vis.end()) {
-                edges.insert({v, n});
-                buildRandomTree(g, n, vis, edges);
-            }
-        }
-    }
-
-    static bool findRandomCycle(const Graph& g, int v, int p, std::vector<int>& path, std::set<int>& vis, std::set<std::pair<int,int>>& cycleEdges) {
-        vis.insert(v);
-        path.push_back(v);
-        std::vector<int> nbs(g.neighbors(v).begin(), g.neighbors(v).end());
-        std::shuffle(nbs.begin(), nbs.end(), std::mt19937{std::random_device{}()});
-        
-        for(int n : nbs) {
-            if(n == p) continue;
-            if(vis.count(n)) {
-                auto it = std::find(path.begin(), path.end(), n);
-                if (it != path.end()) {
-                    for(auto i = it; i != path.end(); ++i) {
-                        int next = (i + 1 == path.end()) ? n : *(i + 1);
-                        cycleEdges.insert({*i, next});
-                    }
-                    return true;
-                }
-            } else {
-                if(findRandomCycle(g, n, v, path, vis, cycleEdges)) return true;
-            }
-        }
-        path.pop_back();
-        return false;
-    }
-};
-
-class Program4YouSerializer {
-public:
-    static std::string serialize(const Graph& g) {
-        std::stringstream ss;
-        ss << g.vertexCount() << " " << g.edgeCount() << "\n";
-        std::set<std::pair<int, int>> seen;
-        for (auto u : g.getVertices()) {
-            for (auto v : g.neighbors(u)) {
-                if (seen.count({v, u}) || seen.count({u, v})) continue;
-                seen.insert({u, v});
-                ss << u << " " << v << "\n";
-            }
-        }
-        return ss.str();
-    }
-};
\ No newline at end of file
+#pragma once
+#include "Graph.hpp"
+#include "ConcurrentGraph.hpp"
+#include "SpanningTrees.hpp"
+#include "Cycles.hpp"
+#include "Communities.hpp"
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <algorithm>
+
+// Parsers build a Graph by default; EdgeListParser::parse<Graph64>(in) reads 64-bit ids.
+// Weights found in the input are kept when the graph type supports them.
+template <class G>
+void addParsedEdge(G& g, typename G::Vertex u, typename G::Vertex v, double w) {
+    if constexpr (HasEdgeWeights<G>::value) g.addEdge(u, v, w);
+    else g.addEdge(u, v);
+}
+
+class EdgeListParser {
+public:
+    // One edge list line at a time (see readLine): "u v", "u v w" for a
+    // weighted edge, or an even number of ids taken as pairs "u1 v1 u2 v2 ...".
+    // Blank lines and '#'/'%' comments are skipped, and so are malformed lines,
+    // whose count ends up in `malformed`.
+    template <class G = Graph>
+    static G parse(std::istream& in, size_t& malformed) {
+        using V = typename G::Vertex;
+        G g; std::string line;
+        malformed = 0;
+        while (std::getline(in, line)) {
+            bool ok = readLine<V>(line.data(), line.data() + line.size(), [&g](V u, V v, double w, bool weighted) {
+                if (weighted) addParsedEdge(g, u, v, w);
+                else g.addEdge(u, v);
+            });
+            malformed += !ok;
+        }
+        return g;
+    }
+
+    template <class G = Graph>
+    static G parse(std::istream& in) {
+        size_t malformed;
+        return parse<G>(in, malformed);
+    }
+
+    // Splits the text at line boundaries and parses the pieces as parallel tasks,
+    // all inserting into the shared graph. Several callers may feed one graph at once.
+    // Each line is read on its own by readLine; weights are dropped, since the
+    // concurrent graph keeps none. Returns the number of malformed lines, which
+    // are skipped.
+    template <class V>
+    static size_t parseInto(std::istream& in, BasicConcurrentGraph<V>& g) {
+        std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t pieces = 4 * (size_t)Parallel::threadCount();
+        std::vector<size_t> cut{0};
+        for (size_t i = 1; i < pieces; ++i) {
+            size_t p = std::max(cut.back(), text.size() * i / pieces);
+            while (p < text.size() && text[p] != '\n') ++p;
+            cut.push_back(p);
+        }
+        cut.push_back(text.size());
+        std::vector<size_t> malformed(pieces, 0);
+        Parallel::forRange(0, cut.size() - 1, [&](size_t lo, size_t hi) {
+            for (size_t piece = lo; piece < hi; ++piece) {
+                const char* p = text.data() + cut[piece];
+                const char* end = text.data() + cut[piece + 1];
+                while (p < end) {
+                    const char* eol = std::find(p, end, '\n');
+                    if (!readLine<V>(p, eol, [&g](V u, V v, double, bool) { g.addEdge(u, v); })) malformed[piece]++;
+                    p = eol + (eol < end);
+                }
+            }
+        }, 0, pieces);
+        return std::accumulate(malformed.begin(), malformed.end(), size_t(0));
+    }
+
+private:
+    static void skipBlanks(const char*& p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',' || *p == '\r')) ++p;
+    }
+
+    // Skips blanks and parses one whole token from [p, end) as a number.
+    template <class T>
+    static bool readNumber(const char*& p, const char* end, T& out) {
+        skipBlanks(p, end);
+        auto [next, ec] = std::from_chars(p, end, out);
+        if (ec != std::errc() || (next < end && *next != ' ' && *next != '\t' && *next != ',' && *next != '\r')) return false;
+        p = next;
+        return true;
+    }
+
+    // One line: blank or a '#'/'%' comment, "u v", "u v w", or an even number
+    // of ids read as consecutive pairs. edge(u, v, w, weighted) is called only
+    // once the whole line has parsed; false means the line is malformed.
+    template <class V, class Edge>
+    static bool readLine(const char* p, const char* end, Edge&& edge) {
+        skipBlanks(p, end);
+        if (p == end || *p == '#' || *p == '%') return true;
+        const char* first = p;
+        V u, v;
+        double w;
+        if (!readNumber(p, end, u) || !readNumber(p, end, v)) return false;
+        skipBlanks(p, end);
+        if (p == end) { edge(u, v, 1.0, false); return true; }
+        const char* third = p;
+        if (readNumber(p, end, w) && (skipBlanks(p, end), p == end)) {
+            if (!std::isfinite(w)) return false;
+            edge(u, v, w, true);
+            return true;
+        }
+        for (p = third; skipBlanks(p, end), p < end;)
+            if (!readNumber(p, end, u) || !readNumber(p, end, v)) return false;
+        for (p = first; skipBlanks(p, end), p < end;) {
+            readNumber(p, end, u);
+            readNumber(p, end, v);
+            edge(u, v, 1.0, false);
+        }
+        return true;
+    }
+};
+
+class MatrixParser {
+public:
+    template <class G = Graph>
+    static G parse(std::istream& in) {
+        using V = typename G::Vertex;
+        G g; V n;
+        if (!(in >> n)) return g;
+        // Cells are edge weights; 0 means no edge and 1 a plain edge.
+        for (V i=0; i<n; ++i)
+            for (V j=0; j<n; ++j) {
+                double e; in >> e;
+                if (!e || i >= j) continue;
+                if (e == 1) g.addEdge(i, j);
+                else addParsedEdge(g, i, j, e);
+            }
+        return g;
+    }
+};
+
+class DimacsParser {
+public:
+    template <class G = Graph>
+    static G parse(std::istream& in) {
+        G g; std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == 'c' || line[0] == 'p') continue;
+            std::stringstream ss(line);
+            char type; ss >> type;
+            if (type == 'e') { typename G::Vertex u, v; ss >> u >> v; g.addEdge(u, v); }
+            if (type == 'a') { typename G::Vertex u, v; double w; ss >> u >> v >> w; addParsedEdge(g, u, v, w); }
+        }
+        return g;
+    }
+};
+
+class GraphVizSerializer {
+public:
+    enum HighlightMode { NONE, SPANNING_TREE, RANDOM_CYCLE, MINIMUM_SPANNING_TREE, BFS_TREE, DFS_TREE,
+                         SHORTEST_CYCLE, CYCLE_BASIS, COMMUNITIES };
+
+    // SPANNING_TREE is a uniform random spanning forest (Wilson), MINIMUM_SPANNING_TREE
+    // uses the edge weights; trees are drawn in red. Cycle modes draw a random or a
+    // shortest cycle in blue, CYCLE_BASIS a minimum cycle basis one colour per cycle.
+    // COMMUNITIES fills every vertex with the colour of its Leiden community.
+    template <class G>
+    static std::string serialize(const G& g, HighlightMode mode = NONE) {
+        using V = typename G::Vertex;
+        if (mode == NONE) return render(g, [](V, V) { return ""; });
+        using C = CompactOf<G>;
+        C c = C::fromGraph(g);
+        switch (mode) {
+            case RANDOM_CYCLE: return serialize(g, c, std::vector<Cycles::Cycle<C>>{Cycles::Random(c)});
+            case SHORTEST_CYCLE: return serialize(g, c, std::vector<Cycles::Cycle<C>>{Cycles::Shortest(c)});
+            case CYCLE_BASIS: return serialize(g, c, Cycles::MinimumBasis(c));
+            case COMMUNITIES: return serialize(g, c, CommunityDetection::Leiden(c));
+            default: return serialize(g, c, spanningForest(c, mode));
+        }
+    }
+
+    // Highlights a forest computed on `c`, the CSR copy of g; one O(1) test per edge.
+    template <class G, class C>
+    static std::string serialize(const G& g, const C& c, const BasicSpanningForest<typename C::Index>& forest) {
+        using V = typename G::Vertex;
+        return render(g, [&](V u, V v) { return forest.contains(c.index(u), c.index(v)) ? kTreeStyle : ""; });
+    }
+
+    // Highlights cycles computed on `c`; an edge on several cycles takes the colour of the first.
+    template <class G, class C>
+    static std::string serialize(const G& g, const C& c, const std::vector<Cycles::Cycle<C>>& cycles) {
+        using V = typename G::Vertex;
+        auto edgeId = Cycles::edgeIds(c);
+        std::vector<size_t> owner(c.edgeCount(), SIZE_MAX);
+        for (size_t k = cycles.size(); k-- > 0;)
+            for (size_t i = 0; i < cycles[k].size(); ++i)
+                owner[edgeId[Cycles::slotOf(c, cycles[k][i], cycles[k][(i + 1) % cycles[k].size()])]] = k;
+        return render(g, [&](V u, V v) {
+            size_t k = owner[edgeId[Cycles::slotOf(c, c.index(u), c.index(v))]];
+            return k == SIZE_MAX ? "" : kCycleStyles[k % std::size(kCycleStyles)];
+        });
+    }
+
+    // One fill colour per community, hues spread by the golden ratio.
+    template <class G, class C>
+    static std::string serialize(const G& g, const C& c, const BasicCommunities<typename C::Index>& communities) {
+        using V = typename G::Vertex;
+        return render(g, [](V, V) { return ""; }, [&](V v) {
+            double hue = std::fmod(communities.label[c.index(v)] * 0.618033988749895, 1.0);
+            std::stringstream style;
+            style << " [style=filled, fillcolor=\"" << hue << " 0.45 0.95\"]";
+            return style.str();
+        });
+    }
+
+private:
+    static constexpr const char* kTreeStyle = " [color=\"red\", penwidth=2.0]";
+    static constexpr const char* kCycleStyles[] = {
+        " [color=\"blue\", penwidth=2.0]", " [color=\"darkgreen\", penwidth=2.0]",
+        " [color=\"orange\", penwidth=2.0]", " [color=\"purple\", penwidth=2.0]",
+        " [color=\"brown\", penwidth=2.0]", " [color=\"magenta\", penwidth=2.0]"};
+
+    template <class C>
+    static BasicSpanningForest<typename C::Index> spanningForest(const C& c, HighlightMode mode) {
+        switch (mode) {
+            case MINIMUM_SPANNING_TREE: return SpanningTrees::Boruvka(c);
+            case BFS_TREE: return SpanningTrees::BFS(c);
+            case DFS_TREE: return SpanningTrees::DFS(c);
+            default: return SpanningTrees::Wilson(c);
+        }
+    }
+
+    // style(u, v) and vertexStyle(v) return attribute lists, empty for plain elements.
+    template <class G, class Style>
+    static std::string render(const G& g, Style style) {
+        return render(g, style, [](typename G::Vertex) { return ""; });
+    }
+
+    template <class G, class Style, class VertexStyle>
+    static std::string render(const G& g, Style style, VertexStyle vertexStyle) {
+        std::stringstream ss;
+        ss << "graph G {\n";
+        for (auto u : g.getVertices()) {
+            ss << "  " << u << vertexStyle(u) << ";\n";
+            for (auto v : g.neighbors(u)) {
+                if (v < u) continue; // every edge is printed once, from its smaller endpoint
+                ss << "  " << u << " -- " << v << style(u, v) << ";\n";
+            }
+        }
+        ss << "}\n";
+        return ss.str();
+    }
+};
+
+class Program4YouSerializer {
+public:
+    template <class G>
+    static std::string serialize(const G& g) {
+        std::stringstream ss;
+        ss << g.vertexCount() << " " << g.edgeCount() << "\n";
+        for (auto u : g.getVertices()) {
+            for (auto v : g.neighbors(u)) {
+                if (v < u) continue;
+                ss << u << " " << v << "\n";
+            }
+        }
+        return ss.str();
+    }
+};
@@ -0,0 +1,312 @@
+#pragma once
+#include "Views.hpp"
+#include <cmath>
+
+// Graph families whose adjacency is a formula. Vertices are 0..n-1 numbered as
+// in the matching GraphGenerator, neighbors(v) and hasEdge are computed on the
+// fly and nothing is stored besides the parameters, so K_100000 costs O(1) memory.
+// Each family also knows its metrics in closed form; GraphMetrics picks those up
+// through the ClosedForm marker instead of running the general algorithms.
+
+// Neighbours of v enumerated as graph.neighbor(v, 0 .. degree(v)-1).
+template <class G>
+class ImplicitNeighbors {
+public:
+    using Vertex = typename G::Vertex;
+
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(const G* g, Vertex v, size_t k) : g(g), v(v), k(k) {}
+        Vertex operator*() const { return g->neighbor(v, k); }
+        iterator& operator++() { ++k; return *this; }
+        bool operator==(const iterator& o) const { return k == o.k; }
+        bool operator!=(const iterator& o) const { return k != o.k; }
+
+    private:
+        const G* g = nullptr;
+        Vertex v{};
+        size_t k = 0;
+    };
+
+    ImplicitNeighbors(const G* g, Vertex v) : g(g), v(v), d(g->degree(v)) {}
+
+    iterator begin() const { return iterator(g, v, 0); }
+    iterator end() const { return iterator(g, v, d); }
+    size_t size() const { return d; }
+    bool empty() const { return d == 0; }
+
+private:
+    const G* g;
+    Vertex v;
+    size_t d;
+};
+
+template <class Derived, class V>
+class ImplicitGraph : public GraphView<Derived, V> {
+public:
+    using Vertex = V;
+    using Neighbors = ImplicitNeighbors<Derived>;
+    using ClosedForm = Derived;
+
+    explicit ImplicitGraph(V n) : n(n) {}
+
+    std::vector<Vertex> getVertices() const {
+        std::vector<Vertex> res(n);
+        for (V i = 0; i < n; ++i) res[i] = i;
+        return res;
+    }
+
+    bool hasVertex(Vertex v) const { return v >= V(0) && v < n; }
+
+    Neighbors neighbors(Vertex v) const {
+        if (!hasVertex(v)) throw std::out_of_range("ImplicitGraph::neighbors: unknown vertex");
+        return Neighbors(static_cast<const Derived*>(this), v);
+    }
+
+    size_t vertexCount() const { return n; }
+
+    // Defaults shared by most families; Derived hides what differs.
+    size_t components() const { return n ? 1 : 0; }
+    size_t articulationPoints() const { return 0; }
+    size_t bridges() const { return 0; }
+    double transitivity() const { return 0.0; }
+
+protected:
+    static constexpr double kPi = 3.14159265358979323846;
+
+    V n;
+};
+
+// Kn.
+template <class V = Graph::Vertex>
+class ImplicitComplete : public ImplicitGraph<ImplicitComplete<V>, V> {
+public:
+    using ImplicitGraph<ImplicitComplete, V>::ImplicitGraph;
+
+    size_t degree(V) const { return n - 1; }
+    V neighbor(V v, size_t k) const { return (V)k < v ? (V)k : (V)(k + 1); }
+    bool hasEdge(V u, V v) const { return u != v && this->hasVertex(u) && this->hasVertex(v); }
+    size_t edgeCount() const { return (size_t)n * (n - (n > 0)) / 2; }
+
+    size_t diameter() const { return n > 1; }
+    bool bipartite() const { return n <= 2; }
+    size_t colors() const { return n; }
+    size_t clique() const { return n; }
+    double transitivity() const { return n >= 3 ? 1.0 : 0.0; }
+    size_t bridges() const { return n == 2; }
+    size_t degeneracy() const { return n ? n - 1 : 0; }
+    size_t girth() const { return n >= 3 ? 3 : 0; }
+    size_t edgeConnectivity() const { return n > 1 ? n - 1 : 0; }
+    size_t vertexConnectivity() const { return n > 1 ? n - 1 : 0; }
+    double spectralRadius() const { return n > 1 ? n - 1.0 : 0.0; }
+    double algebraicConnectivity() const { return n > 1 ? (double)n : 0.0; }
+
+private:
+    using ImplicitGraph<ImplicitComplete, V>::n;
+};
+
+// K(a, b): 0..a-1 on one side, a..a+b-1 on the other.
+template <class V = Graph::Vertex>
+class ImplicitCompleteBipartite : public ImplicitGraph<ImplicitCompleteBipartite<V>, V> {
+public:
+    ImplicitCompleteBipartite(V a, V b) : ImplicitGraph<ImplicitCompleteBipartite, V>(a + b), a(a), b(b) {
+        if (a < 1 || b < 1) throw std::invalid_argument("ImplicitCompleteBipartite: both sides need a vertex");
+    }
+
+    size_t degree(V v) const { return v < a ? b : a; }
+    V neighbor(V v, size_t k) const { return v < a ? (V)(a + k) : (V)k; }
+    bool hasEdge(V u, V v) const { return this->hasVertex(u) && this->hasVertex(v) && ((u < a) != (v < a)); }
+    size_t edgeCount() const { return (size_t)a * b; }
+
+    size_t diameter() const { return a + b == 2 ? 1 : 2; }
+    bool bipartite() const { return true; }
+    size_t colors() const { return 2; }
+    size_t clique() const { return 2; }
+    size_t articulationPoints() const { return (a == 1) != (b == 1); }
+    size_t bridges() const { return std::min(a, b) == 1 ? std::max(a, b) : 0; }
+    size_t degeneracy() const { return std::min(a, b); }
+    size_t girth() const { return std::min(a, b) >= 2 ? 4 : 0; }
+    size_t edgeConnectivity() const { return std::min(a, b); }
+    size_t vertexConnectivity() const { return std::min(a, b); }
+    double spectralRadius() const { return std::sqrt((double)a * b); }
+    double algebraicConnectivity() const {
+        // Laplacian spectrum: 0, a (b - 1 times), b (a - 1 times), a + b.
+        double best = a + b;
+        if (b > 1) best = std::min(best, (double)a);
+        if (a > 1) best = std::min(best, (double)b);
+        return best;
+    }
+
+private:
+    V a, b;
+};
+
+// Sn: hub 0 joined to 1..n-1, n >= 2.
+template <class V = Graph::Vertex>
+class ImplicitStar : public ImplicitGraph<ImplicitStar<V>, V> {
+public:
+    explicit ImplicitStar(V n) : ImplicitGraph<ImplicitStar, V>(n) {
+        if (n < 2) throw std::invalid_argument("ImplicitStar: needs n >= 2");
+    }
+
+    size_t degree(V v) const { return v == 0 ? n - 1 : 1; }
+    V neighbor(V v, size_t k) const { return v == 0 ? (V)(k + 1) : 0; }
+    bool hasEdge(V u, V v) const { return this->hasVertex(u) && this->hasVertex(v) && ((u == 0) != (v == 0)); }
+    size_t edgeCount() const { return n - 1; }
+
+    size_t diameter() const { return n == 2 ? 1 : 2; }
+    bool bipartite() const { return true; }
+    size_t colors() const { return 2; }
+    size_t clique() const { return 2; }
+    size_t articulationPoints() const { return n >= 3; }
+    size_t bridges() const { return n - 1; }
+    size_t degeneracy() const { return 1; }
+    size_t girth() const { return 0; }
+    size_t edgeConnectivity() const { return 1; }
+    size_t vertexConnectivity() const { return 1; }
+    double spectralRadius() const { return std::sqrt(n - 1.0); }
+    double algebraicConnectivity() const { return n == 2 ? 2.0 : 1.0; }
+
+private:
+    using ImplicitGraph<ImplicitStar, V>::n;
+};
+
+// Cn, n >= 3.
+template <class V = Graph::Vertex>
+class ImplicitCycle : public ImplicitGraph<ImplicitCycle<V>, V> {
+public:
+    explicit ImplicitCycle(V n) : ImplicitGraph<ImplicitCycle, V>(n) {
+        if (n < 3) throw std::invalid_argument("ImplicitCycle: needs n >= 3");
+    }
+
+    size_t degree(V) const { return 2; }
+    V neighbor(V v, size_t k) const { return k == 0 ? (V)((v + 1) % n) : (V)((v + n - 1) % n); }
+    bool hasEdge(V u, V v) const {
+        if (!this->hasVertex(u) || !this->hasVertex(v)) return false;
+        V d = (v + n - u) % n;
+        return d == 1 || d == n - 1;
+    }
+    size_t edgeCount() const { return n; }
+
+    size_t diameter() const { return n / 2; }
+    bool bipartite() const { return n % 2 == 0; }
+    size_t colors() const { return n % 2 ? 3 : 2; }
+    size_t clique() const { return n == 3 ? 3 : 2; }
+    double transitivity() const { return n == 3 ? 1.0 : 0.0; }
+    size_t degeneracy() const { return 2; }
+    size_t girth() const { return n; }
+    size_t edgeConnectivity() const { return 2; }
+    size_t vertexConnectivity() const { return 2; }
+    double spectralRadius() const { return 2.0; }
+    double algebraicConnectivity() const { return 2.0 - 2.0 * std::cos(2.0 * this->kPi / n); }
+
+private:
+    using ImplicitGraph<ImplicitCycle, V>::n;
+};
+
+// Pn, n >= 1.
+template <class V = Graph::Vertex>
+class ImplicitPath : public ImplicitGraph<ImplicitPath<V>, V> {
+public:
+    explicit ImplicitPath(V n) : ImplicitGraph<ImplicitPath, V>(n) {
+        if (n < 1) throw std::invalid_argument("ImplicitPath: needs n >= 1");
+    }
+
+    size_t degree(V v) const { return (v > 0) + (v + 1 < n); }
+    V neighbor(V v, size_t k) const { return k == 0 && v > 0 ? v - 1 : v + 1; }
+    bool hasEdge(V u, V v) const { return this->hasVertex(u) && this->hasVertex(v) && (u + 1 == v || v + 1 == u); }
+    size_t edgeCount() const { return n - 1; }
+
+    size_t diameter() const { return n - 1; }
+    bool bipartite() const { return true; }
+    size_t colors() const { return n > 1 ? 2 : 1; }
+    size_t clique() const { return n > 1 ? 2 : 1; }
+    size_t articulationPoints() const { return n > 2 ? n - 2 : 0; }
+    size_t bridges() const { return n - 1; }
+    size_t degeneracy() const { return n > 1; }
+    size_t girth() const { return 0; }
+    size_t edgeConnectivity() const { return n > 1; }
+    size_t vertexConnectivity() const { return n > 1; }
+    double spectralRadius() const { return 2.0 * std::cos(this->kPi / (n + 1.0)); }
+    double algebraicConnectivity() const { return n > 1 ? 2.0 - 2.0 * std::cos(this->kPi / n) : 0.0; }
+
+private:
+    using ImplicitGraph<ImplicitPath, V>::n;
+};
+
+// Wn: rim cycle 0..n-2 and hub n-1, n >= 4.
+template <class V = Graph::Vertex>
+class ImplicitWheel : public ImplicitGraph<ImplicitWheel<V>, V> {
+public:
+    explicit ImplicitWheel(V n) : ImplicitGraph<ImplicitWheel, V>(n), rim(n - 1) {
+        if (n < 4) throw std::invalid_argument("ImplicitWheel: needs n >= 4");
+    }
+
+    size_t degree(V v) const { return v == rim ? rim : 3; }
+    V neighbor(V v, size_t k) const {
+        if (v == rim) return (V)k;
+        return k == 0 ? (V)((v + 1) % rim) : k == 1 ? (V)((v + rim - 1) % rim) : rim;
+    }
+    bool hasEdge(V u, V v) const {
+        if (!this->hasVertex(u) || !this->hasVertex(v) || u == v) return false;
+        if (u == rim || v == rim) return true;
+        V d = (v + rim - u) % rim;
+        return d == 1 || d == rim - 1;
+    }
+    size_t edgeCount() const { return 2 * (size_t)rim; }
+
+    size_t diameter() const { return rim == 3 ? 1 : 2; }
+    bool bipartite() const { return false; }
+    size_t colors() const { return rim % 2 ? 4 : 3; }
+    size_t clique() const { return rim == 3 ? 4 : 3; }
+    double transitivity() const {
+        double triangles = rim + (rim == 3), triads = 3.0 * rim + (double)rim * (rim - 1) / 2;
+        return 3 * triangles / triads;
+    }
+    size_t degeneracy() const { return 3; }
+    size_t girth() const { return 3; }
+    size_t edgeConnectivity() const { return 3; }
+    size_t vertexConnectivity() const { return 3; }
+    double spectralRadius() const { return 1.0 + std::sqrt(rim + 1.0); }
+    double algebraicConnectivity() const { return 3.0 - 2.0 * std::cos(2.0 * this->kPi / rim); }
+
+private:
+    V rim;
+};
+
+// Cubic graph of GraphGenerator::Cubic (Moebius ladder): i ~ i +- 1 and i ~ i + n/2, n even >= 4.
+template <class V = Graph::Vertex>
+class ImplicitCubic : public ImplicitGraph<ImplicitCubic<V>, V> {
+public:
+    explicit ImplicitCubic(V n) : ImplicitGraph<ImplicitCubic, V>(n) {
+        if (n < 4 || n % 2) throw std::invalid_argument("ImplicitCubic: needs even n >= 4");
+    }
+
+    size_t degree(V) const { return 3; }
+    V neighbor(V v, size_t k) const { return (V)((v + (k == 0 ? 1 : k == 1 ? n - 1 : n / 2)) % n); }
+    bool hasEdge(V u, V v) const {
+        if (!this->hasVertex(u) || !this->hasVertex(v)) return false;
+        V d = (v + n - u) % n;
+        return d == 1 || d == n - 1 || d == n / 2;
+    }
+    size_t edgeCount() const { return 3 * (size_t)n / 2; }
+
+    size_t diameter() const { return n == 4 ? 1 : (n + 3) / 4; }
+    bool bipartite() const { return (n / 2) % 2 == 1; }
+    size_t colors() const { return n == 4 ? 4 : (n / 2) % 2 ? 2 : 3; }
+    size_t clique() const { return n == 4 ? 4 : 2; }
+    double transitivity() const { return n == 4 ? 1.0 : 0.0; }
+    size_t degeneracy() const { return 3; }
+    size_t girth() const { return n == 4 ? 3 : 4; }
+    size_t edgeConnectivity() const { return 3; }
+    size_t vertexConnectivity() const { return 3; }
+    // Adjacency eigenvalues 2 cos(2 pi j / n) + (-1)^j, j = 0..n-1.
+    double spectralRadius() const { return 3.0; }
+    double algebraicConnectivity() const {
+        return std::min(4.0 - 2.0 * std::cos(2.0 * this->kPi / n), 2.0 - 2.0 * std::cos(4.0 * this->kPi / n));
+    }
+
+private:
+    using ImplicitGraph<ImplicitCubic, V>::n;
+};
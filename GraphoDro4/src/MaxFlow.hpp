@@ -0,0 +1,126 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// Residual network for s-t maximum flow. Arcs are added in pairs (arc a and
+// its reverse a ^ 1), so an undirected edge of capacity c is one pair with
+// capacity c both ways. Flows accumulate across maxFlow calls until reset().
+class FlowNetwork {
+public:
+    static constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+    explicit FlowNetwork(size_t nodes = 0) : nodes(nodes) {}
+
+    size_t nodeCount() const { return nodes; }
+
+    // Returns the id of the forward arc.
+    size_t addEdge(size_t u, size_t v, double capacity, double reverseCapacity = 0.0) {
+        size_t a = to.size();
+        to.push_back(v); cap.push_back(capacity);
+        to.push_back(u); cap.push_back(reverseCapacity);
+        original.push_back(capacity); original.push_back(reverseCapacity);
+        start.clear();
+        return a;
+    }
+
+    // Flow currently on arc a (negative when it runs against the arc).
+    double flow(size_t a) const { return original[a] - cap[a]; }
+
+    void reset() { cap = original; }
+
+    // Dinic: BFS level graph, then blocking flow by iterative DFS with per-node
+    // arc pointers. Stops once `limit` more units have been pushed, which makes
+    // "is the s-t connectivity at least k" cost at most k augmentations.
+    double maxFlow(size_t s, size_t t, double limit = kInfinity) {
+        if (s == t) return 0.0;
+        build();
+        double total = 0.0;
+        std::vector<size_t> path;
+        while (total < limit && levels(s, t)) {
+            for (size_t v = 0; v < nodes; ++v) next[v] = start[v];
+            size_t v = s;
+            path.clear();
+            while (total < limit) {
+                if (v == t) {
+                    double push = limit - total;
+                    for (size_t a : path) push = std::min(push, cap[a]);
+                    for (size_t a : path) { cap[a] -= push; cap[a ^ 1] += push; }
+                    total += push;
+                    // Retreat to the tail of the first saturated arc.
+                    size_t keep = 0;
+                    while (keep < path.size() && cap[path[keep]] > kEpsilon) keep++;
+                    path.resize(keep);
+                    v = keep ? to[path.back()] : s;
+                    continue;
+                }
+                size_t& i = next[v];
+                while (i < start[v + 1] && !(cap[arcs[i]] > kEpsilon && level[to[arcs[i]]] == level[v] + 1)) i++;
+                if (i < start[v + 1]) {
+                    path.push_back(arcs[i]);
+                    v = to[arcs[i]];
+                    continue;
+                }
+                if (v == s) break;
+                level[v] = kUnreached; // dead end for this phase
+                size_t a = path.back();
+                path.pop_back();
+                v = to[a ^ 1];
+                next[v]++;
+            }
+        }
+        return total;
+    }
+
+    // Nodes reachable from s in the residual network: the source side of a
+    // minimum cut after maxFlow(s, t).
+    std::vector<char> sourceSide(size_t s) {
+        build();
+        std::vector<char> seen(nodes, 0);
+        std::vector<size_t> stack{s};
+        seen[s] = 1;
+        while (!stack.empty()) {
+            size_t v = stack.back(); stack.pop_back();
+            for (size_t i = start[v]; i < start[v + 1]; ++i)
+                if (cap[arcs[i]] > kEpsilon && !seen[to[arcs[i]]]) { seen[to[arcs[i]]] = 1; stack.push_back(to[arcs[i]]); }
+        }
+        return seen;
+    }
+
+private:
+    static constexpr double kEpsilon = 1e-12;
+    static constexpr size_t kUnreached = std::numeric_limits<size_t>::max();
+
+    size_t nodes;
+    std::vector<size_t> to, start, arcs, level, next;
+    std::vector<double> cap, original;
+
+    // Groups arc ids by tail (CSR) the first time a flow runs after edges changed.
+    void build() {
+        if (!start.empty()) return;
+        start.assign(nodes + 1, 0);
+        for (size_t a = 0; a < to.size(); ++a) start[to[a ^ 1] + 1]++;
+        for (size_t v = 0; v < nodes; ++v) start[v + 1] += start[v];
+        arcs.resize(to.size());
+        std::vector<size_t> fill(start.begin(), start.end() - 1);
+        for (size_t a = 0; a < to.size(); ++a) arcs[fill[to[a ^ 1]]++] = a;
+        level.resize(nodes);
+        next.resize(nodes);
+    }
+
+    bool levels(size_t s, size_t t) {
+        std::fill(level.begin(), level.end(), kUnreached);
+        std::vector<size_t> queue{s};
+        level[s] = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            size_t v = queue[head];
+            if (level[t] != kUnreached && level[v] >= level[t]) break; // deeper nodes are never on a shortest path
+            for (size_t i = start[v]; i < start[v + 1]; ++i) {
+                size_t u = to[arcs[i]];
+                if (cap[arcs[i]] > kEpsilon && level[u] == kUnreached) { level[u] = level[v] + 1; queue.push_back(u); }
+            }
+        }
+        return level[t] != kUnreached;
+    }
+};
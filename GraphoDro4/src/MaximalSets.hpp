@@ -0,0 +1,284 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <numeric>
+#include <random>
+
+template <class Index>
+struct BasicIndependentSet {
+    std::vector<Index> members; // sorted compact indices
+    size_t rounds = 0;          // parallel rounds (1 for the sequential greedy)
+    size_t size() const { return members.size(); }
+};
+
+// mate[v] is v's partner or kNone; edges lists every matched pair once as (min, max).
+template <class Index>
+struct BasicMatching {
+    static constexpr Index kNone = std::numeric_limits<Index>::max();
+    std::vector<Index> mate;
+    std::vector<std::pair<Index, Index>> edges;
+    size_t rounds = 0;
+    size_t size() const { return edges.size(); }
+};
+
+using IndependentSet = BasicIndependentSet<CompactGraph::Index>;
+using Matching = BasicMatching<CompactGraph::Index>;
+
+// Maximal independent set and maximal matching on a CompactGraph; self-loops
+// are ignored. The greedy versions scan vertices (edges) in a random order
+// drawn from `seed`; the deterministic-reservation versions (Blelloch,
+// Fineman, Shun 2012) process that order in parallel windows and return
+// exactly the greedy result for the same seed, whatever the thread count.
+class MaximalSets {
+public:
+    template <class C>
+    static BasicIndependentSet<typename C::Index> GreedyIndependentSet(const C& g, uint64_t seed = 0) {
+        using Index = typename C::Index;
+        std::vector<Index> order = permutation<Index>(g.vertexCount(), seed);
+        std::vector<char> state(g.vertexCount(), kUndecided);
+        for (Index v : order) {
+            if (state[v] != kUndecided) continue;
+            state[v] = kIn;
+            for (Index u : g.neighbors(v)) if (u != v) state[u] = kOut;
+        }
+        return collect<Index>(state, 1);
+    }
+
+    // Every vertex of the window joins once all earlier neighbours are out and
+    // leaves once one of them is in; decided vertices are dropped from the
+    // window, which then refills from the order.
+    template <class C>
+    static BasicIndependentSet<typename C::Index> IndependentSet(const C& g, unsigned threads = 0, uint64_t seed = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<Index> pending = permutation<Index>(n, seed), rank(n);
+        for (Index i = 0; i < n; ++i) rank[pending[i]] = i;
+        std::vector<std::atomic<char>> state(n);
+        for (auto& s : state) s.store(kUndecided, std::memory_order_relaxed);
+        size_t rounds = 0;
+        windows(pending, n, threads, rounds, [&](Index v) {
+            char next = kIn;
+            for (Index u : g.neighbors(v)) {
+                if (u == v || rank[u] > rank[v]) continue;
+                char s = state[u].load(std::memory_order_acquire);
+                if (s == kIn) { next = kOut; break; }
+                if (s == kUndecided) next = kUndecided;
+            }
+            if (next != kUndecided) state[v].store(next, std::memory_order_release);
+            return next != kUndecided;
+        });
+        std::vector<char> plain(n);
+        for (Index v = 0; v < n; ++v) plain[v] = state[v].load(std::memory_order_relaxed);
+        return collect<Index>(plain, rounds);
+    }
+
+    // Luby (1986): every round each live vertex draws a fresh random priority
+    // and joins if it beats all live neighbours; winners and their neighbours
+    // leave the graph. O(log n) rounds with high probability.
+    template <class C>
+    static BasicIndependentSet<typename C::Index> Luby(const C& g, unsigned threads = 0, uint64_t seed = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<char> state(n, kUndecided);
+        std::vector<Index> live(n);
+        std::iota(live.begin(), live.end(), Index(0));
+        size_t rounds = 0;
+        for (; !live.empty(); ++rounds) {
+            auto priority = [&](Index v) { return std::make_pair(mix(seed ^ mix(rounds * 0x9e3779b97f4a7c15ULL + v)), v); };
+            std::vector<char> wins(live.size(), 0);
+            Parallel::forRange(0, live.size(), [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    Index v = live[i];
+                    auto mine = priority(v);
+                    bool best = true;
+                    for (Index u : g.neighbors(v))
+                        if (u != v && state[u] == kUndecided && priority(u) < mine) { best = false; break; }
+                    wins[i] = best;
+                }
+            }, threads);
+            for (size_t i = 0; i < live.size(); ++i) if (wins[i]) state[live[i]] = kIn;
+            Parallel::forRange(0, live.size(), [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i)
+                    if (!wins[i])
+                        for (Index u : g.neighbors(live[i]))
+                            if (state[u] == kIn && u != live[i]) { wins[i] = 2; break; }
+            }, threads);
+            size_t kept = 0;
+            for (size_t i = 0; i < live.size(); ++i) {
+                if (wins[i] == 2) state[live[i]] = kOut;
+                else if (!wins[i]) live[kept++] = live[i];
+            }
+            live.resize(kept);
+        }
+        return collect<Index>(state, rounds);
+    }
+
+    template <class C>
+    static BasicMatching<typename C::Index> GreedyMatching(const C& g, uint64_t seed = 0) {
+        using Index = typename C::Index;
+        auto edges = shuffledEdges(g, seed);
+        BasicMatching<Index> res;
+        res.mate.assign(g.vertexCount(), res.kNone);
+        for (auto [u, v] : edges)
+            if (res.mate[u] == res.kNone && res.mate[v] == res.kNone) { res.mate[u] = v; res.mate[v] = u; }
+        return finishMatching(res, 1);
+    }
+
+    // Each window edge with two free endpoints reserves both by writing its
+    // position with an atomic min; an edge holding both reservations commits,
+    // edges with a matched endpoint are dropped and the rest retry.
+    template <class C>
+    static BasicMatching<typename C::Index> Matching(const C& g, unsigned threads = 0, uint64_t seed = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        auto edges = shuffledEdges(g, seed);
+        constexpr size_t kFree = std::numeric_limits<size_t>::max();
+        std::vector<std::atomic<size_t>> reserved(n);
+        std::vector<std::atomic<Index>> mate(n);
+        for (Index v = 0; v < n; ++v) {
+            reserved[v].store(kFree, std::memory_order_relaxed);
+            mate[v].store(BasicMatching<Index>::kNone, std::memory_order_relaxed);
+        }
+        auto matched = [&](Index v) { return mate[v].load(std::memory_order_relaxed) != BasicMatching<Index>::kNone; };
+        auto reserve = [&](Index v, size_t e) {
+            size_t cur = reserved[v].load(std::memory_order_relaxed);
+            while (e < cur && !reserved[v].compare_exchange_weak(cur, e, std::memory_order_relaxed)) {}
+        };
+        std::vector<size_t> pending(edges.size());
+        std::iota(pending.begin(), pending.end(), size_t(0));
+        size_t rounds = 0;
+        windowRounds(pending, edges.size(), threads, rounds,
+            [&](size_t e) {
+                auto [u, v] = edges[e];
+                if (!matched(u) && !matched(v)) { reserve(u, e); reserve(v, e); }
+            },
+            [&](size_t e) {
+                auto [u, v] = edges[e];
+                if (matched(u) || matched(v)) return true;
+                if (reserved[u].load(std::memory_order_relaxed) == e && reserved[v].load(std::memory_order_relaxed) == e) {
+                    mate[u].store(v, std::memory_order_relaxed);
+                    mate[v].store(u, std::memory_order_relaxed);
+                    return true;
+                }
+                return false;
+            },
+            [&](size_t e) {
+                reserved[edges[e].first].store(kFree, std::memory_order_relaxed);
+                reserved[edges[e].second].store(kFree, std::memory_order_relaxed);
+            });
+        BasicMatching<Index> res;
+        res.mate.resize(n);
+        for (Index v = 0; v < n; ++v) res.mate[v] = mate[v].load(std::memory_order_relaxed);
+        return finishMatching(res, rounds);
+    }
+
+    template <class C>
+    static bool IsMaximalIndependentSet(const C& g, const std::vector<typename C::Index>& members) {
+        std::vector<char> in(g.vertexCount(), 0);
+        for (auto v : members) in[v] = 1;
+        for (typename C::Index v = 0; v < g.vertexCount(); ++v) {
+            bool covered = in[v];
+            for (auto u : g.neighbors(v)) {
+                if (u == v) continue;
+                if (in[v] && in[u]) return false;
+                covered |= (bool)in[u];
+            }
+            if (!covered) return false;
+        }
+        return true;
+    }
+
+    template <class C>
+    static bool IsMaximalMatching(const C& g, const std::vector<typename C::Index>& mate) {
+        using Index = typename C::Index;
+        constexpr Index kNone = BasicMatching<Index>::kNone;
+        for (Index v = 0; v < g.vertexCount(); ++v) {
+            if (mate[v] != kNone) {
+                auto row = g.neighbors(v);
+                if (mate[v] == v || mate[mate[v]] != v || !std::binary_search(row.begin(), row.end(), mate[v])) return false;
+                continue;
+            }
+            for (Index u : g.neighbors(v)) if (u != v && mate[u] == kNone) return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr char kUndecided = 0, kIn = 1, kOut = 2;
+    static constexpr size_t kMinWindow = 1 << 12;
+
+    static uint64_t mix(uint64_t x) { // splitmix64 finalizer
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    template <class T>
+    static std::vector<T> permutation(size_t n, uint64_t seed) {
+        std::vector<T> order(n);
+        std::iota(order.begin(), order.end(), T(0));
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(seed));
+        return order;
+    }
+
+    template <class C>
+    static std::vector<std::pair<typename C::Index, typename C::Index>> shuffledEdges(const C& g, uint64_t seed) {
+        std::vector<std::pair<typename C::Index, typename C::Index>> edges;
+        for (typename C::Index v = 0; v < g.vertexCount(); ++v)
+            for (auto u : g.neighbors(v)) if (v < u) edges.push_back({v, u});
+        std::shuffle(edges.begin(), edges.end(), std::mt19937_64(seed));
+        return edges;
+    }
+
+    // Runs `decide` over windows of the pending order (a prefix of n/64, at
+    // least kMinWindow items); decided items leave, the rest keep their order.
+    template <class T, class Decide>
+    static void windows(std::vector<T>& pending, size_t total, unsigned threads, size_t& rounds, Decide&& decide) {
+        windowRounds(pending, total, threads, rounds, [](T) {}, [&](T x) { return decide(x); }, [](T) {});
+    }
+
+    // One round: `reserve` on every window item in parallel, then `commit` in
+    // parallel (true = finished), then `reset` on every item.
+    template <class T, class Reserve, class Commit, class Reset>
+    static void windowRounds(std::vector<T>& pending, size_t total, unsigned threads, size_t& rounds,
+                             Reserve&& reserve, Commit&& commit, Reset&& reset) {
+        size_t window = std::max(kMinWindow, total / 64), head = 0;
+        std::vector<char> finished;
+        while (head < pending.size()) {
+            size_t end = std::min(pending.size(), head + window);
+            finished.assign(end - head, 0);
+            Parallel::forRange(head, end, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) reserve(pending[i]);
+            }, threads);
+            Parallel::forRange(head, end, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) finished[i - head] = commit(pending[i]);
+            }, threads);
+            Parallel::forRange(head, end, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) reset(pending[i]);
+            }, threads);
+            // Slide the unfinished items, in order, to the end of the window.
+            size_t out = end;
+            for (size_t i = end; i-- > head;)
+                if (!finished[i - head]) pending[--out] = pending[i];
+            head = out;
+            rounds++;
+        }
+    }
+
+    template <class Index>
+    static BasicIndependentSet<Index> collect(const std::vector<char>& state, size_t rounds) {
+        BasicIndependentSet<Index> res;
+        for (Index v = 0; v < (Index)state.size(); ++v) if (state[v] == kIn) res.members.push_back(v);
+        res.rounds = rounds;
+        return res;
+    }
+
+    template <class Index>
+    static BasicMatching<Index>& finishMatching(BasicMatching<Index>& res, size_t rounds) {
+        for (Index v = 0; v < (Index)res.mate.size(); ++v)
+            if (res.mate[v] != res.kNone && v < res.mate[v]) res.edges.push_back({v, res.mate[v]});
+        res.rounds = rounds;
+        return res;
+    }
+};
@@ -1,172 +1,316 @@
-#pragma once
-#include "Graph.hpp"
-#include <queue>
-#include <iostream>
-#include <random>
-#include <cstdint>
-
-class GraphMetrics {
-public:
-    static double Density(const Graph& g) {
-        double n = g.vertexCount();
-        if (n < 2) return 0;
-        return (2.0 * g.edgeCount()) / (n * (n - 1));
-    }
-
-    static int ConnectedComponents(const Graph& g) {
-        std::set<Graph::Vertex> visited;
-        int count = 0;
-        GraphVisitor emptyVisitor;
-        for (auto v : g.getVertices()) {
-            if (visited.find(v) == visited.end()) {
-                g.dfs(v, emptyVisitor, visited);
-                count++;
-            }
-        }
-        return count;
-    }
-
-    static bool IsBipartite(const Graph& g) {
-        std::map<Graph::Vertex, int> color;
-        for (auto v : g.getVertices()) {
-            if (color.count(v)) continue;
-            color[v] = 0;
-            std::queue<Graph::Vertex> q;
-            q.push(v);
-            while (!q.empty()) {
-                auto curr = q.front(); q.pop();
-                for (auto n : g.neighbors(curr)) {
-                    if (!color.count(n)) {
-                        color[n] = 1 - color[curr];
-                        q.push(n);
-                    } else if (color[n] == color[curr]) return false;
-                }
-            }
-        }
-        return true;
-    }
-
-    static int GreedyColoring(const Graph& g) {
-        std::map<Graph::Vertex, int> result;
-        int max_color = 0;
-        for (auto v : g.getVertices()) {
-            std::set<int> used;
-            for (auto n : g.neighbors(v)) if (result.count(n)) used.insert(result[n]);
-            int clr = 0;
-            while (used.count(clr)) clr++;
-            result[v] = clr;
-            max_color = std::max(max_color, clr);
-        }
-        return max_color + 1;
-    }
-
-    static int Diameter(const Graph& g) {
-        int max_d = 0;
-        for (auto start : g.getVertices()) {
-            std::map<int, int> dist;
-            std::queue<int> q;
-            dist[start] = 0;
-            q.push(start);
-            while (!q.empty()) {
-                int v = q.front(); q.pop();
-                for (int u : g.neighbors(v)) {
-                    if (dist.find(u) == dist.end()) {
-                        dist[u] = dist[v] + 1;
-                        max_d = std::max(max_d, dist[u]);
-                        q.push(u);
-                    }
-                }
-            }
-        }
-        return max_d;
-    }
-
-    static double Transitivity(const Graph& g) {
-        long long triads = 0, triangles = 0;
-        auto vertices = g.getVertices();
-        for (int v : vertices) {
-            long long d = g.neighbors(v).size();
-            triads += d * (d - 1) / 2;
-        }
-        if (triads == 0) return 0.0;
-        for (int u : vertices) {
-            for (int v : g.neighbors(u)) {
-                if (u < v) {
-                    for (int w : g.neighbors(v)) {
-                        if (v < w && g.hasEdge(u, w)) triangles++;
-                    }
-                }
-            }
-        }
-        return (3.0 * triangles) / triads;
-    }
-
-    static int CountArticulationPoints(const Graph& g) {
-        int timer = 0;
-        std::map<int, int> tin, low;
-        std::set<int> visited, aps;
-        for (auto v : g.getVertices()) {
-            if (visited.find(v) == visited.end()) {
-                dfsAPs(g, v, -1, timer, visited, tin, low, aps);
-            }
-        }
-        return aps.size();
-    }
-
-    static int CountBridgesRandomized(const Graph& g) {
-        std::map<int, uint64_t> xor_sum;
-        std::set<int> visited;
-        std::map<int, int> depth;
-        int bridges = 0;
-        std::mt19937_64 rng(std::random_device{}());
-        for (int root : g.getVertices()) {
-            if (visited.find(root) == visited.end()) {
-                dfsRandomBridges(g, root, -1, 0, visited, depth, xor_sum, bridges, rng);
-            }
-        }
-        return bridges;
-    }
-
-private:
-    static void dfsAPs(const Graph& g, int v, int p, int& timer, std::set<int>& visited, 
-                       std::map<int, int>& tin, std::map<int, int>& low, std::set<int>& aps) {
-        visited.insert(v);
-        tin[v] = low[v] = timer++;
-        int children = 0;
-        for (int to : g.neighbors(v)) {
-            if (to == p) continue;
-            if (visited.count(to)) {
-                low[v] = std::min(low[v], tin[to]);
-            } else {
-                dfsAPs(g, to, v, timer, visited, tin, low, aps);
-                low[v] = std::min(low[v], low[to]);
-                if (low[to] >= tin[v] && p != -1) aps.insert(v);
-                children++;
-            }
-        }
-        if (p == -1 && children > 1) aps.insert(v);
-    }
-
-    static void dfsRandomBridges(const Graph& g, int v, int p, int d, std::set<int>& visited, 
-                                 std::map<int, int>& depth, std::map<int, uint64_t>& xor_sum, 
-                                 int& bridges, std::mt19937_64& rng) {
-        visited.insert(v);
-        depth[v] = d;
-        xor_sum[v] = 0;
-        for (int u : g.neighbors(v)) {
-            if (u == p) continue;
-            if (visited.count(u)) {
-                if (depth[u] < depth[v]) { 
-                    uint64_t weight = rng();
-                    if (weight == 0) weight = 1; 
-                    xor_sum[v] ^= weight;
-                    xor_sum[u] ^= weight;
-                }
-            } else {
-                dfsRandomBridges(g, u, v, d + 1, visited, depth, xor_sum, bridges, rng);
-                xor_sum[v] ^= xor_sum[u]; 
-                if (xor_sum[u] == 0) bridges++;
-            }
-        }
-    }
-};
\ No newline at end of file
+#pragma once
+#include "Graph.hpp"
+#include "Cores.hpp"
+#include "Betweenness.hpp"
+#include "EdgeCuts.hpp"
+#include "Traversal.hpp"
+#include "ShortestPaths.hpp"
+#include "Cycles.hpp"
+#include "Communities.hpp"
+#include "TriangleEstimation.hpp"
+#include "Motifs.hpp"
+#include "Coloring.hpp"
+#include "Connectivity.hpp"
+#include "Spectral.hpp"
+#include "Algebra.hpp"
+#include "Scheduler.hpp"
+#include <queue>
+#include <iostream>
+#include <random>
+#include <cstdint>
+
+// Graph families that know their metrics in closed form (ImplicitGraphs.hpp)
+// declare a ClosedForm type; GraphMetrics then skips the general algorithm.
+template <class G, class = void>
+struct HasClosedForm : std::false_type {};
+template <class G>
+struct HasClosedForm<G, std::void_t<typename G::ClosedForm>> : std::true_type {};
+
+// Every metric accepts any graph type exposing Vertex, getVertices(), neighbors(),
+// hasEdge(), vertexCount() and edgeCount() - Graph, Graph32, Graph64, ...
+class GraphMetrics {
+public:
+    template <class G>
+    static double Density(const G& g) {
+        double n = g.vertexCount();
+        if (n < 2) return 0;
+        return (2.0 * g.edgeCount()) / (n * (n - 1));
+    }
+
+    // Component and bipartiteness checks run as OR-AND BFS products on
+    // a CSR copy (GraphAlgebra).
+    template <class G>
+    static size_t ConnectedComponents(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.components();
+        return GraphAlgebra::ComponentCount(CompactOf<G>::fromGraph(g));
+    }
+
+    template <class G>
+    static bool IsBipartite(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.bipartite();
+        return GraphAlgebra::IsBipartite(CompactOf<G>::fromGraph(g));
+    }
+
+    template <class G>
+    static size_t GreedyColoring(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.colors();
+        std::map<typename G::Vertex, size_t> result;
+        size_t max_color = 0;
+        for (auto v : g.getVertices()) {
+            std::set<size_t> used;
+            for (auto n : g.neighbors(v)) if (result.count(n)) used.insert(result[n]);
+            size_t clr = 0;
+            while (used.count(clr)) clr++;
+            result[v] = clr;
+            max_color = std::max(max_color, clr);
+        }
+        return max_color + 1;
+    }
+
+    // Edge connectivity lambda(G): fewest edges whose removal disconnects the graph.
+    template <class G>
+    static size_t EdgeConnectivity(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.edgeConnectivity();
+        return Connectivity::EdgeConnectivity(CompactOf<G>::fromGraph(g));
+    }
+
+    // Vertex connectivity kappa(G): fewest vertices whose removal disconnects the graph.
+    template <class G>
+    static size_t VertexConnectivity(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.vertexConnectivity();
+        return Connectivity::VertexConnectivity(CompactOf<G>::fromGraph(g));
+    }
+
+    // Largest adjacency eigenvalue, by Lanczos on a CSR copy; NaN if Lanczos
+    // did not converge.
+    template <class G>
+    static double SpectralRadius(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.spectralRadius();
+        EigenPair radius = Spectral::SpectralRadius(CompactOf<G>::fromGraph(g));
+        return radius.converged ? radius.value : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // Second-smallest Laplacian eigenvalue (Fiedler value); 0 iff disconnected,
+    // NaN if Lanczos did not converge.
+    template <class G>
+    static double AlgebraicConnectivity(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.algebraicConnectivity();
+        return Spectral::AlgebraicConnectivity(CompactOf<G>::fromGraph(g));
+    }
+
+    // Size of a maximum clique, a lower bound on the chromatic number.
+    template <class G>
+    static size_t CliqueNumber(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.clique();
+        return MaxClique::Size(CompactOf<G>::fromGraph(g));
+    }
+
+    // Exact chromatic number; on graphs too hard for the default search budget
+    // this is the best colouring found (VertexColoring::Exact reports which).
+    template <class G>
+    static size_t ChromaticNumber(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.colors();
+        return VertexColoring::Exact(CompactOf<G>::fromGraph(g)).colors;
+    }
+
+    // All-sources BFS on a CSR copy, sources split over the scheduler.
+    template <class G>
+    static size_t Diameter(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.diameter();
+        using C = CompactOf<G>;
+        C c = C::fromGraph(g);
+        return TaskScheduler::instance().parallelReduce(0, c.vertexCount(), size_t(0),
+            [&c](size_t lo, size_t hi) {
+                BreadthFirstSearch<C> bfs(c);
+                size_t best = 0;
+                for (size_t s = lo; s < hi; ++s) best = std::max<size_t>(best, bfs.run((typename C::Index)s));
+                return best;
+            },
+            [](size_t a, size_t b) { return std::max(a, b); });
+    }
+
+    // Weighted counterparts of Diameter: longest finite shortest path by edge
+    // weight (every edge weighs 1 on unweighted graphs).
+    template <class G>
+    static double WeightedDiameter(const G& g) {
+        return ShortestPaths::Diameter(CompactOf<G>::fromGraph(g));
+    }
+
+    template <class G>
+    static double WeightedEccentricity(const G& g, typename G::Vertex v) {
+        auto c = CompactOf<G>::fromGraph(g);
+        return ShortestPaths::Eccentricity(c, c.index(v));
+    }
+
+    template <class G>
+    static double Transitivity(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.transitivity();
+        using V = typename G::Vertex;
+        long long triads = 0, triangles = 0;
+        auto vertices = g.getVertices();
+        for (V v : vertices) {
+            long long d = g.neighbors(v).size();
+            triads += d * (d - 1) / 2;
+        }
+        if (triads == 0) return 0.0;
+        for (V u : vertices) {
+            for (V v : g.neighbors(u)) {
+                if (u < v) {
+                    for (V w : g.neighbors(v)) {
+                        if (v < w && g.hasEdge(u, w)) triangles++;
+                    }
+                }
+            }
+        }
+        return (3.0 * triangles) / triads;
+    }
+
+    template <class G>
+    static size_t CountArticulationPoints(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.articulationPoints();
+        using V = typename G::Vertex;
+        size_t timer = 0;
+        std::map<V, size_t> tin, low;
+        std::set<V> visited, aps;
+        for (auto v : g.getVertices()) {
+            if (visited.find(v) == visited.end()) {
+                dfsAPs(g, v, G::kNoVertex, timer, visited, tin, low, aps);
+            }
+        }
+        return aps.size();
+    }
+
+    template <class G>
+    static size_t CountBridgesRandomized(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.bridges();
+        return FindBridgesRandomized(g).size();
+    }
+
+    template <class G, class V = typename G::Vertex>
+    static std::vector<std::pair<V, V>> FindBridgesRandomized(const G& g) {
+        std::map<V, uint64_t> xor_sum;
+        std::set<V> visited;
+        std::map<V, size_t> depth;
+        std::vector<std::pair<V, V>> bridges;
+        std::mt19937_64 rng(std::random_device{}());
+        for (V root : g.getVertices()) {
+            if (visited.find(root) == visited.end()) {
+                dfsRandomBridges(g, root, G::kNoVertex, 0, visited, depth, xor_sum, bridges, rng);
+            }
+        }
+        return bridges;
+    }
+
+    template <class G>
+    static size_t Count2EdgeCuts(const G& g) {
+        return EdgeCutAnalyzer::Analyze(CompactOf<G>::fromGraph(g)).twoEdgeCuts;
+    }
+
+    template <class G>
+    static size_t Count3EdgeConnectedClasses(const G& g) {
+        return EdgeCutAnalyzer::Analyze(CompactOf<G>::fromGraph(g)).threeEdgeClassCount;
+    }
+
+    template <class V>
+    struct BridgeInfo {
+        V u, v;
+        double betweenness; // shortest paths crossing the bridge = |side(u)| * |side(v)|
+    };
+
+    // Bridges found by the XOR method, ranked by edge betweenness (most critical first).
+    template <class G, class V = typename G::Vertex>
+    static std::vector<BridgeInfo<V>> RankBridges(const G& g, unsigned threads = 0) {
+        auto bridges = FindBridgesRandomized(g);
+        std::vector<BridgeInfo<V>> res;
+        if (bridges.empty()) return res;
+        auto c = CompactOf<G>::fromGraph(g);
+        BetweennessResult bc = Betweenness::Exact(c, threads);
+        for (auto [u, v] : bridges) res.push_back({u, v, bc.edgeValue(c, c.index(u), c.index(v))});
+        std::sort(res.begin(), res.end(), [](const BridgeInfo<V>& a, const BridgeInfo<V>& b) {
+            return a.betweenness > b.betweenness;
+        });
+        return res;
+    }
+
+    template <class G>
+    static size_t Degeneracy(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.degeneracy();
+        return KCore::Decompose(CompactOf<G>::fromGraph(g)).degeneracy;
+    }
+
+    // Length of the shortest cycle, 0 for forests.
+    template <class G>
+    static size_t Girth(const G& g) {
+        if constexpr (HasClosedForm<G>::value) return g.girth();
+        return Cycles::Girth(CompactOf<G>::fromGraph(g));
+    }
+
+    // Mean local clustering coefficient; vertices of degree < 2 count as 0.
+    template <class G>
+    static double AverageClustering(const G& g) {
+        return TriangleEstimation::Exact(CompactOf<G>::fromGraph(g)).averageClustering.value;
+    }
+
+    // Number of k-vertex cliques (Motifs has the full profile and 4-vertex graphlets).
+    template <class G>
+    static uint64_t CountCliques(const G& g, unsigned k) {
+        return Motifs::CountCliques(CompactOf<G>::fromGraph(g), k);
+    }
+
+    // Modularity of the Leiden partition (CommunityDetection has the labels).
+    template <class G>
+    static double Modularity(const G& g) {
+        return CommunityDetection::Leiden(CompactOf<G>::fromGraph(g)).modularity;
+    }
+
+    // Cyclomatic number m - n + c, the size of every cycle basis.
+    template <class G>
+    static size_t CycleRank(const G& g) {
+        return g.edgeCount() - g.vertexCount() + ConnectedComponents(g);
+    }
+
+private:
+    template <class G, class V = typename G::Vertex>
+    static void dfsAPs(const G& g, V v, V p, size_t& timer, std::set<V>& visited, 
+                       std::map<V, size_t>& tin, std::map<V, size_t>& low, std::set<V>& aps) {
+        visited.insert(v);
+        tin[v] = low[v] = timer++;
+        int children = 0;
+        for (V to : g.neighbors(v)) {
+            if (to == p) continue;
+            if (visited.count(to)) {
+                low[v] = std::min(low[v], tin[to]);
+            } else {
+                dfsAPs(g, to, v, timer, visited, tin, low, aps);
+                low[v] = std::min(low[v], low[to]);
+                if (low[to] >= tin[v] && p != G::kNoVertex) aps.insert(v);
+                children++;
+            }
+        }
+        if (p == G::kNoVertex && children > 1) aps.insert(v);
+    }
+
+    template <class G, class V = typename G::Vertex>
+    static void dfsRandomBridges(const G& g, V v, V p, size_t d, std::set<V>& visited, 
+                                 std::map<V, size_t>& depth, std::map<V, uint64_t>& xor_sum, 
+                                 std::vector<std::pair<V, V>>& bridges, std::mt19937_64& rng) {
+        visited.insert(v);
+        depth[v] = d;
+        xor_sum[v] = 0;
+        for (V u : g.neighbors(v)) {
+            if (u == p) continue;
+            if (visited.count(u)) {
+                if (depth[u] < depth[v]) { 
+                    uint64_t weight = rng();
+                    if (weight == 0) weight = 1; 
+                    xor_sum[v] ^= weight;
+                    xor_sum[u] ^= weight;
+                }
+            } else {
+                dfsRandomBridges(g, u, v, d + 1, visited, depth, xor_sum, bridges, rng);
+                xor_sum[v] ^= xor_sum[u]; 
+                if (xor_sum[u] == 0) bridges.push_back({v, u});
+            }
+        }
+    }
+};
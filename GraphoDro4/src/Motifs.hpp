@@ -0,0 +1,220 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Cores.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <mutex>
+
+// Induced counts of the connected 3- and 4-vertex graphlets.
+struct GraphletCounts {
+    uint64_t wedges = 0, triangles = 0; // 3 vertices: open wedge (path), triangle
+    uint64_t stars = 0, paths = 0, tailedTriangles = 0, cycles = 0, diamonds = 0, cliques = 0;
+};
+
+// Subgraph counting on the degeneracy-ordered orientation of a CompactGraph:
+// every edge points to the vertex peeled later, so out-degrees are bounded by
+// the degeneracy d and every clique is found exactly once from its earliest
+// vertex. Work is split over root vertices on the scheduler.
+class Motifs {
+public:
+    // counts[k] = number of k-cliques for k = 0..maxK (counts[1] = n, counts[2] = m).
+    // Around each root the out-neighbourhood (at most d vertices) gets bitset
+    // adjacency and cliques grow by intersecting candidate bitsets (kClist).
+    template <class C>
+    static std::vector<uint64_t> CliqueProfile(const C& g, unsigned maxK, unsigned threads = 0) {
+        return cliques(g, orient(g), maxK, false, threads);
+    }
+
+    template <class C>
+    static uint64_t CountCliques(const C& g, unsigned k, unsigned threads = 0) {
+        return cliques(g, orient(g), k, true, threads)[k];
+    }
+
+    // All connected 4-vertex graphlets from a few non-induced counts: stars from
+    // degrees, paths from edge degrees, tailed triangles and diamonds from the
+    // per-vertex and per-edge triangle counts, 4-cycles by Chiba-Nishizeki wedge
+    // counting and 4-cliques from CountCliques; induced counts then follow by
+    // inclusion-exclusion. O(m d) overall.
+    template <class C>
+    static GraphletCounts Graphlets(const C& g, unsigned threads = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        Dag<Index> dag = orient(g);
+        std::vector<std::atomic<uint64_t>> edgeTriangles(dag.out.size()), vertexTriangles(n);
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; ++u)
+                for (size_t i = dag.start[u]; i < dag.start[u + 1]; ++i) {
+                    Index v = dag.out[i];
+                    size_t a = dag.start[u], aEnd = dag.start[u + 1], b = dag.start[v], bEnd = dag.start[v + 1];
+                    while (a < aEnd && b < bEnd) {
+                        if (dag.out[a] < dag.out[b]) ++a;
+                        else if (dag.out[a] > dag.out[b]) ++b;
+                        else {
+                            for (size_t e : {i, a, b}) edgeTriangles[e].fetch_add(1, std::memory_order_relaxed);
+                            for (Index x : {(Index)u, v, dag.out[a]}) vertexTriangles[x].fetch_add(1, std::memory_order_relaxed);
+                            ++a; ++b;
+                        }
+                    }
+                }
+        }, threads);
+
+        uint64_t triangles = 0, wedges = 0, stars = 0, paths = 0, tailed = 0, diamonds = 0;
+        for (Index v = 0; v < n; ++v) {
+            uint64_t d = simpleDegree(g, v), t = vertexTriangles[v].load(std::memory_order_relaxed);
+            triangles += t;
+            wedges += choose(d, 2);
+            stars += choose(d, 3);
+            if (d >= 2) tailed += t * (d - 2);
+            for (size_t i = dag.start[v]; i < dag.start[v + 1]; ++i) {
+                uint64_t du = simpleDegree(g, dag.out[i]);
+                paths += (d - 1) * (du - 1);
+                diamonds += choose(edgeTriangles[i].load(std::memory_order_relaxed), 2);
+            }
+        }
+        triangles /= 3;
+        paths -= 3 * triangles;
+
+        GraphletCounts res;
+        res.triangles = triangles;
+        res.wedges = wedges - 3 * triangles;
+        res.cliques = cliques(g, dag, 4, true, threads)[4];
+        res.diamonds = diamonds - 6 * res.cliques;
+        res.cycles = fourCycles(g, threads) - res.diamonds - 3 * res.cliques;
+        res.tailedTriangles = tailed - 4 * res.diamonds - 12 * res.cliques;
+        res.stars = stars - res.tailedTriangles - 2 * res.diamonds - 4 * res.cliques;
+        res.paths = paths - 2 * res.tailedTriangles - 4 * res.cycles - 6 * res.diamonds - 12 * res.cliques;
+        return res;
+    }
+
+private:
+    template <class Index>
+    struct Dag {
+        std::vector<size_t> start;
+        std::vector<Index> out; // sorted by index within each row
+        size_t width = 0; // largest out-degree, at most the degeneracy
+    };
+
+    // Degree without a self-loop; loops take part in no graphlet.
+    template <class C>
+    static uint64_t simpleDegree(const C& g, typename C::Index v) {
+        auto row = g.neighbors(v);
+        return g.degree(v) - std::binary_search(row.begin(), row.end(), v);
+    }
+
+    static uint64_t choose(uint64_t n, unsigned k) {
+        if (n < k) return 0;
+        uint64_t r = 1;
+        for (unsigned i = 1; i <= k; ++i) r = r * (n - k + i) / i;
+        return r;
+    }
+
+    template <class C>
+    static Dag<typename C::Index> orient(const C& g) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        auto cores = KCore::Decompose(g);
+        std::vector<Index> rank(n);
+        for (Index i = 0; i < n; ++i) rank[cores.order[i]] = i;
+        Dag<Index> dag;
+        dag.start.assign(n + 1, 0);
+        for (Index v = 0; v < n; ++v) {
+            dag.start[v + 1] = dag.start[v];
+            for (Index u : g.neighbors(v)) if (rank[u] > rank[v]) dag.start[v + 1]++;
+            dag.width = std::max(dag.width, dag.start[v + 1] - dag.start[v]);
+        }
+        dag.out.resize(dag.start[n]);
+        for (Index v = 0; v < n; ++v) {
+            size_t pos = dag.start[v];
+            for (Index u : g.neighbors(v)) if (rank[u] > rank[v]) dag.out[pos++] = u;
+        }
+        return dag;
+    }
+
+    template <class C>
+    static std::vector<uint64_t> cliques(const C& g, const Dag<typename C::Index>& dag, unsigned maxK, bool onlyMax,
+                                         unsigned threads) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<uint64_t> total(maxK + 1, 0);
+        total[0] = 1;
+        if (maxK >= 1) total[1] = n;
+        if (maxK < 2 || n == 0) return total;
+        size_t words = (dag.width + 63) / 64;
+        std::mutex merge;
+
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            std::vector<uint64_t> counts(maxK + 1, 0);
+            std::vector<uint64_t> adj, levels((maxK + 1) * words);
+            std::vector<Index> local(n, C::kNone);
+            // Cliques extending a clique of `size` vertices by members of `cand` (level `size`).
+            auto expand = [&](auto&& self, unsigned size) -> void {
+                const uint64_t* cand = &levels[size * words];
+                size_t c = 0;
+                for (size_t w = 0; w < words; ++w) c += __builtin_popcountll(cand[w]);
+                if (c == 0) return;
+                counts[size + 1] += c;
+                if (size + 1 == maxK || (onlyMax && size + c < maxK)) return;
+                uint64_t* next = &levels[(size + 1) * words];
+                for (size_t w = 0; w < words; ++w)
+                    for (uint64_t bits = cand[w]; bits; bits &= bits - 1) {
+                        const uint64_t* row = &adj[(w * 64 + __builtin_ctzll(bits)) * words];
+                        for (size_t x = 0; x < words; ++x) next[x] = cand[x] & row[x];
+                        self(self, size + 1);
+                    }
+            };
+            for (size_t root = lo; root < hi; ++root) {
+                size_t first = dag.start[root], s = dag.start[root + 1] - first;
+                if (s == 0) continue;
+                for (size_t i = 0; i < s; ++i) local[dag.out[first + i]] = (Index)i;
+                adj.assign(s * words, 0);
+                for (size_t i = 0; i < s; ++i) {
+                    Index a = dag.out[first + i];
+                    for (size_t j = dag.start[a]; j < dag.start[a + 1]; ++j)
+                        if (local[dag.out[j]] != C::kNone) {
+                            Index b = local[dag.out[j]];
+                            adj[i * words + b / 64] |= uint64_t(1) << (b % 64);
+                        }
+                }
+                uint64_t* cand = &levels[words];
+                std::fill(cand, cand + words, 0);
+                for (size_t i = 0; i < s; ++i) cand[i / 64] |= uint64_t(1) << (i % 64);
+                expand(expand, 1);
+                for (size_t i = 0; i < s; ++i) local[dag.out[first + i]] = C::kNone;
+            }
+            std::lock_guard<std::mutex> lock(merge);
+            for (unsigned k = 2; k <= maxK; ++k) total[k] += counts[k];
+        }, threads);
+        return total;
+    }
+
+    // Non-induced 4-cycles (Chiba, Nishizeki 1985): from every vertex u, count the
+    // paths u - v - w through lower-ranked v and w (rank = degree, then index);
+    // each pair of such paths to the same w closes one cycle whose top vertex is u.
+    template <class C>
+    static uint64_t fourCycles(const C& g, unsigned threads) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        auto lower = [&g](Index a, Index b) {
+            return g.degree(a) != g.degree(b) ? g.degree(a) < g.degree(b) : a < b;
+        };
+        std::atomic<uint64_t> cycles{0};
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            std::vector<uint32_t> paths(n, 0);
+            std::vector<Index> touched;
+            uint64_t local = 0;
+            for (size_t u = lo; u < hi; ++u) {
+                for (Index v : g.neighbors(u)) {
+                    if (v == u || !lower(v, (Index)u)) continue;
+                    for (Index w : g.neighbors(v)) {
+                        if (w == u || w == v || !lower(w, (Index)u)) continue;
+                        if (paths[w]++ == 0) touched.push_back(w);
+                    }
+                }
+                for (Index w : touched) { local += choose(paths[w], 2); paths[w] = 0; }
+                touched.clear();
+            }
+            cycles.fetch_add(local, std::memory_order_relaxed);
+        }, threads);
+        return cycles.load();
+    }
+};
@@ -0,0 +1,223 @@
+#pragma once
+#include "Streaming.hpp"
+#include <filesystem>
+#include <memory>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <random>
+#include <stdexcept>
+
+// Semi-external graph for edge sets larger than RAM. Directed copies of every edge
+// are partitioned into on-disk shards by source-vertex interval (GraphChi/X-Stream
+// style); algorithms keep O(V) vertex state in memory and read shards
+// sequentially. Vertex ids must be non-negative and below 2^32; they index the
+// vertex arrays directly, so ids should be reasonably dense.
+class ShardedGraph {
+public:
+    using Vertex = uint32_t;
+    static constexpr uint32_t kUnreached = UINT32_MAX;
+
+    struct Options {
+        std::string directory;             // empty = fresh temporary directory, removed on destruction
+        uint64_t verticesPerShard = 1 << 22;
+        size_t memoryBudget = 256u << 20;  // bytes for write buffers and read blocks
+    };
+
+    ShardedGraph(ShardedGraph&& other) noexcept { *this = std::move(other); }
+    ShardedGraph& operator=(ShardedGraph&& other) noexcept {
+        std::swap(dir, other.dir); std::swap(owned, other.owned);
+        std::swap(interval, other.interval); std::swap(budget, other.budget);
+        std::swap(shardEdges, other.shardEdges); std::swap(maxId, other.maxId);
+        std::swap(edges, other.edges);
+        return *this;
+    }
+    ~ShardedGraph() {
+        std::error_code ec;
+        if (owned && !dir.empty()) std::filesystem::remove_all(dir, ec);
+    }
+
+    // One pass over an edge-list file (or "-" for stdin); self-loops are dropped.
+    static ShardedGraph Build(const std::string& edgeFile) { return Build(edgeFile, Options()); }
+
+    static ShardedGraph Build(const std::string& edgeFile, const Options& options) {
+        EdgeStreamReader reader(edgeFile);
+        ShardedGraph g(options);
+        for (const auto& entry : std::filesystem::directory_iterator(g.dir))
+            if (entry.path().filename().string().rfind("shard_", 0) == 0) std::filesystem::remove(entry.path());
+        ShardWriter writer(g);
+        long long u, v;
+        while (reader.next(u, v)) {
+            if (u < 0 || v < 0 || u > UINT32_MAX - 1 || v > UINT32_MAX - 1)
+                throw std::runtime_error("out-of-core ids must be in [0, 2^32 - 1)");
+            if (u == v) continue;
+            writer.add((Vertex)u, (Vertex)v);
+            writer.add((Vertex)v, (Vertex)u);
+            g.edges++;
+        }
+        writer.flush();
+        g.saveMeta();
+        return g;
+    }
+
+    // Reopens shards written earlier by Build with an explicit directory.
+    static ShardedGraph Open(const std::string& directory, size_t memoryBudget = 256u << 20) {
+        Options options;
+        options.directory = directory;
+        options.memoryBudget = memoryBudget;
+        ShardedGraph g(options);
+        std::ifstream meta(g.dir / "meta.txt");
+        size_t shards;
+        if (!(meta >> g.interval >> g.maxId >> g.edges >> shards)) throw std::runtime_error("no shard metadata in " + directory);
+        g.shardEdges.resize(shards);
+        for (auto& c : g.shardEdges) meta >> c;
+        return g;
+    }
+
+    size_t idSpace() const { return edges ? (size_t)maxId + 1 : 0; }
+    uint64_t edgeCount() const { return edges; }
+    size_t shardCount() const { return shardEdges.size(); }
+    const std::filesystem::path& directory() const { return dir; }
+
+    // Streams the directed edges of one shard: fn(src, dst).
+    template <class F>
+    void forEachEdge(size_t shard, F&& fn) const {
+        if (shard >= shardEdges.size() || shardEdges[shard] == 0) return;
+        std::FILE* f = std::fopen(shardPath(shard).c_str(), "rb");
+        if (!f) throw std::runtime_error("cannot open shard " + shardPath(shard));
+        // Sequential reads in blocks of at most 8 MiB; larger blocks do not read any faster.
+        size_t words = std::min<size_t>(budget / 2, 8u << 20) / sizeof(Vertex) & ~size_t(1);
+        std::unique_ptr<Vertex[]> block(new Vertex[words]);
+        size_t got;
+        while ((got = std::fread(block.get(), sizeof(Vertex), words, f)) > 0)
+            for (size_t i = 0; i + 1 < got; i += 2) fn(block[i], block[i + 1]);
+        std::fclose(f);
+    }
+
+    template <class F>
+    void forEachEdge(F&& fn) const {
+        for (size_t s = 0; s < shardEdges.size(); ++s) forEachEdge(s, fn);
+    }
+
+    std::vector<uint32_t> Degrees() const {
+        std::vector<uint32_t> deg(idSpace(), 0);
+        forEachEdge([&](Vertex u, Vertex) { deg[u]++; });
+        return deg;
+    }
+
+    // Level-synchronous BFS; only shards whose interval holds frontier vertices are read.
+    std::vector<uint32_t> BFS(Vertex source) const {
+        std::vector<uint32_t> level(idSpace(), kUnreached);
+        if (source >= level.size()) return level;
+        level[source] = 0;
+        std::vector<char> active(shardEdges.size(), 0), next(shardEdges.size(), 0);
+        active[source / interval] = 1;
+        for (uint32_t depth = 0;; ++depth) {
+            bool any = false;
+            std::fill(next.begin(), next.end(), 0);
+            for (size_t s = 0; s < shardEdges.size(); ++s) {
+                if (!active[s]) continue;
+                forEachEdge(s, [&](Vertex u, Vertex v) {
+                    if (level[u] == depth && level[v] == kUnreached) {
+                        level[v] = depth + 1;
+                        next[v / interval] = 1;
+                        any = true;
+                    }
+                });
+            }
+            if (!any) break;
+            active.swap(next);
+        }
+        return level;
+    }
+
+    // Union-find over a single sequential pass; returns the root label of every id
+    // and stores the number of components among ids with at least one edge.
+    std::vector<uint32_t> ConnectedComponents(size_t* count = nullptr) const {
+        std::vector<uint32_t> parent(idSpace());
+        for (size_t i = 0; i < parent.size(); ++i) parent[i] = i;
+        auto find = [&](uint32_t x) {
+            while (parent[x] != x) { parent[x] = parent[parent[x]]; x = parent[x]; }
+            return x;
+        };
+        std::vector<char> seen(idSpace(), 0);
+        forEachEdge([&](Vertex u, Vertex v) {
+            seen[u] = 1;
+            if (u > v) return;
+            uint32_t a = find(u), b = find(v);
+            if (a != b) parent[std::max(a, b)] = std::min(a, b);
+        });
+        size_t components = 0;
+        for (size_t i = 0; i < parent.size(); ++i) {
+            parent[i] = find(i);
+            if (seen[i] && parent[i] == i) components++;
+        }
+        if (count) *count = components;
+        return parent;
+    }
+
+private:
+    explicit ShardedGraph(const Options& options)
+        : interval(std::max<uint64_t>(1, options.verticesPerShard)), budget(std::max<size_t>(options.memoryBudget, 1 << 16)) {
+        if (options.directory.empty()) {
+            std::mt19937_64 rng(std::random_device{}());
+            dir = std::filesystem::temp_directory_path() / ("graphodro4_shards_" + std::to_string(rng()));
+            owned = true;
+        } else {
+            dir = options.directory;
+        }
+        std::filesystem::create_directories(dir);
+    }
+
+    // Buffers directed edges per shard and appends them to disk whenever the
+    // buffered total would exceed the memory budget.
+    class ShardWriter {
+    public:
+        explicit ShardWriter(ShardedGraph& g) : g(g), limit(g.budget / sizeof(Vertex) / 2) {}
+        void add(Vertex u, Vertex v) {
+            size_t s = u / g.interval;
+            if (s >= buffers.size()) {
+                buffers.resize(s + 1);
+                g.shardEdges.resize(s + 1, 0);
+            }
+            buffers[s].push_back(u);
+            buffers[s].push_back(v);
+            g.shardEdges[s]++;
+            g.maxId = std::max(g.maxId, std::max(u, v));
+            if (++buffered >= limit) flush();
+        }
+        void flush() {
+            for (size_t s = 0; s < buffers.size(); ++s) {
+                if (buffers[s].empty()) continue;
+                std::FILE* f = std::fopen(g.shardPath(s).c_str(), "ab");
+                if (!f || std::fwrite(buffers[s].data(), sizeof(Vertex), buffers[s].size(), f) != buffers[s].size())
+                    throw std::runtime_error("cannot write shard " + g.shardPath(s));
+                std::fclose(f);
+                std::vector<Vertex>().swap(buffers[s]);
+            }
+            buffered = 0;
+        }
+    private:
+        ShardedGraph& g;
+        size_t limit, buffered = 0;
+        std::vector<std::vector<Vertex>> buffers;
+    };
+
+    std::string shardPath(size_t s) const { return (dir / ("shard_" + std::to_string(s) + ".bin")).string(); }
+
+    void saveMeta() const {
+        std::ofstream meta(dir / "meta.txt");
+        meta << interval << " " << maxId << " " << edges << " " << shardEdges.size() << "\n";
+        for (auto c : shardEdges) meta << c << "\n";
+    }
+
+    std::filesystem::path dir;
+    bool owned = false;
+    uint64_t interval = 1;
+    size_t budget = 0;
+    std::vector<uint64_t> shardEdges; // directed edges per shard
+    Vertex maxId = 0;
+    uint64_t edges = 0;
+};
@@ -0,0 +1,217 @@
+#pragma once
+#include "Algebra.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct PageRankOptions {
+    double damping = 0.85;
+    double tolerance = 1e-10;   // stop once the L1 change of a sweep is below this
+    size_t maxIterations = 100;
+    bool gaussSeidel = false;   // in-place sweeps on one thread
+};
+
+struct PageRankResult {
+    std::vector<double> score;  // per compact index
+    size_t iterations = 0;      // sweeps, or pushes for Personalized
+    double residual = 0.0;      // last L1 change, or rank mass left unpushed
+    bool converged = false;
+};
+
+// PageRank over a CompactGraph: every vertex splits its rank over its edges in
+// proportion to their weights, dangling vertices hand theirs to the teleport
+// distribution (uniform, or the source for personalized rank).
+class PageRank {
+public:
+    // Power iteration, one GraphAlgebra PLUS-TIMES pull per sweep.
+    // With options.gaussSeidel each sweep updates scores in place on one
+    // thread; that takes fewer sweeps, about half on slowly mixing graphs
+    // (long paths, bridges, stars).
+    template <class C>
+    static PageRankResult Compute(const C& g, const PageRankOptions& options = {}, unsigned threads = 0) {
+        size_t n = g.vertexCount();
+        return iterate(g, std::vector<double>(n, n ? 1.0 / n : 0.0), options, threads);
+    }
+
+    // Personalized PageRank of `source` by the same iteration with all
+    // teleports going to the source; the reference for Personalized.
+    template <class C>
+    static PageRankResult PersonalizedExact(const C& g, typename C::Index source, const PageRankOptions& options = {},
+                                            unsigned threads = 0) {
+        std::vector<double> teleport(g.vertexCount(), 0.0);
+        teleport[source] = 1.0;
+        return iterate(g, teleport, options, threads);
+    }
+
+    // Personalized PageRank of `source` by forward push (Andersen, Chung and
+    // Lang): residual mass r(v) is settled at v as (1 - damping) r(v) and the
+    // rest pushed to the neighbours while r(v) > epsilon * degree(v). Work is
+    // O(1 / (epsilon (1 - damping))) independent of the graph size, and each
+    // score is below the exact one by at most the mass left unpushed.
+    template <class C>
+    static PageRankResult Personalized(const C& g, typename C::Index source, double epsilon = 1e-7,
+                                       double damping = 0.85) {
+        using Index = typename C::Index;
+        size_t n = g.vertexCount();
+        PageRankResult res;
+        res.score.assign(n, 0.0);
+        std::vector<double> residual(n, 0.0), out = weightedDegrees(g);
+        std::vector<char> queued(n, 0);
+        std::vector<Index> queue{source};
+        residual[source] = 1.0;
+        queued[source] = 1;
+        auto active = [&](Index v) { return residual[v] > epsilon * std::max<size_t>(1, g.degree(v)); };
+        for (size_t head = 0; head < queue.size(); ++head) {
+            Index u = queue[head];
+            queued[u] = 0;
+            double r = residual[u];
+            residual[u] = 0.0;
+            res.score[u] += (1.0 - damping) * r;
+            res.iterations++;
+            if (out[u] <= 0) {
+                residual[source] += damping * r;
+                if (!queued[source] && active(source)) { queued[source] = 1; queue.push_back(source); }
+                continue;
+            }
+            double share = damping * r / out[u];
+            for (auto slot = g.offsets[u]; slot < g.offsets[u + 1]; ++slot) {
+                Index v = g.targets[slot];
+                residual[v] += share * g.weight(slot);
+                if (!queued[v] && active(v)) { queued[v] = 1; queue.push_back(v); }
+            }
+        }
+        for (double r : residual) res.residual += r;
+        res.converged = true;
+        return res;
+    }
+
+    // The k highest scores as (index, score), best first, ties by index.
+    static std::vector<std::pair<size_t, double>> TopK(const std::vector<double>& score, size_t k) {
+        std::vector<size_t> order(score.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        k = std::min(k, order.size());
+        std::partial_sort(order.begin(), order.begin() + k, order.end(), [&score](size_t a, size_t b) {
+            return score[a] != score[b] ? score[a] > score[b] : a < b;
+        });
+        std::vector<std::pair<size_t, double>> top;
+        for (size_t i = 0; i < k; ++i) top.push_back({order[i], score[order[i]]});
+        return top;
+    }
+
+    // Binary layout: magic, vertex id width, n, ids, scores (doubles), all in
+    // native byte order.
+    template <class C>
+    static void Save(const std::string& path, const C& g, const std::vector<double>& score) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) throw std::runtime_error("cannot write " + path);
+        uint32_t width = sizeof(typename C::Vertex);
+        uint64_t n = g.vertexCount();
+        out.write(kMagic, sizeof(kMagic));
+        out.write((const char*)&width, sizeof(width));
+        out.write((const char*)&n, sizeof(n));
+        out.write((const char*)g.ids.data(), n * sizeof(typename C::Vertex));
+        out.write((const char*)score.data(), n * sizeof(double));
+        if (!out) throw std::runtime_error("failed writing " + path);
+    }
+
+    template <class V = Graph::Vertex>
+    static std::vector<std::pair<V, double>> Load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        char magic[sizeof(kMagic)];
+        uint32_t width;
+        uint64_t n;
+        in.read(magic, sizeof(magic));
+        in.read((char*)&width, sizeof(width));
+        in.read((char*)&n, sizeof(n));
+        if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) throw std::runtime_error(path + " is not a PageRank score file");
+        if (width != sizeof(V)) throw std::runtime_error(path + ": vertex id width mismatch");
+        // Check the count against the bytes left before allocating for it.
+        auto start = in.tellg();
+        in.seekg(0, std::ios::end);
+        uint64_t left = (uint64_t)(in.tellg() - start);
+        in.seekg(start);
+        if (n > left / (sizeof(V) + sizeof(double))) throw std::runtime_error(path + ": truncated score file");
+        std::vector<V> ids(n);
+        std::vector<double> score(n);
+        in.read((char*)ids.data(), n * sizeof(V));
+        in.read((char*)score.data(), n * sizeof(double));
+        if (!in) throw std::runtime_error(path + ": truncated score file");
+        std::vector<std::pair<V, double>> res(n);
+        for (uint64_t i = 0; i < n; ++i) res[i] = {ids[i], score[i]};
+        return res;
+    }
+
+private:
+    static constexpr char kMagic[8] = {'G', 'D', '4', 'P', 'R', 'N', '0', '1'};
+
+    template <class C>
+    static std::vector<double> weightedDegrees(const C& g) {
+        std::vector<double> out(g.vertexCount(), 0.0);
+        for (size_t v = 0; v < out.size(); ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) out[v] += g.weight(slot);
+        return out;
+    }
+
+    // x' = (1 - d) t + d (A (x / out) + dangling(x) t) for the teleport vector t.
+    template <class C>
+    static PageRankResult iterate(const C& g, const std::vector<double>& teleport, const PageRankOptions& o, unsigned threads) {
+        size_t n = g.vertexCount();
+        PageRankResult res;
+        res.score = teleport;
+        if (n == 0) { res.converged = true; return res; }
+        std::vector<double> out = weightedDegrees(g), share(n), next(n);
+        std::vector<size_t> dangling;
+        for (size_t v = 0; v < n; ++v) if (out[v] <= 0) dangling.push_back(v);
+        auto gather = [&](size_t v, const std::vector<double>& from) { // Gauss-Seidel row update
+            double sum = 0.0;
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) sum += g.weight(slot) * from[g.targets[slot]];
+            return sum;
+        };
+        double& change = res.residual;
+        for (res.iterations = 1; res.iterations <= o.maxIterations; ++res.iterations) {
+            double lost = 0.0;
+            for (size_t v : dangling) lost += res.score[v];
+            if (o.gaussSeidel) {
+                // share[u] follows score[u] as it changes, so later rows see this sweep's values.
+                // In-place sweeps do not conserve rank mass, so each ends by rescaling to 1;
+                // otherwise the mass error would only shrink by `damping` per sweep.
+                next = res.score;
+                for (size_t v = 0; v < n; ++v) share[v] = out[v] > 0 ? res.score[v] / out[v] : 0.0;
+                double mass = 0.0;
+                for (size_t v = 0; v < n; ++v) {
+                    double value = (1.0 - o.damping + o.damping * lost) * teleport[v] + o.damping * gather(v, share);
+                    if (out[v] <= 0) lost += value - res.score[v];
+                    res.score[v] = value;
+                    mass += value;
+                    if (out[v] > 0) share[v] = value / out[v];
+                }
+                change = 0.0;
+                for (size_t v = 0; v < n; ++v) {
+                    res.score[v] /= mass;
+                    change += std::abs(res.score[v] - next[v]);
+                }
+            } else {
+                // One PLUS-TIMES pull per sweep spreads score / out along the rows.
+                DenseVector<double> shares(n);
+                for (size_t v = 0; v < n; ++v) if (out[v] > 0) shares.set(v, res.score[v] / out[v]);
+                DenseVector<double> spread = GraphAlgebra::Pull<PlusTimesSemiring>(g, shares, {}, threads);
+                change = 0.0;
+                for (size_t v = 0; v < n; ++v) {
+                    next[v] = (1.0 - o.damping + o.damping * lost) * teleport[v] + (spread.present[v] ? o.damping * spread.values[v] : 0.0);
+                    change += std::abs(next[v] - res.score[v]);
+                }
+                res.score.swap(next);
+            }
+            if (change < o.tolerance) { res.converged = true; break; }
+        }
+        res.iterations = std::min(res.iterations, o.maxIterations);
+        return res;
+    }
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "Scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+class Parallel {
+public:
+    static unsigned threadCount(unsigned requested = 0) {
+        return requested ? requested : TaskScheduler::instance().workerCount();
+    }
+
+    // Splits [begin, end) into `chunks` contiguous pieces and runs body(lo, hi)
+    // for each one on the shared scheduler, with at most `threads` of them in
+    // flight at once. threads = 0 uses every worker; chunks = 0 makes one chunk
+    // per thread under a cap, a few per worker otherwise.
+    template <class Body>
+    static void forRange(size_t begin, size_t end, Body&& body, unsigned threads = 0, size_t chunks = 0) {
+        if (begin >= end) return;
+        if (threads == 1) { body(begin, end); return; }
+        if (chunks == 0) chunks = threads ? threads : 4 * (size_t)threadCount();
+        size_t grain = std::max<size_t>(1, (end - begin + chunks - 1) / chunks);
+        chunks = (end - begin + grain - 1) / grain;
+        if (threads == 0 || chunks <= threads) {
+            TaskScheduler::instance().parallelFor(begin, end, body, grain);
+            return;
+        }
+        // More chunks than the cap: `threads` runners claim the chunks in order.
+        std::atomic<size_t> next{0};
+        TaskScheduler::instance().parallelFor(0, threads, [&](size_t, size_t) {
+            for (size_t c; (c = next.fetch_add(1, std::memory_order_relaxed)) < chunks;)
+                body(begin + c * grain, std::min(end, begin + (c + 1) * grain));
+        }, 1);
+    }
+};
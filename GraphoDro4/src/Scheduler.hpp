@@ -0,0 +1,327 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+class TaskScheduler;
+
+struct SchedulerTask {
+    std::function<void()> fn;
+    class TaskGroup* group;
+};
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient Work-Stealing
+// for Weak Memory Models"). The owner pushes and pops at the bottom, thieves take
+// from the top. Retired buffers are kept until the deque dies since a thief may
+// still be reading them.
+class WorkStealingDeque {
+public:
+    WorkStealingDeque() { buffer.store(allocate(64), std::memory_order_relaxed); }
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    void push(SchedulerTask* task) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        if (b - t > a->mask) a = grow(a, t, b);
+        a->slots[b & a->mask].store(task, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    SchedulerTask* pop() {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        SchedulerTask* task = a->slots[b & a->mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    SchedulerTask* steal() {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        Buffer* a = buffer.load(std::memory_order_acquire);
+        SchedulerTask* task = a->slots[t & a->mask].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return task;
+    }
+
+private:
+    struct Buffer {
+        int64_t mask;
+        std::unique_ptr<std::atomic<SchedulerTask*>[]> slots;
+    };
+
+    Buffer* allocate(int64_t capacity) {
+        retired.push_back(std::make_unique<Buffer>());
+        Buffer* a = retired.back().get();
+        a->mask = capacity - 1;
+        a->slots.reset(new std::atomic<SchedulerTask*>[capacity]);
+        return a;
+    }
+
+    Buffer* grow(Buffer* old, int64_t t, int64_t b) {
+        Buffer* a = allocate(2 * (old->mask + 1));
+        for (int64_t i = t; i < b; ++i)
+            a->slots[i & a->mask].store(old->slots[i & old->mask].load(std::memory_order_relaxed),
+                                        std::memory_order_relaxed);
+        buffer.store(a, std::memory_order_release);
+        return a;
+    }
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Buffer*> buffer{nullptr};
+    std::vector<std::unique_ptr<Buffer>> retired; // touched by the owner only
+};
+
+// Fork-join handle: tasks spawned through run() are counted, wait() executes
+// pending work (its own or stolen) until all of them finished and rethrows the
+// first exception any of them raised.
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskScheduler& scheduler) : scheduler(scheduler) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    ~TaskGroup() { if (pending.load()) waitNoThrow(); }
+
+    template <class F> void run(F&& fn);
+    void wait();
+
+private:
+    friend class TaskScheduler;
+    void waitNoThrow();
+    void finished(std::exception_ptr error) {
+        if (error) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!firstError) firstError = error;
+        }
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    TaskScheduler& scheduler;
+    std::atomic<size_t> pending{0};
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+};
+
+// Process-wide work-stealing pool. Every parallel algorithm in GraphoDro4 goes
+// through TaskScheduler::instance() instead of creating its own threads.
+class TaskScheduler {
+public:
+    struct Options {
+        unsigned workers = 0; // 0 = hardware concurrency
+        bool pinThreads = false;
+    };
+
+    static TaskScheduler& instance() {
+        static TaskScheduler scheduler;
+        return scheduler;
+    }
+
+    // Restarts the pool with new settings; must not be called while tasks are running.
+    static void configure(Options options) { instance().start(options); }
+
+    ~TaskScheduler() { stop(); }
+
+    unsigned workerCount() const { return (unsigned)workers.size(); }
+
+    // Calls body(lo, hi) on disjoint subranges of [begin, end) no longer than grain.
+    template <class Body>
+    void parallelFor(size_t begin, size_t end, Body&& body, size_t grain = 0) {
+        if (begin >= end) return;
+        if (grain == 0) grain = std::max<size_t>(1, (end - begin) / (8 * std::max(1u, workerCount())));
+        if (end - begin <= grain) { body(begin, end); return; }
+        TaskGroup group(*this);
+        split(group, begin, end, grain, body);
+        group.wait();
+    }
+
+    // map(lo, hi) -> T on every chunk, then folds the chunk results left to right.
+    template <class T, class Map, class Reduce>
+    T parallelReduce(size_t begin, size_t end, T identity, Map&& map, Reduce&& reduce, size_t grain = 0) {
+        if (begin >= end) return identity;
+        if (grain == 0) grain = std::max<size_t>(1, (end - begin) / (8 * std::max(1u, workerCount())));
+        size_t chunks = (end - begin + grain - 1) / grain;
+        std::vector<T> partial(chunks, identity);
+        parallelFor(0, chunks, [&](size_t lo, size_t hi) {
+            for (size_t c = lo; c < hi; ++c)
+                partial[c] = map(begin + c * grain, std::min(end, begin + (c + 1) * grain));
+        }, 1);
+        T result = identity;
+        for (auto& p : partial) result = reduce(result, p);
+        return result;
+    }
+
+private:
+    friend class TaskGroup;
+
+    TaskScheduler() { start({}); }
+
+    struct Worker {
+        WorkStealingDeque deque;
+        std::thread thread;
+    };
+
+    static int& currentWorker() {
+        thread_local int index = -1;
+        return index;
+    }
+    static TaskScheduler*& currentScheduler() {
+        thread_local TaskScheduler* owner = nullptr;
+        return owner;
+    }
+
+    template <class Body>
+    void split(TaskGroup& group, size_t begin, size_t end, size_t grain, Body& body) {
+        while (end - begin > grain) {
+            size_t mid = begin + (end - begin) / 2;
+            group.run([this, &group, mid, end, grain, &body] { split(group, mid, end, grain, body); });
+            end = mid;
+        }
+        body(begin, end);
+    }
+
+    void start(Options options) {
+        stop();
+        unsigned n = options.workers ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+        stopping.store(false);
+        workers.clear();
+        for (unsigned i = 0; i < n; ++i) workers.push_back(std::make_unique<Worker>());
+        for (unsigned i = 0; i < n; ++i) {
+            workers[i]->thread = std::thread([this, i] { workerLoop(i); });
+#ifdef __linux__
+            if (options.pinThreads) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(i % std::max(1u, std::thread::hardware_concurrency()), &set);
+                pthread_setaffinity_np(workers[i]->thread.native_handle(), sizeof(set), &set);
+            }
+#endif
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping.store(true);
+        }
+        wake.notify_all();
+        for (auto& w : workers) if (w->thread.joinable()) w->thread.join();
+    }
+
+    void submit(SchedulerTask* task) {
+        int self = currentWorker();
+        if (self >= 0 && currentScheduler() == this) {
+            workers[self]->deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(injectMutex);
+            injected.push_back(task);
+        }
+        queued.fetch_add(1, std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            wake.notify_one();
+        }
+    }
+
+    SchedulerTask* take() {
+        int self = currentScheduler() == this ? currentWorker() : -1;
+        SchedulerTask* task = nullptr;
+        if (self >= 0) task = workers[self]->deque.pop();
+        if (!task) {
+            thread_local std::minstd_rand rng(std::random_device{}());
+            size_t n = workers.size(), first = rng() % n;
+            for (size_t i = 0; i < n && !task; ++i) {
+                size_t victim = (first + i) % n;
+                if ((int)victim != self) task = workers[victim]->deque.steal();
+            }
+        }
+        if (!task) {
+            std::lock_guard<std::mutex> lock(injectMutex);
+            if (!injected.empty()) { task = injected.front(); injected.pop_front(); }
+        }
+        if (task) queued.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    static void execute(SchedulerTask* task) {
+        std::exception_ptr error;
+        try { task->fn(); } catch (...) { error = std::current_exception(); }
+        TaskGroup* group = task->group;
+        delete task;
+        group->finished(error);
+    }
+
+    void workerLoop(int index) {
+        currentWorker() = index;
+        currentScheduler() = this;
+        while (!stopping.load(std::memory_order_relaxed)) {
+            if (SchedulerTask* task = take()) { execute(task); continue; }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleeping.fetch_add(1, std::memory_order_seq_cst);
+            if (queued.load(std::memory_order_seq_cst) == 0 && !stopping.load())
+                wake.wait_for(lock, std::chrono::milliseconds(10));
+            sleeping.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex injectMutex;
+    std::deque<SchedulerTask*> injected;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{0};
+    std::atomic<int> sleeping{0};
+    std::atomic<bool> stopping{false};
+};
+
+template <class F>
+void TaskGroup::run(F&& fn) {
+    pending.fetch_add(1, std::memory_order_relaxed);
+    scheduler.submit(new SchedulerTask{std::function<void()>(std::forward<F>(fn)), this});
+}
+
+inline void TaskGroup::waitNoThrow() {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (SchedulerTask* task = scheduler.take()) TaskScheduler::execute(task);
+        else std::this_thread::yield();
+    }
+}
+
+inline void TaskGroup::wait() {
+    waitNoThrow();
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        std::swap(error, firstError);
+    }
+    if (error) std::rethrow_exception(error);
+}
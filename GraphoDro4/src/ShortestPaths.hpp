@@ -0,0 +1,220 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+// Monotone priority queue for Dijkstra (Ahuja et al.). Keys are the bit patterns
+// of non-negative doubles, which sort like the doubles themselves; an element
+// sits in the bucket of the highest bit where its key differs from the last
+// popped key, so every element moves down at most 64 times.
+template <class Index>
+class RadixHeap {
+public:
+    static uint64_t key(double d) {
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        return bits;
+    }
+
+    void push(double d, Index v) {
+        uint64_t k = key(d);
+        buckets[bucketOf(k)].push_back({k, v});
+        count++;
+    }
+
+    // Smallest element; the caller must check !empty().
+    std::pair<double, Index> pop() {
+        if (buckets[0].empty()) {
+            size_t i = 1;
+            while (buckets[i].empty()) ++i;
+            uint64_t smallest = UINT64_MAX;
+            for (auto& e : buckets[i]) smallest = std::min(smallest, e.first);
+            last = smallest;
+            for (auto& e : buckets[i]) buckets[bucketOf(e.first)].push_back(e);
+            buckets[i].clear();
+        }
+        auto [k, v] = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        double d;
+        std::memcpy(&d, &k, sizeof(d));
+        return {d, v};
+    }
+
+    bool empty() const { return count == 0; }
+
+private:
+    size_t bucketOf(uint64_t k) const { return k == last ? 0 : 64 - __builtin_clzll(k ^ last); }
+
+    std::vector<std::pair<uint64_t, Index>> buckets[65];
+    uint64_t last = 0;
+    size_t count = 0;
+};
+
+// Single-source shortest paths over a CompactGraph with non-negative weights
+// (unweighted graphs count every edge as 1). Distances are indexed by compact
+// index, unreachable vertices get kInfinity.
+class ShortestPaths {
+public:
+    static constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+    template <class C>
+    static std::vector<double> Dijkstra(const C& g, typename C::Index source) {
+        using Index = typename C::Index;
+        checkWeights(g);
+        std::vector<double> dist(g.vertexCount(), kInfinity);
+        RadixHeap<Index> heap;
+        dist[source] = 0.0;
+        heap.push(0.0, source);
+        while (!heap.empty()) {
+            auto [d, v] = heap.pop();
+            if (d > dist[v]) continue;
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) {
+                Index u = g.targets[slot];
+                double nd = d + g.weight(slot);
+                if (nd < dist[u]) { dist[u] = nd; heap.push(nd, u); }
+            }
+        }
+        return dist;
+    }
+
+    // Delta-stepping (Meyer, Sanders 2003). Vertices are kept in buckets of width
+    // delta; each bucket is settled by rounds of parallel light-edge relaxations
+    // (weight <= delta) followed by one round over its heavy edges. Distances are
+    // relaxed with CAS on their bit patterns. delta = 0 picks the mean edge weight.
+    // Only buckets within max weight / delta of the current one can be filled, so
+    // they live in a cyclic array of at most kMaxBuckets; vertices beyond it wait
+    // in a far list until the array runs empty.
+    template <class C>
+    static std::vector<double> DeltaStepping(const C& g, typename C::Index source, double delta = 0.0, unsigned threads = 0) {
+        using Index = typename C::Index;
+        checkWeights(g);
+        size_t n = g.vertexCount();
+        double sum = 0.0, heaviest = 0.0;
+        for (auto slot = decltype(g.targets.size())(0); slot < g.targets.size(); ++slot) {
+            sum += g.weight(slot);
+            heaviest = std::max(heaviest, g.weight(slot));
+        }
+        if (delta <= 0.0) delta = g.targets.empty() || sum == 0.0 ? 1.0 : sum / g.targets.size();
+        std::vector<std::atomic<uint64_t>> dist(n);
+        for (auto& d : dist) d.store(RadixHeap<Index>::key(kInfinity), std::memory_order_relaxed);
+        auto load = [&dist](Index v) {
+            uint64_t bits = dist[v].load(std::memory_order_relaxed);
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            return d;
+        };
+        auto bucketOf = [delta](double d) { return (size_t)std::min(d / delta, 1e18); };
+
+        double span = heaviest / delta + 2;
+        size_t slots = span < kMaxBuckets ? (size_t)span : kMaxBuckets;
+        std::vector<std::vector<Index>> ring(slots);
+        std::vector<Index> far;
+        size_t pending = 0, current = 0; // entries in the ring, bucket being settled
+        auto place = [&](Index u) {
+            size_t b = bucketOf(load(u));
+            if (b - current >= slots) far.push_back(u);
+            else { ring[b % slots].push_back(u); pending++; }
+        };
+        std::vector<size_t> stamp(n, SIZE_MAX); // round a vertex was last taken into a frontier
+        dist[source].store(RadixHeap<Index>::key(0.0), std::memory_order_relaxed);
+        place(source);
+        std::mutex merge;
+        size_t round = 0;
+
+        // Relaxes the light or heavy edges of `frontier`; improved vertices are re-bucketed.
+        auto relax = [&](const std::vector<Index>& frontier, bool light) {
+            std::vector<Index> improved;
+            Parallel::forRange(0, frontier.size(), [&](size_t lo, size_t hi) {
+                std::vector<Index> local;
+                for (size_t i = lo; i < hi; ++i) {
+                    Index v = frontier[i];
+                    double dv = load(v);
+                    for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) {
+                        double w = g.weight(slot);
+                        if ((w <= delta) != light) continue;
+                        Index u = g.targets[slot];
+                        uint64_t nd = RadixHeap<Index>::key(dv + w);
+                        uint64_t cur = dist[u].load(std::memory_order_relaxed);
+                        while (nd < cur && !dist[u].compare_exchange_weak(cur, nd, std::memory_order_relaxed)) {}
+                        if (nd < cur) local.push_back(u);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(merge);
+                improved.insert(improved.end(), local.begin(), local.end());
+            }, threads);
+            for (Index u : improved) place(u);
+        };
+
+        while (pending || !far.empty()) {
+            if (!pending) {
+                // Jump to the nearest far bucket; entries settled meanwhile are stale.
+                std::vector<Index> waiting;
+                waiting.swap(far);
+                size_t next = SIZE_MAX;
+                for (Index v : waiting) if (bucketOf(load(v)) >= current) next = std::min(next, bucketOf(load(v)));
+                current = next;
+                for (Index v : waiting) if (bucketOf(load(v)) >= current) place(v);
+                continue;
+            }
+            std::vector<Index>& bucket = ring[current % slots];
+            std::vector<Index> settled;
+            while (!bucket.empty()) {
+                std::vector<Index> frontier, taken;
+                taken.swap(bucket);
+                pending -= taken.size();
+                round++;
+                for (Index v : taken) {
+                    if (bucketOf(load(v)) != current || stamp[v] == round) continue; // stale or duplicate entry
+                    stamp[v] = round;
+                    frontier.push_back(v);
+                }
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+                relax(frontier, true);
+            }
+            std::sort(settled.begin(), settled.end());
+            settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+            relax(settled, false);
+            current++;
+        }
+
+        std::vector<double> res(n);
+        for (size_t v = 0; v < n; ++v) res[v] = load((Index)v);
+        return res;
+    }
+
+    // Largest finite distance from v.
+    template <class C>
+    static double Eccentricity(const C& g, typename C::Index v) {
+        double ecc = 0.0;
+        for (double d : Dijkstra(g, v)) if (d != kInfinity) ecc = std::max(ecc, d);
+        return ecc;
+    }
+
+    // Largest eccentricity, one Dijkstra per source on the scheduler.
+    template <class C>
+    static double Diameter(const C& g, unsigned threads = 0) {
+        size_t n = g.vertexCount();
+        size_t chunks = threads ? threads : 4 * (size_t)Parallel::threadCount();
+        size_t grain = std::max<size_t>(1, (n + chunks - 1) / chunks);
+        return TaskScheduler::instance().parallelReduce(0, n, 0.0,
+            [&g](size_t lo, size_t hi) {
+                double best = 0.0;
+                for (size_t s = lo; s < hi; ++s) best = std::max(best, Eccentricity(g, (typename C::Index)s));
+                return best;
+            },
+            [](double a, double b) { return std::max(a, b); }, grain);
+    }
+
+private:
+    static constexpr size_t kMaxBuckets = 1 << 16;
+
+    template <class C>
+    static void checkWeights(const C& g) {
+        for (double w : g.weights)
+            if (!(w >= 0.0)) throw std::invalid_argument("ShortestPaths: negative or NaN edge weight");
+    }
+};
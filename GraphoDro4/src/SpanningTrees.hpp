@@ -0,0 +1,246 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <numeric>
+#include <random>
+
+// Spanning forest as a parent array over compact indices: parent[v] is v's
+// parent in its tree, kNone for the root. contains() answers "is (u, v) a tree
+// edge" in O(1), which is all a renderer needs to highlight the tree.
+template <class Index>
+struct BasicSpanningForest {
+    static constexpr Index kNone = std::numeric_limits<Index>::max();
+    std::vector<Index> parent;
+    double weight = 0.0; // sum of tree edge weights (edge count when unweighted)
+    size_t trees = 0;
+
+    bool contains(Index u, Index v) const { return parent[u] == v || parent[v] == u; }
+};
+
+using SpanningForest = BasicSpanningForest<CompactGraph::Index>;
+
+class SpanningTrees {
+public:
+    // Uniform random spanning tree of every component by Wilson's algorithm:
+    // loop-erased random walks from each vertex until they hit the tree.
+    template <class C>
+    static BasicSpanningForest<typename C::Index> Wilson(const C& g, uint64_t seed = std::random_device{}()) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicSpanningForest<Index> f;
+        f.parent.assign(n, f.kNone);
+        std::vector<char> inTree(n, 0);
+        // One root per component; any choice of root gives the same distribution.
+        for (Index r : componentRoots(g)) inTree[r] = 1;
+        std::mt19937_64 rng(seed);
+        for (Index start = 0; start < n; ++start) {
+            for (Index u = start; !inTree[u]; u = f.parent[u])
+                f.parent[u] = g.targets[g.offsets[u] + rng() % g.degree(u)];
+            for (Index u = start; !inTree[u]; u = f.parent[u]) inTree[u] = 1;
+        }
+        return finish(g, f);
+    }
+
+    template <class C>
+    static BasicSpanningForest<typename C::Index> BFS(const C& g) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicSpanningForest<Index> f;
+        f.parent.assign(n, f.kNone);
+        std::vector<char> seen(n, 0);
+        std::vector<Index> queue;
+        queue.reserve(n);
+        for (Index r = 0; r < n; ++r) {
+            if (seen[r]) continue;
+            seen[r] = 1;
+            queue.push_back(r);
+            for (size_t head = queue.size() - 1; head < queue.size(); ++head) {
+                Index v = queue[head];
+                for (Index u : g.neighbors(v))
+                    if (!seen[u]) { seen[u] = 1; f.parent[u] = v; queue.push_back(u); }
+            }
+        }
+        return finish(g, f);
+    }
+
+    // Depth-first tree with an explicit stack of (vertex, next CSR slot).
+    template <class C>
+    static BasicSpanningForest<typename C::Index> DFS(const C& g) {
+        using Index = typename C::Index;
+        using Offset = typename C::Offset;
+        Index n = g.vertexCount();
+        BasicSpanningForest<Index> f;
+        f.parent.assign(n, f.kNone);
+        std::vector<char> seen(n, 0);
+        std::vector<std::pair<Index, Offset>> stack;
+        for (Index r = 0; r < n; ++r) {
+            if (seen[r]) continue;
+            seen[r] = 1;
+            stack.push_back({r, g.offsets[r]});
+            while (!stack.empty()) {
+                auto& [v, slot] = stack.back();
+                if (slot == g.offsets[v + 1]) { stack.pop_back(); continue; }
+                Index u = g.targets[slot++];
+                if (seen[u]) continue;
+                seen[u] = 1;
+                f.parent[u] = v;
+                stack.push_back({u, g.offsets[u]});
+            }
+        }
+        return finish(g, f);
+    }
+
+    // Minimum spanning forest by Kruskal: edges sorted by (weight, endpoints), union-find.
+    template <class C>
+    static BasicSpanningForest<typename C::Index> Kruskal(const C& g) {
+        using Offset = typename C::Offset;
+        std::vector<Offset> order;
+        for (decltype(g.vertexCount()) v = 0; v < g.vertexCount(); ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+                if (v < g.targets[slot]) order.push_back(slot);
+        auto sources = slotSources(g);
+        std::sort(order.begin(), order.end(), [&](Offset a, Offset b) { return lighter(g, sources, a, b); });
+        DisjointSets sets(g.vertexCount());
+        std::vector<Offset> chosen;
+        for (Offset slot : order)
+            if (sets.unite(sources[slot], g.targets[slot])) chosen.push_back(slot);
+        return fromEdges(g, sources, chosen);
+    }
+
+    // Minimum spanning forest by parallel Boruvka: every round each component picks
+    // its lightest outgoing edge (atomic min per component over a strict total
+    // order of edges, so no cycles form), then the picks are contracted.
+    template <class C>
+    static BasicSpanningForest<typename C::Index> Boruvka(const C& g, unsigned threads = 0) {
+        using Index = typename C::Index;
+        using Offset = typename C::Offset;
+        Index n = g.vertexCount();
+        constexpr uint64_t kNoEdge = UINT64_MAX;
+        auto sources = slotSources(g);
+        DisjointSets sets(n);
+        std::vector<Index> comp(n);
+        std::vector<std::atomic<uint64_t>> best(n);
+        std::vector<Offset> chosen;
+
+        for (bool merged = true; merged;) {
+            merged = false;
+            for (Index v = 0; v < n; ++v) { comp[v] = sets.find(v); best[v].store(kNoEdge, std::memory_order_relaxed); }
+            Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+                for (size_t v = lo; v < hi; ++v) {
+                    for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) {
+                        if (comp[v] == comp[g.targets[slot]]) continue;
+                        auto& cell = best[comp[v]];
+                        uint64_t cur = cell.load(std::memory_order_relaxed);
+                        while ((cur == kNoEdge || lighter(g, sources, slot, (Offset)cur)) &&
+                               !cell.compare_exchange_weak(cur, slot, std::memory_order_relaxed)) {}
+                    }
+                }
+            }, threads);
+            for (Index c = 0; c < n; ++c) {
+                uint64_t slot = best[c].load(std::memory_order_relaxed);
+                if (slot == kNoEdge) continue;
+                if (sets.unite(sources[slot], g.targets[slot])) { chosen.push_back((Offset)slot); merged = true; }
+            }
+        }
+        return fromEdges(g, sources, chosen);
+    }
+
+private:
+    class DisjointSets {
+    public:
+        explicit DisjointSets(size_t n) : up(n) { std::iota(up.begin(), up.end(), size_t(0)); }
+        size_t find(size_t v) {
+            while (up[v] != v) { up[v] = up[up[v]]; v = up[v]; }
+            return v;
+        }
+        bool unite(size_t a, size_t b) {
+            a = find(a); b = find(b);
+            if (a == b) return false;
+            up[std::max(a, b)] = std::min(a, b);
+            return true;
+        }
+    private:
+        std::vector<size_t> up;
+    };
+
+    template <class C>
+    static std::vector<typename C::Index> slotSources(const C& g) {
+        std::vector<typename C::Index> src(g.targets.size());
+        for (decltype(g.vertexCount()) v = 0; v < g.vertexCount(); ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) src[slot] = v;
+        return src;
+    }
+
+    // Strict total order on undirected edges: weight, then the sorted endpoint pair.
+    template <class C, class Offset>
+    static bool lighter(const C& g, const std::vector<typename C::Index>& src, Offset a, Offset b) {
+        double wa = g.weight(a), wb = g.weight(b);
+        if (wa != wb) return wa < wb;
+        auto ka = std::minmax(src[a], g.targets[a]), kb = std::minmax(src[b], g.targets[b]);
+        return ka < kb;
+    }
+
+    template <class C>
+    static std::vector<typename C::Index> componentRoots(const C& g) {
+        using Index = typename C::Index;
+        std::vector<Index> roots, queue;
+        std::vector<char> seen(g.vertexCount(), 0);
+        for (Index r = 0; r < (Index)g.vertexCount(); ++r) {
+            if (seen[r]) continue;
+            roots.push_back(r);
+            seen[r] = 1;
+            queue.assign(1, r);
+            while (!queue.empty()) {
+                Index v = queue.back(); queue.pop_back();
+                for (Index u : g.neighbors(v)) if (!seen[u]) { seen[u] = 1; queue.push_back(u); }
+            }
+        }
+        return roots;
+    }
+
+    // Orients a set of forest edges into a parent array by BFS over them.
+    template <class C, class Offset>
+    static BasicSpanningForest<typename C::Index> fromEdges(const C& g, const std::vector<typename C::Index>& src,
+                                                           const std::vector<Offset>& edges) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<size_t> start(n + 1, 0);
+        for (Offset e : edges) { start[src[e] + 1]++; start[g.targets[e] + 1]++; }
+        for (Index v = 0; v < n; ++v) start[v + 1] += start[v];
+        std::vector<Index> adj(start[n]);
+        std::vector<size_t> fill(start.begin(), start.end() - 1);
+        for (Offset e : edges) { adj[fill[src[e]]++] = g.targets[e]; adj[fill[g.targets[e]]++] = src[e]; }
+
+        BasicSpanningForest<Index> f;
+        f.parent.assign(n, f.kNone);
+        std::vector<char> seen(n, 0);
+        std::vector<Index> queue;
+        for (Index r = 0; r < n; ++r) {
+            if (seen[r]) continue;
+            seen[r] = 1;
+            queue.assign(1, r);
+            while (!queue.empty()) {
+                Index v = queue.back(); queue.pop_back();
+                for (size_t i = start[v]; i < start[v + 1]; ++i)
+                    if (!seen[adj[i]]) { seen[adj[i]] = 1; f.parent[adj[i]] = v; queue.push_back(adj[i]); }
+            }
+        }
+        return finish(g, f);
+    }
+
+    // Fills in tree count and total weight from the parent array.
+    template <class C, class Index>
+    static BasicSpanningForest<Index>& finish(const C& g, BasicSpanningForest<Index>& f) {
+        f.trees = 0;
+        f.weight = 0.0;
+        for (Index v = 0; v < (Index)f.parent.size(); ++v) {
+            Index p = f.parent[v];
+            if (p == f.kNone) { f.trees++; continue; }
+            auto row = g.neighbors(v);
+            auto it = std::lower_bound(row.begin(), row.end(), p);
+            f.weight += g.weight(it - g.targets.data());
+        }
+        return f;
+    }
+};
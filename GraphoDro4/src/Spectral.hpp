@@ -0,0 +1,337 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Connectivity.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// An eigenvalue, its unit eigenvector indexed like the graph, and the number
+// of operator applications the solver spent.
+struct EigenPair {
+    double value = 0.0;
+    std::vector<double> vector;
+    size_t iterations = 0;
+    bool converged = false;
+};
+
+// Sparse linear algebra on a CompactGraph: the CSR arrays are the adjacency
+// matrix A (edge weights as entries, 1 when unweighted) and L = D - A is the
+// Laplacian with D the weighted degrees. Eigenvalues come from Lanczos, so
+// every solver only needs matrix-vector products.
+class Spectral {
+public:
+    // y = A x, rows split over the scheduler. Each row is summed in four
+    // independent lanes so the gathers from x overlap; explicit AVX2 gathers
+    // measured slower than this on scalar-friendly CPUs.
+    template <class C>
+    static void Multiply(const C& g, const std::vector<double>& x, std::vector<double>& y, unsigned threads = 0) {
+        y.resize(g.vertexCount());
+        Parallel::forRange(0, g.vertexCount(), [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) y[v] = rowDot(g, v, x.data());
+        }, threads);
+    }
+
+    // y = L x for the weighted degrees of WeightedDegrees(g).
+    template <class C>
+    static void MultiplyLaplacian(const C& g, const std::vector<double>& degrees, const std::vector<double>& x,
+                                  std::vector<double>& y, unsigned threads = 0) {
+        y.resize(g.vertexCount());
+        Parallel::forRange(0, g.vertexCount(), [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) y[v] = degrees[v] * x[v] - rowDot(g, v, x.data());
+        }, threads);
+    }
+
+    template <class C>
+    static std::vector<double> WeightedDegrees(const C& g) {
+        std::vector<double> degrees(g.vertexCount(), 0.0);
+        for (size_t v = 0; v < g.vertexCount(); ++v)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot) degrees[v] += g.weight(slot);
+        return degrees;
+    }
+
+    // Largest eigenvalue of the symmetric operator apply(x, y): y = M x on R^n,
+    // restricted to the complement of `deflate` (orthonormal vectors). Lanczos
+    // with full reorthogonalisation and thick restarts: once the basis holds
+    // kRestart vectors, the kKeep best Ritz vectors and the residual direction
+    // seed the next cycle, so clustered eigenvalues keep their progress.
+    // Ritz values are checked every kCheck steps; converged once ||M x - value x|| <= tolerance * max(1, |value|).
+    template <class Apply>
+    static EigenPair Lanczos(size_t n, Apply&& apply, const std::vector<std::vector<double>>& deflate = {},
+                             size_t maxIterations = 5000, double tolerance = 1e-10, uint64_t seed = 1) {
+        EigenPair res;
+        if (n <= deflate.size()) return res;
+        size_t limit = std::min(kRestart, n - deflate.size());
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> gauss;
+        std::vector<double> x(n), w(n);
+        for (double& xi : x) xi = gauss(rng);
+        orthogonalize(x, deflate);
+        scale(x, 1.0 / norm(x));
+        // basis holds orthonormal vectors V and h = V^T M V (limit x limit, row-major);
+        // M V = V h + w e_last^T with ||w|| = beta after every step.
+        std::vector<std::vector<double>> basis{x};
+        std::vector<double> h(limit * limit, 0.0);
+        while (true) {
+            double beta = 0.0;
+            for (size_t j = basis.size() - 1;; ++j) {
+                apply(basis[j], w);
+                res.iterations++;
+                for (size_t i = 0; i <= j; ++i) h[i * limit + j] = 0.0;
+                // Two Gram-Schmidt passes keep the basis orthogonal to working precision.
+                for (int pass = 0; pass < 2; ++pass) {
+                    orthogonalize(w, deflate);
+                    for (size_t i = 0; i <= j; ++i) {
+                        double c = dot(w, basis[i]);
+                        axpy(-c, basis[i], w);
+                        h[i * limit + j] += c;
+                    }
+                }
+                for (size_t i = 0; i < j; ++i) h[j * limit + i] = h[i * limit + j];
+                beta = norm(w);
+                if (j + 1 == limit || (j + 1) % kCheck == 0 || res.iterations >= maxIterations ||
+                    beta <= kBreakdown * std::max(1.0, std::abs(h[j * limit + j]))) break;
+                scale(w, 1.0 / beta);
+                basis.push_back(w);
+            }
+            size_t m = basis.size();
+            std::vector<double> a(m * m), z;
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < m; ++j) a[i * m + j] = h[i * limit + j];
+            std::vector<double> theta = symmetricEigen(a, m, z);
+            std::vector<size_t> order(m);
+            std::iota(order.begin(), order.end(), size_t(0));
+            std::sort(order.begin(), order.end(), [&theta](size_t i, size_t j) { return theta[i] > theta[j]; });
+            auto ritz = [&](size_t k) {
+                std::vector<double> y(n, 0.0);
+                for (size_t i = 0; i < m; ++i) axpy(z[i * m + k], basis[i], y);
+                return y;
+            };
+            size_t top = order[0];
+            res.value = theta[top];
+            res.vector = ritz(top);
+            orthogonalize(res.vector, deflate);
+            scale(res.vector, 1.0 / norm(res.vector));
+            double residual = beta * std::abs(z[(m - 1) * m + top]);
+            if (beta <= kBreakdown * std::max(1.0, std::abs(res.value)) ||
+                residual <= tolerance * std::max(1.0, std::abs(res.value))) { res.converged = true; break; }
+            if (res.iterations >= maxIterations) break;
+            if (m < limit) { scale(w, 1.0 / beta); basis.push_back(w); continue; }
+            size_t keep = std::min(kKeep, m - 1);
+            std::vector<std::vector<double>> next;
+            for (size_t k = 0; k < keep; ++k) next.push_back(ritz(order[k]));
+            scale(w, 1.0 / beta);
+            next.push_back(w);
+            basis.swap(next);
+            std::fill(h.begin(), h.end(), 0.0);
+            for (size_t k = 0; k < keep; ++k) h[k * limit + k] = theta[order[k]];
+        }
+        return res;
+    }
+
+    // Largest adjacency eigenvalue; for non-negative weights this is the
+    // spectral radius and the vector is the (non-negative) Perron vector.
+    template <class C>
+    static EigenPair SpectralRadius(const C& g, unsigned threads = 0, size_t maxIterations = 5000, double tolerance = 1e-10) {
+        EigenPair res = Lanczos(g.vertexCount(), [&](const std::vector<double>& x, std::vector<double>& y) {
+            Multiply(g, x, y, threads);
+        }, {}, maxIterations, tolerance);
+        double sum = 0.0;
+        for (double xi : res.vector) sum += xi;
+        if (sum < 0) scale(res.vector, -1.0);
+        return res;
+    }
+
+    // Second-smallest Laplacian eigenvalue (algebraic connectivity) and its
+    // vector. Lanczos first runs on sigma I - L, sigma = 2 max degree >=
+    // lambda_max(L), for at most kDirectSteps products: enough when lambda_2 is
+    // well separated relative to sigma (expanders, random graphs). Otherwise it
+    // switches to shift-invert: Lanczos on the pseudo-inverse of L, whose top
+    // eigenvalue 1 / lambda_2 leads the next by the ratio lambda_3 / lambda_2,
+    // so a tiny gap (long paths, barbells) costs no extra steps. Each of those
+    // steps solves L y = x by conjugate gradients. The constant vector is
+    // deflated throughout; maxIterations bounds the Lanczos steps, `iterations`
+    // counts Laplacian products. A disconnected graph has value 0 and the
+    // indicator of vertex 0's component (centred) as vector.
+    template <class C>
+    static EigenPair Fiedler(const C& g, unsigned threads = 0, size_t maxIterations = 5000, double tolerance = 1e-10) {
+        using Index = typename C::Index;
+        size_t n = g.vertexCount();
+        EigenPair res;
+        if (n < 2) { res.vector.assign(n, 0.0); res.converged = true; return res; }
+        std::vector<char> reached(n, 0);
+        std::vector<Index> stack{0};
+        reached[0] = 1;
+        size_t inside = 1;
+        while (!stack.empty()) {
+            Index v = stack.back(); stack.pop_back();
+            for (Index u : g.neighbors(v)) if (!reached[u]) { reached[u] = 1; inside++; stack.push_back(u); }
+        }
+        if (inside < n) {
+            res.vector.resize(n);
+            for (size_t v = 0; v < n; ++v) res.vector[v] = reached[v] ? 1.0 / inside : -1.0 / (n - inside);
+            scale(res.vector, 1.0 / norm(res.vector));
+            res.converged = true;
+            return res;
+        }
+        std::vector<double> degrees = WeightedDegrees(g);
+        double sigma = std::max(1.0, 2.0 * *std::max_element(degrees.begin(), degrees.end()));
+        std::vector<std::vector<double>> deflate{std::vector<double>(n, 1.0 / std::sqrt((double)n))};
+        res = Lanczos(n, [&](const std::vector<double>& x, std::vector<double>& y) {
+            MultiplyLaplacian(g, degrees, x, y, threads);
+            for (size_t v = 0; v < n; ++v) y[v] = sigma * x[v] - y[v];
+        }, deflate, std::min(maxIterations, kDirectSteps), tolerance);
+        size_t products = res.iterations;
+        bool solved = true;
+        if (!res.converged) {
+            res = Lanczos(n, [&](const std::vector<double>& x, std::vector<double>& y) {
+                solved &= solveLaplacian(g, degrees, x, y, products, threads);
+            }, deflate, maxIterations, tolerance);
+        }
+        // The Rayleigh quotient of L is accurate to the square of the vector error.
+        std::vector<double> lx;
+        MultiplyLaplacian(g, degrees, res.vector, lx, threads);
+        res.value = std::max(0.0, dot(res.vector, lx));
+        res.iterations = products + 1;
+        res.converged = res.converged && solved;
+        return res;
+    }
+
+    // Fiedler value, NaN when Lanczos did not converge.
+    template <class C>
+    static double AlgebraicConnectivity(const C& g, unsigned threads = 0) {
+        EigenPair fiedler = Fiedler(g, threads);
+        return fiedler.converged ? fiedler.value : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // Spectral bisection: the floor(n / 2) vertices with the smallest Fiedler
+    // entries (ties by index) form the shore; weight is the cut between halves.
+    template <class C>
+    static BasicCut<typename C::Index> Bisection(const C& g, unsigned threads = 0) {
+        return Bisection(g, Fiedler(g, threads));
+    }
+
+    // Bisection by an already computed Fiedler pair of g.
+    template <class C>
+    static BasicCut<typename C::Index> Bisection(const C& g, const EigenPair& fiedler) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        BasicCut<Index> cut;
+        if (n < 2) return cut;
+        const std::vector<double>& f = fiedler.vector;
+        std::vector<Index> order(n);
+        std::iota(order.begin(), order.end(), Index(0));
+        std::nth_element(order.begin(), order.begin() + n / 2, order.end(), [&f](Index a, Index b) {
+            return f[a] != f[b] ? f[a] < f[b] : a < b;
+        });
+        cut.side.assign(order.begin(), order.begin() + n / 2);
+        std::sort(cut.side.begin(), cut.side.end());
+        std::vector<char> inside(n, 0);
+        for (Index v : cut.side) inside[v] = 1;
+        for (Index v : cut.side)
+            for (auto slot = g.offsets[v]; slot < g.offsets[v + 1]; ++slot)
+                if (!inside[g.targets[slot]]) cut.weight += g.weight(slot);
+        return cut;
+    }
+
+private:
+    static constexpr size_t kRestart = 32;
+    static constexpr size_t kKeep = 12;
+    static constexpr size_t kCheck = 8;
+    static constexpr size_t kDirectSteps = 20 * kRestart;
+    static constexpr double kBreakdown = 1e-12;
+    static constexpr double kSolveTolerance = 1e-13;
+
+    // y = L^+ x for x orthogonal to the constants, by conjugate gradients kept
+    // in that complement; false if the relative residual stayed above
+    // kSolveTolerance after 10 n + 100 steps.
+    template <class C>
+    static bool solveLaplacian(const C& g, const std::vector<double>& degrees, const std::vector<double>& x,
+                               std::vector<double>& y, size_t& products, unsigned threads) {
+        size_t n = x.size();
+        std::vector<double> r = x, p = x, lp;
+        y.assign(n, 0.0);
+        double target = kSolveTolerance * norm(x), rr = dot(r, r);
+        for (size_t step = 0; step < 10 * n + 100; ++step) {
+            if (std::sqrt(rr) <= target) return true;
+            MultiplyLaplacian(g, degrees, p, lp, threads);
+            products++;
+            double alpha = rr / dot(p, lp);
+            axpy(alpha, p, y);
+            axpy(-alpha, lp, r);
+            double mean = std::accumulate(r.begin(), r.end(), 0.0) / n;
+            for (double& ri : r) ri -= mean;
+            double next = dot(r, r);
+            for (size_t i = 0; i < n; ++i) p[i] = r[i] + next / rr * p[i];
+            rr = next;
+        }
+        return std::sqrt(rr) <= target;
+    }
+
+    template <class C>
+    static double rowDot(const C& g, size_t v, const double* x) {
+        auto k = g.offsets[v], last = g.offsets[v + 1];
+        const auto* t = g.targets.data();
+        const double* w = g.weights.empty() ? nullptr : g.weights.data();
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        if (w) {
+            for (; k + 4 <= last; k += 4) {
+                s0 += w[k] * x[t[k]]; s1 += w[k + 1] * x[t[k + 1]];
+                s2 += w[k + 2] * x[t[k + 2]]; s3 += w[k + 3] * x[t[k + 3]];
+            }
+            for (; k < last; ++k) s0 += w[k] * x[t[k]];
+        } else {
+            for (; k + 4 <= last; k += 4) { s0 += x[t[k]]; s1 += x[t[k + 1]]; s2 += x[t[k + 2]]; s3 += x[t[k + 3]]; }
+            for (; k < last; ++k) s0 += x[t[k]];
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    static double dot(const std::vector<double>& a, const std::vector<double>& b) {
+        double s = 0.0;
+        for (size_t i = 0; i < a.size(); ++i) s += a[i] * b[i];
+        return s;
+    }
+    static double norm(const std::vector<double>& a) { return std::sqrt(dot(a, a)); }
+    static void scale(std::vector<double>& a, double f) { for (double& ai : a) ai *= f; }
+    static void axpy(double f, const std::vector<double>& x, std::vector<double>& y) {
+        for (size_t i = 0; i < x.size(); ++i) y[i] += f * x[i];
+    }
+    static void orthogonalize(std::vector<double>& w, const std::vector<std::vector<double>>& against) {
+        for (const auto& q : against) axpy(-dot(w, q), q, w);
+    }
+
+    // Cyclic Jacobi on the symmetric m x m matrix a (row-major, destroyed):
+    // returns the eigenvalues, column i of z is the unit vector of value i.
+    static std::vector<double> symmetricEigen(std::vector<double>& a, size_t m, std::vector<double>& z) {
+        z.assign(m * m, 0.0);
+        for (size_t i = 0; i < m; ++i) z[i * m + i] = 1.0;
+        for (int sweep = 0; sweep < 64; ++sweep) {
+            double off = 0.0, total = 0.0;
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < m; ++j) (i == j ? total : off) += a[i * m + j] * a[i * m + j];
+            if (off <= 1e-30 * (total + off)) break;
+            for (size_t p = 0; p + 1 < m; ++p)
+                for (size_t q = p + 1; q < m; ++q) {
+                    double apq = a[p * m + q];
+                    if (apq == 0.0) continue;
+                    double theta = (a[q * m + q] - a[p * m + p]) / (2.0 * apq);
+                    double t = std::copysign(1.0, theta) / (std::abs(theta) + std::hypot(theta, 1.0));
+                    double c = 1.0 / std::hypot(t, 1.0), sn = t * c;
+                    auto rotate = [c, sn](double& x, double& y) {
+                        double xp = x, yq = y;
+                        x = c * xp - sn * yq;
+                        y = sn * xp + c * yq;
+                    };
+                    for (size_t k = 0; k < m; ++k) rotate(a[k * m + p], a[k * m + q]);
+                    for (size_t k = 0; k < m; ++k) rotate(a[p * m + k], a[q * m + k]);
+                    for (size_t k = 0; k < m; ++k) rotate(z[k * m + p], z[k * m + q]);
+                }
+        }
+        std::vector<double> values(m);
+        for (size_t i = 0; i < m; ++i) values[i] = a[i * m + i];
+        return values;
+    }
+};
@@ -0,0 +1,315 @@
+#pragma once
+#include "TriangleEstimation.hpp"
+#include <cstdio>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+
+// Buffered edge-list reader for files far larger than memory. Reads fixed-size
+// blocks with fread and parses integers by hand; lines starting with '#', '%'
+// or a letter (DIMACS 'c'/'p' headers, 'e' prefix) are skipped or stripped.
+class EdgeStreamReader {
+public:
+    explicit EdgeStreamReader(const std::string& path, size_t bufferSize = 1 << 22)
+        : buffer(bufferSize) {
+        if (path == "-") { file = stdin; owned = false; }
+        else {
+            file = std::fopen(path.c_str(), "rb");
+            if (!file) throw std::runtime_error("cannot open " + path);
+        }
+    }
+    ~EdgeStreamReader() { if (owned && file) std::fclose(file); }
+    EdgeStreamReader(const EdgeStreamReader&) = delete;
+    EdgeStreamReader& operator=(const EdgeStreamReader&) = delete;
+
+    // Next "u v" pair; any further columns on the line are ignored.
+    bool next(long long& u, long long& v) {
+        while (true) {
+            int c = peek();
+            if (c == EOF) return false;
+            if (c == '\n' || c == '\r' || c == ' ' || c == '\t') { ++pos; continue; }
+            if (c == 'e' || c == 'a') { ++pos; continue; }
+            if (!(c == '-' || (c >= '0' && c <= '9'))) { skipLine(); continue; }
+            bool ok = readInt(u) && readInt(v);
+            skipLine();
+            if (ok) return true;
+        }
+    }
+
+    uint64_t bytesRead() const { return consumed + pos; }
+
+private:
+    int peek() {
+        if (pos == len) {
+            consumed += len;
+            len = std::fread(buffer.data(), 1, buffer.size(), file);
+            pos = 0;
+            if (len == 0) return EOF;
+        }
+        return (unsigned char)buffer[pos];
+    }
+
+    void skipLine() {
+        int c;
+        while ((c = peek()) != EOF) { ++pos; if (c == '\n') return; }
+    }
+
+    bool readInt(long long& out) {
+        int c;
+        while ((c = peek()) == ' ' || c == '\t') ++pos;
+        bool neg = false;
+        if (c == '-') { neg = true; ++pos; c = peek(); }
+        if (c < '0' || c > '9') return false;
+        long long x = 0;
+        while ((c = peek()) >= '0' && c <= '9') {
+            if (x > (LLONG_MAX - (c - '0')) / 10) return false; // too long for an id: skip the line
+            x = x * 10 + (c - '0');
+            ++pos;
+        }
+        out = neg ? -x : x;
+        return true;
+    }
+
+    std::FILE* file = nullptr;
+    bool owned = true;
+    std::vector<char> buffer;
+    size_t pos = 0, len = 0;
+    uint64_t consumed = 0;
+};
+
+struct StreamSummary {
+    size_t vertices = 0;
+    size_t edges = 0;       // stream records without self-loops; duplicates are not detected
+    size_t selfLoops = 0;
+    size_t components = 0;
+    bool bipartite = true;
+    double density = 0.0;
+    size_t maxDegree = 0;
+    std::vector<size_t> degreeHistogram; // degreeHistogram[d] = vertices of degree d
+    double triangleEstimate = 0.0;
+    bool triangleExact = true;           // false once the reservoirs started evicting
+    // Means over the independent reservoirs with confidence intervals (zero width with one reservoir).
+    Estimate triangles, transitivity, averageClustering;
+};
+
+// One-pass semi-streaming analysis with O(V) state: union-find with parity bits
+// gives components and bipartiteness, degrees are counted per vertex, and
+// TRIEST-IMPR edge reservoirs estimate the global and per-vertex triangle
+// counts. The reservoir budget can be split into `groups` independent
+// reservoirs; their spread gives the confidence intervals.
+class StreamingAnalyzer {
+public:
+    explicit StreamingAnalyzer(size_t triangleReservoir = 1 << 20, uint64_t seed = std::random_device{}(),
+                               size_t groups = 1, double confidence = 0.95)
+        : capacity(groups ? triangleReservoir / groups : 0), confidence(confidence) {
+        if (capacity) for (size_t i = 0; i < groups; ++i) reservoirs.emplace_back(capacity, seed + i);
+    }
+
+    void addEdge(long long u, long long v) {
+        uint32_t a = index(u), b = index(v);
+        if (a == b) { summary.selfLoops++; return; }
+        summary.edges++;
+        degree[a]++; degree[b]++;
+        unite(a, b);
+        for (auto& r : reservoirs) r.add(a, b, summary.edges);
+    }
+
+    void consume(EdgeStreamReader& reader) {
+        long long u, v;
+        while (reader.next(u, v)) addEdge(u, v);
+    }
+
+    StreamSummary result() const {
+        StreamSummary s = summary;
+        s.vertices = parent.size();
+        s.components = 0;
+        for (uint32_t v = 0; v < parent.size(); ++v) if (parent[v] == v) s.components++;
+        double n = s.vertices;
+        s.density = n < 2 ? 0.0 : 2.0 * s.edges / (n * (n - 1));
+        for (auto d : degree) s.maxDegree = std::max<size_t>(s.maxDegree, d);
+        s.degreeHistogram.assign(s.vertices ? s.maxDegree + 1 : 0, 0);
+        for (auto d : degree) s.degreeHistogram[d]++;
+        s.triangleExact = capacity && summary.edges <= capacity;
+        double wedges = 0.0;
+        for (auto d : degree) wedges += (double)d * (d - (d > 0)) / 2;
+        std::vector<double> triangles, transitivity, clustering;
+        for (auto& r : reservoirs) {
+            double local = 0.0;
+            for (uint32_t v = 0; v < degree.size(); ++v)
+                if (degree[v] >= 2) local += r.local[v] * 2 / ((double)degree[v] * (degree[v] - 1));
+            triangles.push_back(r.triangles);
+            transitivity.push_back(wedges > 0 ? 3 * r.triangles / wedges : 0.0);
+            clustering.push_back(degree.empty() ? 0.0 : local / degree.size());
+        }
+        s.triangles = Estimate::Mean(triangles, confidence);
+        s.transitivity = Estimate::Mean(transitivity, confidence);
+        s.averageClustering = Estimate::Mean(clustering, confidence);
+        s.triangleEstimate = s.triangles.value;
+        return s;
+    }
+
+    static StreamSummary ProcessFile(const std::string& path, size_t triangleReservoir = 1 << 20, size_t groups = 1) {
+        EdgeStreamReader reader(path);
+        StreamingAnalyzer analyzer(triangleReservoir, std::random_device{}(), groups);
+        analyzer.consume(reader);
+        return analyzer.result();
+    }
+
+private:
+    // Ids in a dense non-negative range go through a flat table, anything else through a hash map.
+    // The table is only grown while it stays within a constant factor of the vertex count.
+    uint32_t index(long long id) {
+        if (id >= 0 && (size_t)id < direct.size()) {
+            uint32_t& slot = direct[id];
+            if (slot == kUnset) slot = fromHash(id);
+            return slot;
+        }
+        if (id >= 0 && (size_t)id < 4 * parent.size() + (1 << 16)) {
+            direct.resize(std::max<size_t>(id + 1, 2 * direct.size()), kUnset);
+            return direct[id] = fromHash(id);
+        }
+        auto [it, inserted] = ids.try_emplace(id, 0);
+        if (inserted) it->second = newVertex();
+        return it->second;
+    }
+
+    // Ids seen before the flat table covered them still live in the hash map.
+    uint32_t fromHash(long long id) {
+        if (!ids.empty()) {
+            auto it = ids.find(id);
+            if (it != ids.end()) return it->second;
+        }
+        return newVertex();
+    }
+
+    uint32_t newVertex() {
+        uint32_t v = parent.size();
+        parent.push_back(v);
+        parity.push_back(0);
+        rank.push_back(0);
+        degree.push_back(0);
+        for (auto& r : reservoirs) r.addVertex();
+        return v;
+    }
+
+    // Returns the root of v; `p` receives the parity of v relative to it.
+    uint32_t find(uint32_t v, uint8_t& p) {
+        uint32_t root = v;
+        p = 0;
+        while (parent[root] != root) { p ^= parity[root]; root = parent[root]; }
+        // Path compression keeping parities relative to the new parent (the root).
+        uint8_t acc = p;
+        while (parent[v] != root && parent[v] != v) {
+            uint32_t next = parent[v];
+            uint8_t old = parity[v];
+            parent[v] = root;
+            parity[v] = acc;
+            acc ^= old;
+            v = next;
+        }
+        return root;
+    }
+
+    void unite(uint32_t a, uint32_t b) {
+        uint8_t pa, pb;
+        uint32_t ra = find(a, pa), rb = find(b, pb);
+        if (ra == rb) {
+            if (pa == pb) summary.bipartite = false;
+            return;
+        }
+        if (rank[ra] < rank[rb]) std::swap(ra, rb);
+        parent[rb] = ra;
+        parity[rb] = pa ^ pb ^ 1;
+        if (rank[ra] == rank[rb]) rank[ra]++;
+    }
+
+    // One TRIEST-IMPR reservoir with global and per-vertex triangle estimates.
+    struct Reservoir {
+        Reservoir(size_t capacity, uint64_t seed) : capacity(capacity), rng(seed) {}
+
+        void addVertex() {
+            sampleDegree.push_back(0);
+            local.push_back(0.0);
+        }
+
+        // Edge number t of the stream.
+        void add(uint32_t a, uint32_t b, size_t t) {
+            double m = (double)capacity;
+            double weight = std::max(1.0, ((double)t - 1) * ((double)t - 2) / (m * (m - 1)));
+            if (sampleDegree[a] && sampleDegree[b]) {
+                bool aSmaller = sampleDegree[a] < sampleDegree[b];
+                uint32_t other = aSmaller ? b : a;
+                for (uint32_t x : sample.find(aSmaller ? a : b)->second)
+                    if (sampledEdges.count(edgeKey(x, other))) {
+                        triangles += weight;
+                        local[a] += weight;
+                        local[b] += weight;
+                        local[x] += weight;
+                    }
+            }
+            if (reservoir.size() < capacity) {
+                reservoir.push_back({a, b});
+                link(a, b);
+                return;
+            }
+            std::uniform_real_distribution<double> coin(0.0, 1.0);
+            if (coin(rng) < m / t) {
+                std::uniform_int_distribution<size_t> pick(0, capacity - 1);
+                auto& slot = reservoir[pick(rng)];
+                unlink(slot.first, slot.second);
+                slot = {a, b};
+                link(a, b);
+            }
+        }
+
+        void link(uint32_t a, uint32_t b) {
+            if (!sampledEdges.insert(edgeKey(a, b)).second) return;
+            sample[a].push_back(b);
+            sample[b].push_back(a);
+            sampleDegree[a]++;
+            sampleDegree[b]++;
+        }
+
+        void unlink(uint32_t a, uint32_t b) {
+            if (!sampledEdges.erase(edgeKey(a, b))) return;
+            for (auto [x, y] : {std::make_pair(a, b), std::make_pair(b, a)}) {
+                auto it = sample.find(x);
+                auto& list = it->second;
+                *std::find(list.begin(), list.end(), y) = list.back();
+                list.pop_back();
+                if (list.empty()) sample.erase(it);
+                sampleDegree[x]--;
+            }
+        }
+
+        size_t capacity;
+        std::mt19937_64 rng;
+        double triangles = 0.0;
+        std::vector<double> local;
+        std::vector<std::pair<uint32_t, uint32_t>> reservoir;
+        std::vector<uint32_t> sampleDegree;
+        std::unordered_map<uint32_t, std::vector<uint32_t>> sample;
+        std::unordered_set<uint64_t> sampledEdges;
+    };
+
+    static uint64_t edgeKey(uint32_t a, uint32_t b) {
+        return a < b ? ((uint64_t)a << 32 | b) : ((uint64_t)b << 32 | a);
+    }
+
+    static constexpr uint32_t kUnset = UINT32_MAX;
+    std::vector<uint32_t> direct;
+    std::unordered_map<long long, uint32_t> ids;
+    std::vector<uint32_t> parent, degree;
+    std::vector<uint8_t> parity, rank;
+    StreamSummary summary;
+
+    size_t capacity; // edges per reservoir
+    double confidence;
+    std::vector<Reservoir> reservoirs;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include <vector>
+
+// Breadth-first search over a CompactGraph whose state is allocated once and
+// reset through the visit order, so running one search per vertex (diameter,
+// landmark labeling) costs O(visited) each instead of O(V).
+template <class C>
+class BreadthFirstSearch {
+public:
+    using Index = typename C::Index;
+    static constexpr Index kUnreached = C::kNone;
+
+    explicit BreadthFirstSearch(const C& g) : g(g), dist(g.vertexCount(), kUnreached) {
+        order.reserve(g.vertexCount());
+    }
+
+    // enter(v, d) is called once per reached vertex in BFS order; returning false
+    // prunes the search at v (its neighbours are not queued through it).
+    // Returns the largest distance reached.
+    template <class Enter>
+    Index run(Index source, Enter&& enter) {
+        for (Index v : order) dist[v] = kUnreached;
+        order.clear();
+        order.push_back(source);
+        dist[source] = 0;
+        Index depth = 0;
+        for (size_t head = 0; head < order.size(); ++head) {
+            Index v = order[head];
+            depth = dist[v];
+            if (!enter(v, depth)) continue;
+            for (Index w : g.neighbors(v)) {
+                if (dist[w] == kUnreached) { dist[w] = depth + 1; order.push_back(w); }
+            }
+        }
+        return depth;
+    }
+
+    Index run(Index source) { return run(source, [](Index, Index) { return true; }); }
+
+    // Results of the last run.
+    Index distance(Index v) const { return dist[v]; }
+    const std::vector<Index>& visited() const { return order; }
+
+private:
+    const C& g;
+    std::vector<Index> dist;
+    std::vector<Index> order;
+};
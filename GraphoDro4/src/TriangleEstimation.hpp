@@ -0,0 +1,261 @@
+#pragma once
+#include "CompactGraph.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+// Point estimate with a two-sided confidence interval [low, high].
+struct Estimate {
+    double value = 0.0, low = 0.0, high = 0.0;
+    size_t samples = 0;
+
+    // Normal quantile z with P(|Z| <= z) = confidence, by bisection on erfc.
+    static double zScore(double confidence) {
+        if (!(confidence > 0.0 && confidence < 1.0)) throw std::invalid_argument("Estimate: confidence must be in (0, 1)");
+        double lo = 0.0, hi = 40.0;
+        for (int i = 0; i < 100; ++i) {
+            double mid = (lo + hi) / 2;
+            (std::erfc(mid / std::sqrt(2.0)) > 1.0 - confidence ? lo : hi) = mid;
+        }
+        return lo;
+    }
+
+    // Student t quantile with P(|T| <= t) = confidence for `df` degrees of
+    // freedom, by bisection on the closed-form CDF for integer df (Abramowitz
+    // and Stegun 26.7.3-4).
+    static double tScore(double confidence, size_t df) {
+        if (!(confidence > 0.0 && confidence < 1.0)) throw std::invalid_argument("Estimate: confidence must be in (0, 1)");
+        if (df == 0) throw std::invalid_argument("Estimate: t quantile needs at least one degree of freedom");
+        const double pi = std::acos(-1.0);
+        auto central = [df, pi](double t) {
+            double theta = std::atan(t / std::sqrt((double)df)), c2 = std::cos(theta) * std::cos(theta);
+            double term = 1.0, sum = 1.0;
+            for (size_t k = 2 + df % 2; k < df; k += 2) { term *= c2 * (k - 1) / k; sum += term; }
+            if (df % 2 == 0) return std::sin(theta) * sum;
+            double odd = df == 1 ? 0.0 : std::sin(theta) * std::cos(theta) * sum;
+            return 2.0 / pi * (theta + odd);
+        };
+        double lo = 0.0, hi = 1.0;
+        while (central(hi) < confidence) lo = hi, hi *= 2;
+        for (int i = 0; i < 100; ++i) {
+            double mid = (lo + hi) / 2;
+            (central(mid) < confidence ? lo : hi) = mid;
+        }
+        return lo;
+    }
+
+    // Wilson score interval for `hits` successes out of `n` Bernoulli trials.
+    static Estimate Proportion(size_t hits, size_t n, double confidence) {
+        Estimate e;
+        e.samples = n;
+        if (n == 0) return e;
+        double z = zScore(confidence), p = (double)hits / n, z2n = z * z / n;
+        double center = (p + z2n / 2) / (1 + z2n);
+        double half = z * std::sqrt(p * (1 - p) / n + z2n / (4.0 * n)) / (1 + z2n);
+        e.value = p;
+        e.low = std::max(0.0, center - half);
+        e.high = std::min(1.0, center + half);
+        return e;
+    }
+
+    // Mean of independent trials with a Student t interval (trials - 1 degrees
+    // of freedom) from their spread; a normal quantile would be far too narrow
+    // for the handful of trials the estimators run.
+    static Estimate Mean(const std::vector<double>& trials, double confidence) {
+        Estimate e;
+        e.samples = trials.size();
+        if (trials.empty()) return e;
+        double mean = 0.0, var = 0.0;
+        for (double x : trials) mean += x;
+        mean /= trials.size();
+        for (double x : trials) var += (x - mean) * (x - mean);
+        double half = trials.size() > 1 ? tScore(confidence, trials.size() - 1) * std::sqrt(var / (trials.size() - 1) / trials.size()) : 0.0;
+        e.value = mean;
+        e.low = mean - half;
+        e.high = mean + half;
+        return e;
+    }
+
+    Estimate scaled(double factor) const { return {value * factor, low * factor, high * factor, samples}; }
+};
+
+struct ClusteringEstimate {
+    Estimate triangles;
+    Estimate transitivity;      // 3 * triangles / wedges
+    Estimate averageClustering; // mean local clustering, 0 for vertices of degree < 2
+};
+
+// Triangle count, transitivity and average clustering of a CompactGraph, exact
+// or estimated with confidence intervals. Every estimator takes its sample
+// budget and seed explicitly; results do not depend on the thread count.
+class TriangleEstimation {
+public:
+    // Exact counts by the forward algorithm on the degree-ordered orientation.
+    template <class C>
+    static ClusteringEstimate Exact(const C& g, unsigned threads = 0) {
+        std::vector<double> local = localTriangles(g, 1.0, 0, threads);
+        ClusteringEstimate res = fromLocal(g, local);
+        res.triangles.samples = res.transitivity.samples = res.averageClustering.samples = 1;
+        return res;
+    }
+
+    // Wedge sampling (Schank, Wagner 2005; Seshadhri et al. 2013). Transitivity
+    // is the closed fraction of `samples` wedges drawn uniformly (centre chosen
+    // by its wedge count); average clustering the closed fraction of one random
+    // wedge at each of `samples` uniform vertices. Both are Bernoulli means, so
+    // the intervals are Wilson score intervals; error shrinks as 1/sqrt(samples).
+    template <class C>
+    static ClusteringEstimate Wedges(const C& g, size_t samples, double confidence = 0.95,
+                                     uint64_t seed = std::random_device{}(), unsigned threads = 0) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        std::vector<uint64_t> prefix(n + 1, 0);
+        for (Index v = 0; v < n; ++v) prefix[v + 1] = prefix[v] + wedgesAt(g, v);
+        uint64_t wedges = prefix[n];
+        ClusteringEstimate res;
+        if (n == 0 || wedges == 0) {
+            res.triangles.samples = res.transitivity.samples = res.averageClustering.samples = samples;
+            return res;
+        }
+
+        std::atomic<size_t> closedWedges{0}, closedAtVertices{0};
+        size_t blocks = (samples + kBlock - 1) / kBlock;
+        Parallel::forRange(0, blocks, [&](size_t lo, size_t hi) {
+            size_t wedgeHits = 0, vertexHits = 0;
+            for (size_t b = lo; b < hi; ++b) {
+                std::mt19937_64 rng(seed ^ mix(b));
+                size_t count = std::min(kBlock, samples - b * kBlock);
+                for (size_t i = 0; i < count; ++i) {
+                    uint64_t r = rng() % wedges;
+                    Index center = std::upper_bound(prefix.begin(), prefix.end(), r) - prefix.begin() - 1;
+                    wedgeHits += closedWedge(g, center, rng);
+                    Index v = rng() % n;
+                    if (g.degree(v) >= 2) vertexHits += closedWedge(g, v, rng);
+                }
+            }
+            closedWedges.fetch_add(wedgeHits, std::memory_order_relaxed);
+            closedAtVertices.fetch_add(vertexHits, std::memory_order_relaxed);
+        }, threads);
+
+        res.transitivity = Estimate::Proportion(closedWedges.load(), samples, confidence);
+        res.triangles = res.transitivity.scaled(wedges / 3.0);
+        res.averageClustering = Estimate::Proportion(closedAtVertices.load(), samples, confidence);
+        return res;
+    }
+
+    // DOULION (Tsourakakis et al. 2009): keep every edge with probability p, count
+    // triangles of the sparsified graph exactly and scale by 1/p^3 (per vertex as
+    // well, for the local clustering). `trials` independent sparsifications give
+    // the mean and a Student t interval from their spread.
+    template <class C>
+    static ClusteringEstimate Doulion(const C& g, double p, size_t trials = 8, double confidence = 0.95,
+                                      uint64_t seed = std::random_device{}(), unsigned threads = 0) {
+        if (!(p > 0.0 && p <= 1.0)) throw std::invalid_argument("Doulion: p must be in (0, 1]");
+        if (trials < 2) throw std::invalid_argument("Doulion: needs at least 2 trials for an interval");
+        std::vector<double> triangles, transitivity, clustering;
+        for (size_t t = 0; t < trials; ++t) {
+            ClusteringEstimate one = fromLocal(g, localTriangles(g, p, seed ^ mix(t + 1), threads));
+            triangles.push_back(one.triangles.value);
+            transitivity.push_back(one.transitivity.value);
+            clustering.push_back(one.averageClustering.value);
+        }
+        return {Estimate::Mean(triangles, confidence), Estimate::Mean(transitivity, confidence),
+                Estimate::Mean(clustering, confidence)};
+    }
+
+private:
+    static constexpr size_t kBlock = 1 << 12;
+
+    static uint64_t mix(uint64_t x) { // splitmix64
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    template <class C>
+    static uint64_t wedgesAt(const C& g, typename C::Index v) {
+        uint64_t d = g.degree(v);
+        return d * (d - (d > 0)) / 2;
+    }
+
+    // Draws two distinct neighbours of v (degree >= 2) and tests whether they are adjacent.
+    template <class C>
+    static bool closedWedge(const C& g, typename C::Index v, std::mt19937_64& rng) {
+        size_t d = g.degree(v), i = rng() % d, j = rng() % (d - 1);
+        if (j >= i) ++j;
+        auto a = g.targets[g.offsets[v] + i], b = g.targets[g.offsets[v] + j];
+        auto row = g.neighbors(a);
+        return std::binary_search(row.begin(), row.end(), b);
+    }
+
+    // Triangles at every vertex of the graph whose edges are each kept with
+    // probability p (decided by a hash of the edge, so both directions agree),
+    // scaled by 1/p^3. Edges point from lower to higher (degree, index) rank;
+    // each triangle is found once as u -> v -> w with u -> w.
+    template <class C>
+    static std::vector<double> localTriangles(const C& g, double p, uint64_t seed, unsigned threads) {
+        using Index = typename C::Index;
+        Index n = g.vertexCount();
+        uint64_t threshold = p >= 1.0 ? UINT64_MAX : (uint64_t)(p * 18446744073709551616.0);
+        auto kept = [&](Index a, Index b) {
+            if (p >= 1.0) return true;
+            auto [x, y] = std::minmax(a, b);
+            return mix(mix(seed ^ x) ^ y) < threshold;
+        };
+        auto before = [&g](Index a, Index b) {
+            return g.degree(a) != g.degree(b) ? g.degree(a) < g.degree(b) : a < b;
+        };
+        std::vector<size_t> start(n + 1, 0);
+        for (Index v = 0; v < n; ++v) {
+            start[v + 1] = start[v];
+            for (Index u : g.neighbors(v)) if (u != v && before(v, u) && kept(v, u)) start[v + 1]++;
+        }
+        std::vector<Index> out(start[n]);
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                size_t pos = start[v];
+                for (Index u : g.neighbors(v)) if (u != v && before(v, u) && kept(v, u)) out[pos++] = u;
+            }
+        }, threads);
+
+        std::vector<std::atomic<uint64_t>> count(n);
+        Parallel::forRange(0, n, [&](size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; ++u)
+                for (size_t i = start[u]; i < start[u + 1]; ++i) {
+                    Index v = out[i];
+                    size_t a = start[u], aEnd = start[u + 1], b = start[v], bEnd = start[v + 1];
+                    while (a < aEnd && b < bEnd) {
+                        if (out[a] < out[b]) ++a;
+                        else if (out[a] > out[b]) ++b;
+                        else {
+                            for (Index x : {(Index)u, v, out[a]}) count[x].fetch_add(1, std::memory_order_relaxed);
+                            ++a; ++b;
+                        }
+                    }
+                }
+        }, threads);
+        std::vector<double> local(n);
+        double scale = 1.0 / (p * p * p);
+        for (Index v = 0; v < n; ++v) local[v] = count[v].load(std::memory_order_relaxed) * scale;
+        return local;
+    }
+
+    // Point values (zero-width intervals) from per-vertex triangle counts.
+    template <class C>
+    static ClusteringEstimate fromLocal(const C& g, const std::vector<double>& local) {
+        double triangles = 0.0, wedges = 0.0, clustering = 0.0;
+        for (typename C::Index v = 0; v < (typename C::Index)local.size(); ++v) {
+            double w = (double)wedgesAt(g, v);
+            triangles += local[v];
+            wedges += w;
+            if (w > 0) clustering += local[v] / w;
+        }
+        triangles /= 3;
+        auto point = [](double x) { return Estimate{x, x, x, 0}; };
+        return {point(triangles), point(wedges > 0 ? 3 * triangles / wedges : 0.0),
+                point(local.empty() ? 0.0 : clustering / local.size())};
+    }
+};
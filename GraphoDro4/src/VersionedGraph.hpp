@@ -0,0 +1,263 @@
+#pragma once
+#include "Graph.hpp"
+#include <atomic>
+#include <memory>
+#include <array>
+
+// Single-writer graph with persistent snapshots. Rows (id + neighbour set) sit
+// in the leaves of a 32-way radix trie indexed by dense slot; commit() publishes
+// the current root in O(1) and starts a new edit generation, after which the
+// writer copies only the trie path and the row it touches (copy-on-write).
+// Published snapshots are immutable, so any number of readers can run
+// GraphMetrics on them while the writer keeps calling addEdge.
+template <class V = Graph::Vertex>
+class BasicVersionedGraph {
+public:
+    using Vertex = V;
+    using Slot = std::make_unsigned_t<V>;
+    using Neighbors = NeighborSet<Vertex>;
+    static constexpr Vertex kNoVertex = emptyKey<Vertex>();
+
+private:
+    static constexpr unsigned kBits = 5;
+    static constexpr size_t kFan = size_t(1) << kBits;
+
+    struct Row {
+        Vertex id;
+        Neighbors adj;
+        uint64_t edit;
+    };
+
+    struct Node {
+        uint64_t edit;
+        std::array<std::shared_ptr<Node>, kFan> kids;
+        std::array<std::shared_ptr<Row>, kFan> rows;
+    };
+
+    // Insert-only id -> slot table shared by the writer and all snapshots. The
+    // writer fills free cells in place (value first, key released last); when the
+    // table gets full it moves to a bigger copy and older snapshots keep the old one.
+    struct IdTable {
+        explicit IdTable(size_t capacity)
+            : keys(new std::atomic<Vertex>[capacity]), values(new std::atomic<Slot>[capacity]),
+              mask(capacity - 1), shift(64 - __builtin_ctzll(capacity)) {
+            for (size_t i = 0; i < capacity; ++i) keys[i].store(kNoVertex, std::memory_order_relaxed);
+        }
+
+        const std::atomic<Slot>* find(Vertex v) const {
+            for (size_t i = flatHash(v, shift);; i = (i + 1) & mask) {
+                Vertex k = keys[i].load(std::memory_order_acquire);
+                if (k == v) return &values[i];
+                if (k == kNoVertex) return nullptr;
+            }
+        }
+
+        void insert(Vertex v, Slot s) {
+            size_t i = flatHash(v, shift);
+            while (keys[i].load(std::memory_order_relaxed) != kNoVertex) i = (i + 1) & mask;
+            values[i].store(s, std::memory_order_relaxed);
+            keys[i].store(v, std::memory_order_release);
+        }
+
+        std::unique_ptr<std::atomic<Vertex>[]> keys;
+        std::unique_ptr<std::atomic<Slot>[]> values;
+        size_t mask;
+        unsigned shift;
+    };
+
+public:
+    using Visitor = BasicGraphVisitor<Vertex>;
+
+    // Immutable view of the graph as of one commit(). Satisfies the interface
+    // GraphMetrics expects, so metrics run on it directly.
+    class Snapshot {
+    public:
+        using Vertex = V;
+        using Slot = BasicVersionedGraph::Slot;
+        using Neighbors = BasicVersionedGraph::Neighbors;
+        using Visitor = BasicGraphVisitor<Vertex>;
+        static constexpr Vertex kNoVertex = BasicVersionedGraph::kNoVertex;
+
+        bool hasVertex(Vertex v) const { Slot s; return lookup(v, s); }
+        bool hasEdge(Vertex u, Vertex v) const {
+            Slot s;
+            return lookup(u, s) && row(s).adj.count(v);
+        }
+
+        const Neighbors& neighbors(Vertex v) const {
+            Slot s;
+            if (!lookup(v, s)) throw std::out_of_range("VersionedGraph::neighbors: unknown vertex");
+            return row(s).adj;
+        }
+
+        std::vector<Vertex> getVertices() const {
+            std::vector<Vertex> out;
+            out.reserve(count);
+            collect(root.get(), depth, out);
+            return out;
+        }
+
+        size_t vertexCount() const { return count; }
+        size_t edgeCount() const { return degreeSum / 2; }
+        uint64_t version() const { return edit; }
+
+        void dfs(Vertex start, Visitor& visitor, std::set<Vertex>& visited) const {
+            visited.insert(start);
+            visitor.discoverVertex(start);
+            for (auto neighbor : neighbors(start)) {
+                visitor.examineEdge(start, neighbor);
+                if (visited.find(neighbor) == visited.end()) {
+                    dfs(neighbor, visitor, visited);
+                }
+            }
+            visitor.finishVertex(start);
+        }
+
+    private:
+        friend class BasicVersionedGraph;
+
+        // The writer may already have added ids past this snapshot; those slots are >= count.
+        bool lookup(Vertex v, Slot& s) const {
+            if (!table || v == kNoVertex) return false;
+            auto cell = table->find(v);
+            if (!cell) return false;
+            s = cell->load(std::memory_order_relaxed);
+            return s < count;
+        }
+
+        const Row& row(Slot s) const {
+            const Node* node = root.get();
+            for (unsigned level = depth; level > 0; --level)
+                node = node->kids[(s >> (level * kBits)) & (kFan - 1)].get();
+            return *node->rows[s & (kFan - 1)];
+        }
+
+        static void collect(const Node* node, unsigned level, std::vector<Vertex>& out) {
+            if (!node) return;
+            for (size_t i = 0; i < kFan; ++i) {
+                if (level) collect(node->kids[i].get(), level - 1, out);
+                else if (node->rows[i]) out.push_back(node->rows[i]->id);
+            }
+        }
+
+        std::shared_ptr<const Node> root;
+        std::shared_ptr<const IdTable> table;
+        unsigned depth = 0;
+        size_t count = 0, degreeSum = 0;
+        uint64_t edit = 0;
+    };
+
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    BasicVersionedGraph() : published(std::make_shared<const Snapshot>()) {}
+    BasicVersionedGraph(const BasicVersionedGraph&) = delete;
+    BasicVersionedGraph& operator=(const BasicVersionedGraph&) = delete;
+
+    // Writer side: one thread at a time. Changes become visible on commit().
+    void addVertex(Vertex v) { slotOf(v); }
+
+    void addEdge(Vertex u, Vertex v) {
+        Slot su = slotOf(u), sv = slotOf(v);
+        if (!row(su).adj.count(v)) { ownRow(su).adj.insert(v); degreeSum++; }
+        if (u != v && !row(sv).adj.count(u)) { ownRow(sv).adj.insert(u); degreeSum++; }
+    }
+
+    size_t vertexCount() const { return count; }
+    size_t edgeCount() const { return degreeSum / 2; }
+
+    // Publishes everything written so far and returns it as a snapshot.
+    SnapshotPtr commit() {
+        auto s = std::make_shared<Snapshot>();
+        s->root = root;
+        s->table = table;
+        s->depth = depth;
+        s->count = count;
+        s->degreeSum = degreeSum;
+        s->edit = edit++;
+        SnapshotPtr snap = std::move(s);
+        std::atomic_store(&published, snap);
+        return snap;
+    }
+
+    // Reader side: latest committed snapshot, safe to call from any thread.
+    SnapshotPtr snapshot() const { return std::atomic_load(&published); }
+
+private:
+    Slot slotOf(Vertex v) {
+        if (v == kNoVertex) throw std::invalid_argument("VersionedGraph: reserved vertex id");
+        if (table) {
+            if (auto cell = table->find(v)) return cell->load(std::memory_order_relaxed);
+        }
+        Slot s = (Slot)count;
+        if (!table || (count + 1) * 10 > (table->mask + 1) * 7) grow();
+        table->insert(v, s);
+        appendRow(v);
+        return s;
+    }
+
+    void grow() {
+        size_t capacity = table ? 2 * (table->mask + 1) : 64;
+        auto bigger = std::make_shared<IdTable>(capacity);
+        if (table) {
+            for (size_t i = 0; i <= table->mask; ++i) {
+                Vertex k = table->keys[i].load(std::memory_order_relaxed);
+                if (k != kNoVertex) bigger->insert(k, table->values[i].load(std::memory_order_relaxed));
+            }
+        }
+        table = std::move(bigger);
+    }
+
+    // Returns `ref` as a node of the current generation, copying it if a snapshot may share it.
+    Node* own(std::shared_ptr<Node>& ref) {
+        if (!ref) ref = std::make_shared<Node>();
+        else if (ref->edit != edit) ref = std::make_shared<Node>(*ref);
+        ref->edit = edit;
+        return ref.get();
+    }
+
+    std::shared_ptr<Row>& leafRef(Slot s) {
+        Node* node = own(root);
+        for (unsigned level = depth; level > 0; --level)
+            node = own(node->kids[(s >> (level * kBits)) & (kFan - 1)]);
+        return node->rows[s & (kFan - 1)];
+    }
+
+    void appendRow(Vertex v) {
+        if (count == (size_t(1) << ((depth + 1) * kBits))) {
+            auto top = std::make_shared<Node>();
+            top->edit = edit;
+            top->kids[0] = std::move(root);
+            root = std::move(top);
+            depth++;
+        }
+        auto& ref = leafRef((Slot)count++);
+        ref = std::make_shared<Row>();
+        ref->id = v;
+        ref->edit = edit;
+    }
+
+    Row& ownRow(Slot s) {
+        auto& ref = leafRef(s);
+        if (ref->edit != edit) {
+            ref = std::make_shared<Row>(*ref);
+            ref->edit = edit;
+        }
+        return *ref;
+    }
+
+    const Row& row(Slot s) const {
+        const Node* node = root.get();
+        for (unsigned level = depth; level > 0; --level)
+            node = node->kids[(s >> (level * kBits)) & (kFan - 1)].get();
+        return *node->rows[s & (kFan - 1)];
+    }
+
+    std::shared_ptr<Node> root;
+    std::shared_ptr<IdTable> table;
+    unsigned depth = 0;
+    size_t count = 0, degreeSum = 0;
+    uint64_t edit = 1;
+    SnapshotPtr published;
+};
+
+using VersionedGraph = BasicVersionedGraph<>;
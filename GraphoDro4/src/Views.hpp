@@ -0,0 +1,361 @@
+#pragma once
+#include "Graph.hpp"
+#include "Parallel.hpp"
+#include <functional>
+#include <queue>
+
+// Non-owning graph views. Each view keeps references to the graphs it wraps and
+// computes neighbors() lazily, so GraphMetrics runs on it without building a new
+// Graph. The wrapped graphs must outlive the view and must not change under it.
+// A view exposes the same interface as Graph (Vertex, kNoVertex, Visitor,
+// getVertices, neighbors, hasVertex, hasEdge, vertexCount, edgeCount, dfs).
+
+template <class G>
+using NeighborIterator = decltype(std::declval<const G&>().neighbors(std::declval<typename G::Vertex>()).begin());
+
+// Common part of all views: everything that can be derived from getVertices() and neighbors().
+template <class Derived, class V>
+class GraphView {
+public:
+    using Vertex = V;
+    using Visitor = BasicGraphVisitor<Vertex>;
+    static constexpr Vertex kNoVertex = emptyKey<Vertex>();
+
+    size_t vertexCount() const { return self().getVertices().size(); }
+
+    size_t edgeCount() const {
+        size_t sum = 0;
+        for (Vertex v : self().getVertices()) sum += self().neighbors(v).size();
+        return sum / 2;
+    }
+
+    bool isLeaf(Vertex v) const { return self().hasVertex(v) && self().neighbors(v).size() == 1; }
+
+    void dfs(Vertex start, Visitor& visitor, std::set<Vertex>& visited) const {
+        visited.insert(start);
+        visitor.discoverVertex(start);
+        for (auto neighbor : self().neighbors(start)) {
+            visitor.examineEdge(start, neighbor);
+            if (visited.find(neighbor) == visited.end()) {
+                dfs(neighbor, visitor, visited);
+            }
+        }
+        visitor.finishVertex(start);
+    }
+
+private:
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+// Walks [first, last) of an underlying neighbour range, skipping entries the owning
+// view rejects and translating the rest. size() is O(degree).
+template <class View, class It>
+class FilteredNeighbors {
+public:
+    using Vertex = typename View::Vertex;
+
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(It cur, It last, const View* view, Vertex from) : cur(cur), last(last), view(view), from(from) { skip(); }
+        Vertex operator*() const { return view->translate(*cur); }
+        iterator& operator++() { ++cur; skip(); return *this; }
+        bool operator==(const iterator& o) const { return cur == o.cur; }
+        bool operator!=(const iterator& o) const { return cur != o.cur; }
+
+    private:
+        void skip() { while (cur != last && !view->keep(from, *cur)) ++cur; }
+        It cur{}, last{};
+        const View* view = nullptr;
+        Vertex from{};
+    };
+
+    FilteredNeighbors(It first, It last, const View* view, Vertex from) : first(first), last(last), view(view), from(from) {}
+
+    iterator begin() const { return iterator(first, last, view, from); }
+    iterator end() const { return iterator(last, last, view, from); }
+    size_t size() const {
+        size_t n = 0;
+        for (auto it = begin(), e = end(); it != e; ++it) n++;
+        return n;
+    }
+    bool empty() const { return begin() == end(); }
+
+private:
+    It first, last;
+    const View* view;
+    Vertex from;
+};
+
+// Vertices of both graphs; an edge exists if it exists in either. Neighbours of v
+// are those of v in A followed by those in B that A does not already have.
+template <class A, class B>
+class UnionView : public GraphView<UnionView<A, B>, typename A::Vertex> {
+    static_assert(std::is_same<typename A::Vertex, typename B::Vertex>::value, "UnionView: vertex types differ");
+public:
+    using Vertex = typename A::Vertex;
+
+    class Neighbors {
+    public:
+        using ItA = NeighborIterator<A>;
+        using ItB = NeighborIterator<B>;
+
+        class iterator {
+        public:
+            iterator() = default;
+            iterator(ItA a, ItA aEnd, ItB b, ItB bEnd, const A* first, Vertex from)
+                : a(a), aEnd(aEnd), b(b), bEnd(bEnd), first(first), from(from) { skip(); }
+            Vertex operator*() const { return a != aEnd ? *a : *b; }
+            iterator& operator++() {
+                if (a != aEnd) ++a; else ++b;
+                skip();
+                return *this;
+            }
+            bool operator==(const iterator& o) const { return a == o.a && b == o.b; }
+            bool operator!=(const iterator& o) const { return !(*this == o); }
+
+        private:
+            void skip() {
+                if (a != aEnd) return;
+                while (b != bEnd && first && first->hasEdge(from, *b)) ++b;
+            }
+            ItA a{}, aEnd{};
+            ItB b{}, bEnd{};
+            const A* first = nullptr;
+            Vertex from{};
+        };
+
+        Neighbors(ItA a, ItA aEnd, ItB b, ItB bEnd, const A* first, Vertex from)
+            : a(a), aEnd(aEnd), b(b), bEnd(bEnd), first(first), from(from) {}
+
+        iterator begin() const { return iterator(a, aEnd, b, bEnd, first, from); }
+        iterator end() const { return iterator(aEnd, aEnd, bEnd, bEnd, first, from); }
+        size_t size() const {
+            size_t n = 0;
+            for (auto it = begin(), e = end(); it != e; ++it) n++;
+            return n;
+        }
+        bool empty() const { return begin() == end(); }
+
+    private:
+        ItA a, aEnd;
+        ItB b, bEnd;
+        const A* first;
+        Vertex from;
+    };
+
+    UnionView(const A& a, const B& b) : a(a), b(b) {}
+
+    std::vector<Vertex> getVertices() const {
+        auto res = a.getVertices();
+        for (Vertex v : b.getVertices()) if (!a.hasVertex(v)) res.push_back(v);
+        return res;
+    }
+
+    bool hasVertex(Vertex v) const { return a.hasVertex(v) || b.hasVertex(v); }
+    bool hasEdge(Vertex u, Vertex v) const { return a.hasEdge(u, v) || b.hasEdge(u, v); }
+
+    Neighbors neighbors(Vertex v) const {
+        bool inA = a.hasVertex(v), inB = b.hasVertex(v);
+        if (!inA && !inB) throw std::out_of_range("UnionView::neighbors: unknown vertex");
+        typename Neighbors::ItA aFirst{}, aLast{};
+        typename Neighbors::ItB bFirst{}, bLast{};
+        if (inA) { auto&& r = a.neighbors(v); aFirst = r.begin(); aLast = r.end(); }
+        if (inB) { auto&& r = b.neighbors(v); bFirst = r.begin(); bLast = r.end(); }
+        return Neighbors(aFirst, aLast, bFirst, bLast, inA ? &a : nullptr, v);
+    }
+
+private:
+    const A& a;
+    const B& b;
+};
+
+// Subgraph induced by the vertices for which keepVertex(v) holds.
+template <class G, class Pred>
+class InducedSubgraphView : public GraphView<InducedSubgraphView<G, Pred>, typename G::Vertex> {
+public:
+    using Vertex = typename G::Vertex;
+    using Neighbors = FilteredNeighbors<InducedSubgraphView, NeighborIterator<G>>;
+
+    InducedSubgraphView(const G& g, Pred keepVertex) : g(g), keepVertex(std::move(keepVertex)) {}
+
+    std::vector<Vertex> getVertices() const {
+        std::vector<Vertex> res;
+        for (Vertex v : g.getVertices()) if (keepVertex(v)) res.push_back(v);
+        return res;
+    }
+
+    bool hasVertex(Vertex v) const { return g.hasVertex(v) && keepVertex(v); }
+    bool hasEdge(Vertex u, Vertex v) const { return keepVertex(u) && keepVertex(v) && g.hasEdge(u, v); }
+
+    Neighbors neighbors(Vertex v) const {
+        if (!keepVertex(v)) throw std::out_of_range("InducedSubgraphView::neighbors: unknown vertex");
+        auto&& r = g.neighbors(v);
+        return Neighbors(r.begin(), r.end(), this, v);
+    }
+
+    bool keep(Vertex, Vertex u) const { return keepVertex(u); }
+    Vertex translate(Vertex u) const { return u; }
+
+private:
+    const G& g;
+    Pred keepVertex;
+};
+
+// All vertices of g, only the edges for which keepEdge(u, v) holds. The predicate
+// must be symmetric.
+template <class G, class Pred>
+class EdgeFilterView : public GraphView<EdgeFilterView<G, Pred>, typename G::Vertex> {
+public:
+    using Vertex = typename G::Vertex;
+    using Neighbors = FilteredNeighbors<EdgeFilterView, NeighborIterator<G>>;
+
+    EdgeFilterView(const G& g, Pred keepEdge) : g(g), keepEdge(std::move(keepEdge)) {}
+
+    std::vector<Vertex> getVertices() const { return g.getVertices(); }
+    bool hasVertex(Vertex v) const { return g.hasVertex(v); }
+    bool hasEdge(Vertex u, Vertex v) const { return g.hasEdge(u, v) && keepEdge(u, v); }
+
+    Neighbors neighbors(Vertex v) const {
+        auto&& r = g.neighbors(v);
+        return Neighbors(r.begin(), r.end(), this, v);
+    }
+
+    bool keep(Vertex v, Vertex u) const { return keepEdge(v, u); }
+    Vertex translate(Vertex u) const { return u; }
+
+private:
+    const G& g;
+    Pred keepEdge;
+};
+
+// g with every id v shown as to(v); from must be the inverse of to.
+template <class G, class To, class From>
+class RelabeledView : public GraphView<RelabeledView<G, To, From>, typename G::Vertex> {
+public:
+    using Vertex = typename G::Vertex;
+    using Neighbors = FilteredNeighbors<RelabeledView, NeighborIterator<G>>;
+
+    RelabeledView(const G& g, To to, From from) : g(g), to(std::move(to)), from(std::move(from)) {}
+
+    std::vector<Vertex> getVertices() const {
+        auto res = g.getVertices();
+        for (auto& v : res) v = to(v);
+        return res;
+    }
+
+    bool hasVertex(Vertex v) const { return g.hasVertex(from(v)); }
+    bool hasEdge(Vertex u, Vertex v) const { return g.hasEdge(from(u), from(v)); }
+
+    Neighbors neighbors(Vertex v) const {
+        auto&& r = g.neighbors(from(v));
+        return Neighbors(r.begin(), r.end(), this, v);
+    }
+
+    bool keep(Vertex, Vertex) const { return true; }
+    Vertex translate(Vertex u) const { return to(u); }
+
+private:
+    const G& g;
+    To to;
+    From from;
+};
+
+class GraphViews {
+public:
+    template <class A, class B>
+    static UnionView<A, B> Union(const A& a, const B& b) { return UnionView<A, B>(a, b); }
+
+    template <class G, class Pred>
+    static InducedSubgraphView<G, Pred> Induced(const G& g, Pred keepVertex) {
+        return InducedSubgraphView<G, Pred>(g, std::move(keepVertex));
+    }
+
+    // bits[v] selects vertex v; ids outside the bitmap are dropped. The view owns
+    // its copy of the bitmap, so a temporary is fine.
+    template <class G>
+    static auto InducedBitmap(const G& g, std::vector<bool> bits) {
+        using V = typename G::Vertex;
+        auto owned = std::make_shared<std::vector<bool>>(std::move(bits));
+        return Induced(g, [owned](V v) { return v >= V(0) && (size_t)v < owned->size() && (*owned)[v]; });
+    }
+
+    // Connected component of `start`; only the component's vertex set is stored.
+    template <class G>
+    static auto Component(const G& g, typename G::Vertex start) {
+        using V = typename G::Vertex;
+        auto members = std::make_shared<FlatHashSet<V>>();
+        std::queue<V> q;
+        members->insert(start);
+        q.push(start);
+        while (!q.empty()) {
+            V v = q.front(); q.pop();
+            for (V u : g.neighbors(v)) if (members->insert(u)) q.push(u);
+        }
+        return Induced(g, [members](V v) { return members->contains(v); });
+    }
+
+    template <class G, class Pred>
+    static EdgeFilterView<G, Pred> EdgeFilter(const G& g, Pred keepEdge) {
+        return EdgeFilterView<G, Pred>(g, std::move(keepEdge));
+    }
+
+    template <class G, class To, class From>
+    static RelabeledView<G, To, From> Relabel(const G& g, To to, From from) {
+        return RelabeledView<G, To, From>(g, std::move(to), std::move(from));
+    }
+
+    // Physical copy of any graph or view, weights included when the source is a
+    // weighted graph. Neighbour rows are evaluated in parallel (that is where lazy
+    // views spend their time) and stored in parallel by BasicGraph::fromRows; only
+    // the vertex slots are assigned in order.
+    template <class Out = Graph, class G>
+    static Out Materialize(const G& g, unsigned threads = 0) {
+        using V = typename G::Vertex;
+        return build<Out>(g, isWeighted(g), [&g](V v, V u) { return weightOf(g, v, u); }, threads);
+    }
+
+    // Parallel replacement for a.merge(b) that leaves both inputs untouched. As
+    // with merge, an edge takes its weight from b when b is weighted, else from a.
+    template <class Out = Graph, class A, class B>
+    static Out Merge(const A& a, const B& b, unsigned threads = 0) {
+        using V = typename A::Vertex;
+        auto weight = [&a, &b](V v, V u) {
+            return isWeighted(b) && b.hasEdge(v, u) ? weightOf(b, v, u) : a.hasEdge(v, u) ? weightOf(a, v, u) : 1.0;
+        };
+        return build<Out>(Union(a, b), isWeighted(a) || isWeighted(b), weight, threads);
+    }
+
+private:
+    template <class G>
+    static bool isWeighted(const G& g) {
+        if constexpr (HasEdgeWeights<G>::value) return g.isWeighted();
+        else return false;
+    }
+
+    template <class G>
+    static double weightOf(const G& g, typename G::Vertex v, typename G::Vertex u) {
+        if constexpr (HasEdgeWeights<G>::value) return g.weight(v, u);
+        else return 1.0;
+    }
+
+    template <class Out, class G, class Weight>
+    static Out build(const G& g, bool weighted, Weight weight, unsigned threads) {
+        using V = typename G::Vertex;
+        auto vertices = g.getVertices();
+        if (!weighted) {
+            std::vector<std::vector<V>> rows(vertices.size());
+            Parallel::forRange(0, vertices.size(), [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i)
+                    for (V u : g.neighbors(vertices[i])) rows[i].push_back(u);
+            }, threads);
+            return Out::fromRows(vertices, rows, threads);
+        }
+        std::vector<std::vector<std::pair<V, double>>> rows(vertices.size());
+        Parallel::forRange(0, vertices.size(), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i)
+                for (V u : g.neighbors(vertices[i])) rows[i].push_back({u, weight(vertices[i], u)});
+        }, threads);
+        return Out::fromRows(vertices, rows, threads);
+    }
+};
@@ -1,129 +1,542 @@
-#include <iostream>
-#include <string>
-#include <fstream>
-#include "Graph.hpp"
-#include "Generators.hpp"
-#include "Metrics.hpp"
-#include "IO.hpp"
-
-void printMenu() {
-    std::cout << "\n========== GraphoDro4 CLI ==========\n"
-              << "1. Generate Graph (Choose from 12 types)\n"
-              << "2. Load Graph from Console/File (EdgeList/Matrix/DIMACS)\n"
-              << "3. Calculate All Metrics (8 types)\n"
-              << "4. Export to GraphViz (DOT) with Spanning Tree\n"
-              << "5. Export to GraphViz (DOT) with Random Cycle\n"
-              << "6. Export to Progr@m4You (.edges)\n"
-              << "7. Exit\n"
-              << "====================================\n"
-              << "Choose an option: ";
-}
-
-int main() {
-    Graph currentGraph;
-    bool hasGraph = false;
-    int choice;
-
-    std::cout << "Welcome to GraphoDro4! (Level 8 Edition)\n";
-
-    while (true) {
-        printMenu();
-        if (!(std::cin >> choice)) {
-            std::cin.clear(); std::cin.ignore(10000, '\n'); continue;
-        }
-
-        if (choice == 1) {
-            std::cout << "\n--- Select Generator ---\n"
-                      << "1. Complete (Kn)\n"
-                      << "2. Complete Bipartite (Kn,m)\n"
-                      << "3. Star (Sn)\n"
-                      << "4. Cycle (Cn)\n"
-                      << "5. Path (Pn)\n"
-                      << "6. Wheel (Wn)\n"
-                      << "7. Random (Gnp)\n"
-                      << "8. With Connected Components\n"
-                      << "9. With Bridges\n"
-                      << "10. Cubic\n"
-                      << "11. With Articulation Points\n"
-                      << "12. With 2-Bridges\n"
-                      << "Choose (1-12): ";
-            
-            int genChoice;
-            if (!(std::cin >> genChoice)) { std::cin.clear(); std::cin.ignore(10000, '\n'); continue; }
-
-            int n;
-            std::cout << "Enter primary number of vertices (n): ";
-            std::cin >> n;
-
-            if (genChoice == 1) currentGraph = GraphGenerator::Complete(n);
-            else if (genChoice == 2) { 
-                int m; std::cout << "Enter m: "; std::cin >> m; 
-                currentGraph = GraphGenerator::CompleteBipartite(n, m); 
-            }
-            else if (genChoice == 3) currentGraph = GraphGenerator::Star(n);
-            else if (genChoice == 4) currentGraph = GraphGenerator::Cycle(n);
-            else if (genChoice == 5) currentGraph = GraphGenerator::Path(n);
-            else if (genChoice == 6) currentGraph = GraphGenerator::Wheel(n);
-            else if (genChoice == 7) { 
-                double p; std::cout << "Enter probability p (0.0 to 1.0): "; std::cin >> p; 
-                currentGraph = GraphGenerator::Random(n, p); 
-            }
-            else if (genChoice == 8) { 
-                int k; std::cout << "Enter number of components (k): "; std::cin >> k; 
-                currentGraph = GraphGenerator::WithConnectedComponents(n, k); 
-            }
-            else if (genChoice == 9) { 
-                int b; std::cout << "Enter number of bridges (b): "; std::cin >> b; 
-                currentGraph = GraphGenerator::WithBridges(n, b); 
-            }
-            else if (genChoice == 10) currentGraph = GraphGenerator::Cubic(n);
-            else if (genChoice == 11) { 
-                int k; std::cout << "Enter number of articulation points (k): "; std::cin >> k; 
-                currentGraph = GraphGenerator::WithArticulationPoints(n, k); 
-            }
-            else if (genChoice == 12) currentGraph = GraphGenerator::With2Bridges(n);
-            else { std::cout << "[!] Invalid generator choice.\n"; continue; }
-
-            hasGraph = true;
-            std::cout << "[OK] Generated graph with " << currentGraph.vertexCount() << " vertices and " << currentGraph.edgeCount() << " edges.\n";
-        } 
-        else if (choice == 2) {
-            std::cout << "Select format (1 - EdgeList, 2 - Matrix, 3 - DIMACS):\nChoice: ";
-            int fmt; std::cin >> fmt;
-            std::cout << "Paste graph data and type 'END' on a new line:\n";
-            std::stringstream ss; std::string line;
-            while (std::cin >> line && line != "END") ss << line << "\n";
-            
-            if (fmt == 1) currentGraph = EdgeListParser::parse(ss);
-            else if (fmt == 2) currentGraph = MatrixParser::parse(ss);
-            else if (fmt == 3) currentGraph = DimacsParser::parse(ss);
-            
-            hasGraph = true;
-            std::cout << "[OK] Loaded Graph with " << currentGraph.edgeCount() << " edges.\n";
-        }
-        else if (choice == 3 && hasGraph) {
-            std::cout << "\n--- Graph Metrics ---\n"
-                      << "1. Density:                 " << GraphMetrics::Density(currentGraph) << "\n"
-                      << "2. Diameter:                " << GraphMetrics::Diameter(currentGraph) << "\n"
-                      << "3. Transitivity:            " << GraphMetrics::Transitivity(currentGraph) << "\n"
-                      << "4. Connected Components:    " << GraphMetrics::ConnectedComponents(currentGraph) << "\n"
-                      << "5. Bridges (Random Alg):    " << GraphMetrics::CountBridgesRandomized(currentGraph) << "\n"
-                      << "6. Artic. Points (DFS):     " << GraphMetrics::CountArticulationPoints(currentGraph) << "\n"
-                      << "7. Bipartite:               " << (GraphMetrics::IsBipartite(currentGraph) ? "Yes" : "No") << "\n"
-                      << "8. Greedy Chromatic Bound:  " << GraphMetrics::GreedyColoring(currentGraph) << "\n";
-        } 
-        else if (choice == 4 && hasGraph) {
-            std::cout << "\n" << GraphVizSerializer::serialize(currentGraph, GraphVizSerializer::SPANNING_TREE) << "\n";
-        }
-        else if (choice == 5 && hasGraph) {
-            std::cout << "\n" << GraphVizSerializer::serialize(currentGraph, GraphVizSerializer::RANDOM_CYCLE) << "\n";
-        }
-        else if (choice == 6 && hasGraph) {
-            std::cout << "\n--- Progr@m4You Format ---\n"
-                      << Program4YouSerializer::serialize(currentGraph) << "\n";
-        }
-        else if (choice == 7) break;
-        else if (!hasGraph) std::cout << "[!] Generate or load a graph first!\n";
-    }
-    return 0;
-}
\ No newline at end of file
+#include <iostream>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <fstream>
+#include "Graph.hpp"
+#include "Generators.hpp"
+#include "Metrics.hpp"
+#include "IO.hpp"
+#include "Scheduler.hpp"
+#include "Streaming.hpp"
+#include "OutOfCore.hpp"
+#include "DistanceOracle.hpp"
+#include "TriangleEstimation.hpp"
+#include "PageRank.hpp"
+
+// Clique search nodes for "Calculate All Metrics", about a second with -O2;
+// past it the clique bound is the largest clique found.
+constexpr size_t kMetricsCliqueBudget = 2000000;
+
+void printMenu() {
+    std::cout << "\n========== GraphoDro4 CLI ==========\n"
+              << "1. Generate Graph (Choose from 12 types)\n"
+              << "2. Load Graph from Console/File (EdgeList/Matrix/DIMACS)\n"
+              << "3. Calculate All Metrics (17 types)\n"
+              << "4. Export to GraphViz (DOT) with Spanning Tree\n"
+              << "5. Export to GraphViz (DOT) with Cycles\n"
+              << "6. Export to Progr@m4You (.edges)\n"
+              << "7. Exit\n"
+              << "8. Stream Metrics from File (one pass, '-' = stdin)\n"
+              << "9. Out-of-Core Analysis of Edge File (BFS/Components/Degrees)\n"
+              << "10. Distance Queries (Pruned Landmark Labeling)\n"
+              << "11. Community Detection (Leiden/Louvain/Label Propagation)\n"
+              << "12. Approximate Triangles & Clustering (Wedge Sampling/DOULION)\n"
+              << "13. Motif Counts (k-Cliques, 4-Vertex Graphlets)\n"
+              << "14. Exact Maximum Clique & Chromatic Number\n"
+              << "15. Minimum Cut (Stoer-Wagner/Karger-Stein/s-t Max-Flow)\n"
+              << "16. Spectral Analysis (Fiedler Vector, Spectral Bisection)\n"
+              << "17. PageRank (Top-k, Personalized, Binary Export)\n"
+              << "====================================\n"
+              << "Choose an option: ";
+}
+
+std::string formatEstimate(const Estimate& e) {
+    std::stringstream ss;
+    ss << e.value;
+    if (e.low != e.high) ss << "  [" << e.low << ", " << e.high << "]";
+    return ss.str();
+}
+
+void printClustering(const ClusteringEstimate& e) {
+    std::cout << "Triangles:                  " << formatEstimate(e.triangles) << "\n"
+              << "Transitivity:               " << formatEstimate(e.transitivity) << "\n"
+              << "Average Clustering:         " << formatEstimate(e.averageClustering) << "\n";
+}
+
+void printStreamSummary(const StreamSummary& s) {
+    std::cout << "\n--- Streaming Metrics ---\n"
+              << "Vertices:                   " << s.vertices << "\n"
+              << "Edges (incl. duplicates):   " << s.edges << "\n"
+              << "Self-loops skipped:         " << s.selfLoops << "\n"
+              << "Density:                    " << s.density << "\n"
+              << "Connected Components:       " << s.components << "\n"
+              << "Bipartite:                  " << (s.bipartite ? "Yes" : "No") << "\n"
+              << "Max Degree:                 " << s.maxDegree << "\n"
+              << (s.triangleExact ? "Triangle statistics are exact.\n" : "Triangle statistics are estimates, 95% intervals:\n");
+    printClustering({s.triangles, s.transitivity, s.averageClustering});
+    std::cout << "Degree Histogram (degree: count):\n";
+    for (size_t d = 0; d < s.degreeHistogram.size(); ++d)
+        if (s.degreeHistogram[d]) std::cout << "  " << d << ": " << s.degreeHistogram[d] << "\n";
+}
+
+void runOutOfCore(const std::string& path, long long source) {
+    ShardedGraph g = ShardedGraph::Build(path);
+    size_t components = 0;
+    g.ConnectedComponents(&components);
+    auto degrees = g.Degrees();
+    size_t vertices = 0, maxDegree = 0;
+    for (auto d : degrees) if (d) { vertices++; maxDegree = std::max<size_t>(maxDegree, d); }
+    auto levels = g.BFS(source < 0 ? 0 : (ShardedGraph::Vertex)source);
+    size_t reached = 0;
+    uint32_t depth = 0;
+    for (auto l : levels) if (l != ShardedGraph::kUnreached) { reached++; depth = std::max(depth, l); }
+    std::cout << "\n--- Out-of-Core Metrics (" << g.shardCount() << " shards) ---\n"
+              << "Vertices:                   " << vertices << "\n"
+              << "Edges:                      " << g.edgeCount() << "\n"
+              << "Connected Components:       " << components << "\n"
+              << "Max Degree:                 " << maxDegree << "\n"
+              << "BFS from " << source << ": reached " << reached << " vertices, depth " << depth << "\n";
+}
+
+// Answers "s t" pairs read from `in`, one distance per line (-1 = unreachable).
+void runDistanceQueries(const DistanceOracle& oracle, std::istream& in) {
+    std::vector<std::pair<int, int>> queries;
+    int s, t;
+    while (in >> s >> t) queries.push_back({s, t});
+    std::vector<size_t> res;
+    try {
+        res = oracle.distances(queries);
+    } catch (const std::exception& e) {
+        std::cout << "[!] " << e.what() << "\n";
+        return;
+    }
+    for (size_t d : res) std::cout << (d == DistanceOracle::kUnreachable ? -1 : (long long)d) << "\n";
+}
+
+int main(int argc, char** argv) {
+    // Non-interactive mode for huge edge dumps: graph_app --stream <file|->
+    if (argc == 3 && std::string(argv[1]) == "--stream") {
+        std::ios::sync_with_stdio(false);
+        try {
+            printStreamSummary(StreamingAnalyzer::ProcessFile(argv[2], 1 << 20, 4));
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+    // graph_app --out-of-core <file|-> [bfs source]
+    if ((argc == 3 || argc == 4) && std::string(argv[1]) == "--out-of-core") {
+        std::ios::sync_with_stdio(false);
+        long long source = 0;
+        if (argc == 4) {
+            char* end = nullptr;
+            errno = 0;
+            source = std::strtoll(argv[3], &end, 10);
+            if (end == argv[3] || *end || errno == ERANGE) {
+                std::cerr << "invalid bfs source: " << argv[3] << "\n";
+                return 1;
+            }
+        }
+        try {
+            runOutOfCore(argv[2], source);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // graph_app --distance-index <edge list> <index file>
+    if (argc == 4 && std::string(argv[1]) == "--distance-index") {
+        std::ifstream in(argv[2]);
+        if (!in) { std::cerr << "cannot open " << argv[2] << "\n"; return 1; }
+        DistanceOracle oracle = DistanceOracle::FromGraph(EdgeListParser::parse(in));
+        oracle.save(argv[3]);
+        std::cout << "[OK] Indexed " << oracle.vertexCount() << " vertices with " << oracle.labelCount() << " labels.\n";
+        return 0;
+    }
+    // graph_app --distance-query <index file> <queries|->: batch mode, one "s t" pair per line
+    if (argc == 4 && std::string(argv[1]) == "--distance-query") {
+        std::ios::sync_with_stdio(false);
+        DistanceOracle oracle;
+        try {
+            oracle = DistanceOracle::Load(argv[2]);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        if (std::string(argv[3]) == "-") runDistanceQueries(oracle, std::cin);
+        else {
+            std::ifstream in(argv[3]);
+            if (!in) { std::cerr << "cannot open " << argv[3] << "\n"; return 1; }
+            runDistanceQueries(oracle, in);
+        }
+        return 0;
+    }
+
+    // graph_app --pagerank <edge list> <scores file> [k]: binary scores plus the top k on stdout
+    if ((argc == 4 || argc == 5) && std::string(argv[1]) == "--pagerank") {
+        std::ifstream in(argv[2]);
+        if (!in) { std::cerr << "cannot open " << argv[2] << "\n"; return 1; }
+        size_t k = 10;
+        if (argc == 5) {
+            char* end = nullptr;
+            errno = 0;
+            unsigned long long value = std::strtoull(argv[4], &end, 10);
+            if (end == argv[4] || *end || errno == ERANGE || argv[4][0] == '-') {
+                std::cerr << "invalid k: " << argv[4] << "\n";
+                return 1;
+            }
+            k = (size_t)value;
+        }
+        CompactGraph c = CompactGraph::fromGraph(EdgeListParser::parse(in));
+        PageRankResult rank = PageRank::Compute(c);
+        try {
+            PageRank::Save(argv[3], c, rank.score);
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        for (auto [v, score] : PageRank::TopK(rank.score, k)) std::cout << c.id(v) << " " << score << "\n";
+        return 0;
+    }
+
+    Graph currentGraph;
+    bool hasGraph = false;
+    int choice;
+
+    std::cout << "Welcome to GraphoDro4! (Level 8 Edition)\n";
+
+    while (true) {
+        printMenu();
+        if (!(std::cin >> choice)) {
+            std::cin.clear(); std::cin.ignore(10000, '\n'); continue;
+        }
+
+        if (choice == 1) {
+            std::cout << "\n--- Select Generator ---\n"
+                      << "1. Complete (Kn)\n"
+                      << "2. Complete Bipartite (Kn,m)\n"
+                      << "3. Star (Sn)\n"
+                      << "4. Cycle (Cn)\n"
+                      << "5. Path (Pn)\n"
+                      << "6. Wheel (Wn)\n"
+                      << "7. Random (Gnp)\n"
+                      << "8. With Connected Components\n"
+                      << "9. With Bridges\n"
+                      << "10. Cubic\n"
+                      << "11. With Articulation Points\n"
+                      << "12. With 2-Bridges\n"
+                      << "Choose (1-12): ";
+            
+            int genChoice;
+            if (!(std::cin >> genChoice)) { std::cin.clear(); std::cin.ignore(10000, '\n'); continue; }
+
+            int n;
+            std::cout << "Enter primary number of vertices (n): ";
+            std::cin >> n;
+
+            if (genChoice == 1) currentGraph = GraphGenerator::Complete(n);
+            else if (genChoice == 2) { 
+                int m; std::cout << "Enter m: "; std::cin >> m; 
+                currentGraph = GraphGenerator::CompleteBipartite(n, m); 
+            }
+            else if (genChoice == 3) currentGraph = GraphGenerator::Star(n);
+            else if (genChoice == 4) currentGraph = GraphGenerator::Cycle(n);
+            else if (genChoice == 5) currentGraph = GraphGenerator::Path(n);
+            else if (genChoice == 6) currentGraph = GraphGenerator::Wheel(n);
+            else if (genChoice == 7) { 
+                double p; std::cout << "Enter probability p (0.0 to 1.0): "; std::cin >> p; 
+                currentGraph = GraphGenerator::Random(n, p); 
+            }
+            else if (genChoice == 8) { 
+                int k; std::cout << "Enter number of components (k): "; std::cin >> k; 
+                currentGraph = GraphGenerator::WithConnectedComponents(n, k); 
+            }
+            else if (genChoice == 9) { 
+                int b; std::cout << "Enter number of bridges (b): "; std::cin >> b; 
+                currentGraph = GraphGenerator::WithBridges(n, b); 
+            }
+            else if (genChoice == 10) currentGraph = GraphGenerator::Cubic(n);
+            else if (genChoice == 11) { 
+                int k; std::cout << "Enter number of articulation points (k): "; std::cin >> k; 
+                currentGraph = GraphGenerator::WithArticulationPoints(n, k); 
+            }
+            else if (genChoice == 12) currentGraph = GraphGenerator::With2Bridges(n);
+            else { std::cout << "[!] Invalid generator choice.\n"; continue; }
+
+            hasGraph = true;
+            std::cout << "[OK] Generated graph with " << currentGraph.vertexCount() << " vertices and " << currentGraph.edgeCount() << " edges.\n";
+        } 
+        else if (choice == 2) {
+            std::cout << "Select format (1 - EdgeList, 2 - Matrix, 3 - DIMACS):\nChoice: ";
+            int fmt; std::cin >> fmt;
+            std::cout << "Paste graph data and type 'END' on a new line:\n";
+            std::stringstream ss; std::string line;
+            std::getline(std::cin, line); // rest of the format line
+            while (std::getline(std::cin, line)) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (line == "END") break;
+                ss << line << "\n";
+            }
+            
+            size_t malformed = 0;
+            if (fmt == 1) currentGraph = EdgeListParser::parse(ss, malformed);
+            else if (fmt == 2) currentGraph = MatrixParser::parse(ss);
+            else if (fmt == 3) currentGraph = DimacsParser::parse(ss);
+            
+            hasGraph = true;
+            std::cout << "[OK] Loaded " << (currentGraph.isWeighted() ? "weighted " : "") << "Graph with " << currentGraph.edgeCount() << " edges.\n";
+            if (malformed) std::cout << "[!] Skipped " << malformed << " malformed lines.\n";
+        }
+        else if (choice == 3 && hasGraph) {
+            const Graph& g = currentGraph;
+            double density = 0, transitivity = 0, radius = 0, fiedler = 0;
+            size_t diameter = 0, components = 0, bridges = 0, aps = 0, colors = 0, clique = 0, degeneracy = 0;
+            size_t cuts = 0, classes = 0, girth = 0, cycleRank = 0, lambda = 0, kappa = 0;
+            bool bipartite = false, cliqueExact = false;
+
+            TaskGroup metrics(TaskScheduler::instance());
+            metrics.run([&] { density = GraphMetrics::Density(g); });
+            metrics.run([&] { diameter = GraphMetrics::Diameter(g); });
+            metrics.run([&] { transitivity = GraphMetrics::Transitivity(g); });
+            metrics.run([&] { components = GraphMetrics::ConnectedComponents(g); });
+            metrics.run([&] { bridges = GraphMetrics::CountBridgesRandomized(g); });
+            metrics.run([&] { aps = GraphMetrics::CountArticulationPoints(g); });
+            metrics.run([&] { bipartite = GraphMetrics::IsBipartite(g); });
+            metrics.run([&] { colors = GraphMetrics::GreedyColoring(g); });
+            metrics.run([&] {
+                BasicClique<CompactGraph::Index> found = MaxClique::Bounded(CompactGraph::fromGraph(g), 0, kMetricsCliqueBudget);
+                clique = found.members.size();
+                cliqueExact = found.exact;
+            });
+            metrics.run([&] { degeneracy = GraphMetrics::Degeneracy(g); });
+            metrics.run([&] { cuts = GraphMetrics::Count2EdgeCuts(g); });
+            metrics.run([&] { classes = GraphMetrics::Count3EdgeConnectedClasses(g); });
+            metrics.run([&] { girth = GraphMetrics::Girth(g); });
+            metrics.run([&] { cycleRank = GraphMetrics::CycleRank(g); });
+            metrics.run([&] { lambda = GraphMetrics::EdgeConnectivity(g); });
+            metrics.run([&] { kappa = GraphMetrics::VertexConnectivity(g); });
+            metrics.run([&] { radius = GraphMetrics::SpectralRadius(g); });
+            metrics.run([&] { fiedler = GraphMetrics::AlgebraicConnectivity(g); });
+            metrics.wait();
+            auto spectral = [](double value) {
+                std::stringstream ss;
+                if (std::isnan(value)) ss << "not converged"; else ss << value;
+                return ss.str();
+            };
+
+            std::cout << "\n--- Graph Metrics ---\n"
+                      << "1. Density:                 " << density << "\n"
+                      << "2. Diameter:                " << diameter << "\n"
+                      << "3. Transitivity:            " << transitivity << "\n"
+                      << "4. Connected Components:    " << components << "\n"
+                      << "5. Bridges (Random Alg):    " << bridges << "\n"
+                      << "6. Artic. Points (DFS):     " << aps << "\n"
+                      << "7. Bipartite:               " << (bipartite ? "Yes" : "No") << "\n"
+                      << "8. Chromatic Bounds:        " << clique << (cliqueExact ? " (max clique)" : " (largest clique found, budget hit)")
+                      << " <= X <= " << colors << " (greedy)\n"
+                      << "9. Degeneracy (k-core):     " << degeneracy << "\n"
+                      << "10. 2-Edge Cuts (XOR):      " << cuts << "\n"
+                      << "11. 3-Edge-Conn. Classes:   " << classes << "\n"
+                      << "12. Girth:                  " << (girth ? std::to_string(girth) : "none (forest)") << "\n"
+                      << "13. Cycle Rank:             " << cycleRank << "\n"
+                      << "14. Edge Connectivity:      " << lambda << "\n"
+                      << "15. Vertex Connectivity:    " << kappa << "\n"
+                      << "16. Spectral Radius:        " << spectral(radius) << "\n"
+                      << "17. Algebraic Connectivity: " << spectral(fiedler) << "\n";
+            if (g.isWeighted())
+                std::cout << "18. Weighted Diameter:      " << GraphMetrics::WeightedDiameter(g) << "\n";
+        } 
+        else if (choice == 4 && hasGraph) {
+            std::cout << "Tree (1 - Uniform Random, 2 - Minimum Weight, 3 - BFS, 4 - DFS): ";
+            int tree; std::cin >> tree;
+            auto mode = tree == 2 ? GraphVizSerializer::MINIMUM_SPANNING_TREE
+                      : tree == 3 ? GraphVizSerializer::BFS_TREE
+                      : tree == 4 ? GraphVizSerializer::DFS_TREE : GraphVizSerializer::SPANNING_TREE;
+            std::cout << "\n" << GraphVizSerializer::serialize(currentGraph, mode) << "\n";
+        }
+        else if (choice == 5 && hasGraph) {
+            std::cout << "Cycles (1 - Random Cycle, 2 - Shortest Cycle, 3 - Minimum Cycle Basis): ";
+            int cycles; std::cin >> cycles;
+            auto mode = cycles == 2 ? GraphVizSerializer::SHORTEST_CYCLE
+                      : cycles == 3 ? GraphVizSerializer::CYCLE_BASIS : GraphVizSerializer::RANDOM_CYCLE;
+            std::cout << "\n" << GraphVizSerializer::serialize(currentGraph, mode) << "\n";
+        }
+        else if (choice == 6 && hasGraph) {
+            std::cout << "\n--- Progr@m4You Format ---\n"
+                      << Program4YouSerializer::serialize(currentGraph) << "\n";
+        }
+        else if (choice == 8) {
+            std::string path;
+            std::cout << "Enter edge list path ('-' for stdin): ";
+            std::cin >> path;
+            try {
+                printStreamSummary(StreamingAnalyzer::ProcessFile(path, 1 << 20, 4));
+            } catch (const std::exception& e) {
+                std::cout << "[!] " << e.what() << "\n";
+            }
+        }
+        else if (choice == 9) {
+            std::string path;
+            long long source;
+            std::cout << "Enter edge list path: ";
+            std::cin >> path;
+            std::cout << "Enter BFS source vertex: ";
+            std::cin >> source;
+            try {
+                runOutOfCore(path, source);
+            } catch (const std::exception& e) {
+                std::cout << "[!] " << e.what() << "\n";
+            }
+        }
+        else if (choice == 10 && hasGraph) {
+            DistanceOracle oracle = DistanceOracle::FromGraph(currentGraph);
+            std::cout << "[OK] Index built: " << oracle.labelCount() << " labels for " << oracle.vertexCount() << " vertices.\n"
+                      << "Enter pairs 's t' and type 'END' on a new line:\n";
+            std::stringstream ss; std::string line;
+            while (std::cin >> line && line != "END") ss << line << " ";
+            runDistanceQueries(oracle, ss);
+            std::string path;
+            std::cout << "Save index to file ('-' to skip): ";
+            std::cin >> path;
+            if (path != "-") {
+                try { oracle.save(path); std::cout << "[OK] Saved.\n"; }
+                catch (const std::exception& e) { std::cout << "[!] " << e.what() << "\n"; }
+            }
+        }
+        else if (choice == 11 && hasGraph) {
+            std::cout << "Method (1 - Leiden, 2 - Louvain, 3 - Label Propagation): ";
+            int method; std::cin >> method;
+            CompactGraph c = CompactGraph::fromGraph(currentGraph);
+            Communities found = method == 2 ? CommunityDetection::Louvain(c)
+                              : method == 3 ? CommunityDetection::LabelPropagation(c)
+                              : CommunityDetection::Leiden(c);
+            std::cout << "\n--- Communities ---\n"
+                      << "Communities:                " << found.count << "\n"
+                      << "Modularity:                 " << found.modularity << "\n"
+                      << (method == 3 ? "Sweeps:                     " : "Levels:                     ") << found.levels << "\n"
+                      << "Print DOT with community colors? (y/n): ";
+            std::string answer; std::cin >> answer;
+            if (answer == "y") std::cout << "\n" << GraphVizSerializer::serialize(currentGraph, c, found) << "\n";
+        }
+        else if (choice == 12 && hasGraph) {
+            std::cout << "Method (1 - Wedge Sampling, 2 - DOULION, 3 - Exact): ";
+            int method; std::cin >> method;
+            CompactGraph c = CompactGraph::fromGraph(currentGraph);
+            try {
+                if (method == 1) {
+                    size_t samples; std::cout << "Number of samples: "; std::cin >> samples;
+                    printClustering(TriangleEstimation::Wedges(c, samples));
+                } else if (method == 2) {
+                    double p; std::cout << "Edge keep probability p: "; std::cin >> p;
+                    size_t trials; std::cout << "Number of trials (>= 2): "; std::cin >> trials;
+                    printClustering(TriangleEstimation::Doulion(c, p, trials));
+                } else {
+                    printClustering(TriangleEstimation::Exact(c));
+                }
+            } catch (const std::exception& e) {
+                std::cout << "[!] " << e.what() << "\n";
+            }
+        }
+        else if (choice == 13 && hasGraph) {
+            unsigned maxK; std::cout << "Largest clique size k (3-8): "; std::cin >> maxK;
+            maxK = std::min(8u, std::max(3u, maxK));
+            CompactGraph c = CompactGraph::fromGraph(currentGraph);
+            auto cliques = Motifs::CliqueProfile(c, maxK);
+            GraphletCounts gl = Motifs::Graphlets(c);
+            std::cout << "\n--- Cliques ---\n";
+            for (unsigned k = 3; k <= maxK; ++k) std::cout << k << "-cliques:" << std::string(18, ' ') << cliques[k] << "\n";
+            std::cout << "\n--- Induced Graphlets ---\n"
+                      << "Open Wedges:                " << gl.wedges << "\n"
+                      << "Triangles:                  " << gl.triangles << "\n"
+                      << "3-Stars:                    " << gl.stars << "\n"
+                      << "4-Paths:                    " << gl.paths << "\n"
+                      << "Tailed Triangles:           " << gl.tailedTriangles << "\n"
+                      << "4-Cycles:                   " << gl.cycles << "\n"
+                      << "Diamonds:                   " << gl.diamonds << "\n"
+                      << "4-Cliques:                  " << gl.cliques << "\n";
+        }
+        else if (choice == 14 && hasGraph) {
+            size_t budget; std::cout << "Search node budget for clique and coloring (e.g. 10000000): "; std::cin >> budget;
+            CompactGraph c = CompactGraph::fromGraph(currentGraph);
+            BasicClique<CompactGraph::Index> clique = MaxClique::Bounded(c, 0, budget);
+            Coloring coloring = VertexColoring::Exact(c, 0, budget);
+            std::cout << "\n--- Clique & Coloring ---\n";
+            if (clique.exact) std::cout << "Maximum Clique Size:        " << clique.members.size() << "\nMaximum Clique:            ";
+            else std::cout << "Maximum Clique Size:        >= " << clique.members.size() << " (search budget exhausted)\n"
+                           << "Largest Clique Found:      ";
+            for (auto v : clique.members) std::cout << " " << c.id(v);
+            std::cout << "\n";
+            if (coloring.exact) std::cout << "Chromatic Number:           " << coloring.colors << "\n";
+            else std::cout << "Chromatic Number:           between " << coloring.lowerBound << " and " << coloring.colors
+                           << " (search budget exhausted)\n";
+            std::cout << "Color Classes:\n";
+            for (size_t k = 0; k < coloring.colors; ++k) {
+                std::cout << "  " << k << ":";
+                for (CompactGraph::Index v = 0; v < c.vertexCount(); ++v)
+                    if (coloring.color[v] == k) std::cout << " " << c.id(v);
+                std::cout << "\n";
+            }
+        }
+        else if (choice == 15 && hasGraph) {
+            std::cout << "Method (1 - Stoer-Wagner, 2 - Karger-Stein, 3 - s-t Cut by Dinic): ";
+            int method; std::cin >> method;
+            CompactGraph c = CompactGraph::fromGraph(currentGraph);
+            Cut cut;
+            if (method == 3) {
+                Graph::Vertex s, t; std::cout << "Source and sink vertices: "; std::cin >> s >> t;
+                if (!currentGraph.hasVertex(s) || !currentGraph.hasVertex(t)) { std::cout << "[!] Unknown vertex.\n"; continue; }
+                cut = Connectivity::MinimumCut(c, c.index(s), c.index(t));
+            } else {
+                cut = method == 2 ? Connectivity::KargerStein(c) : Connectivity::StoerWagner(c);
+            }
+            std::cout << "\n--- Minimum Cut ---\n"
+                      << "Cut Weight:                 " << cut.weight << "\n"
+                      << "Shore (" << cut.side.size() << " vertices):";
+            for (auto v : cut.side) std::cout << " " << c.id(v);
+            std::cout << "\n";
+        }
+        else if (choice == 16 && hasGraph) {
+            CompactGraph c = CompactGraph::fromGraph(currentGraph);
+            EigenPair radius = Spectral::SpectralRadius(c);
+            EigenPair fiedler = Spectral::Fiedler(c);
+            Cut halves = Spectral::Bisection(c, fiedler);
+            std::cout << "\n--- Spectral Analysis ---\n"
+                      << "Spectral Radius:            " << radius.value << (radius.converged ? "" : " (not converged)") << "\n"
+                      << "Algebraic Connectivity:     " << fiedler.value << (fiedler.converged ? "" : " (not converged)") << "\n"
+                      << "Lanczos Iterations:         " << radius.iterations << " / " << fiedler.iterations << "\n"
+                      << "Bisection Cut Weight:       " << halves.weight << "\n"
+                      << "Fiedler Vector (vertex: entry):\n";
+            for (CompactGraph::Index v = 0; v < c.vertexCount(); ++v)
+                std::cout << "  " << c.id(v) << ": " << fiedler.vector[v] << "\n";
+            std::cout << "Bisection Shore (" << halves.side.size() << " vertices):";
+            for (auto v : halves.side) std::cout << " " << c.id(v);
+            std::cout << "\n";
+        }
+        else if (choice == 17 && hasGraph) {
+            std::cout << "Mode (1 - Global, 2 - Personalized): ";
+            int mode; std::cin >> mode;
+            size_t k; std::cout << "Top k: "; std::cin >> k;
+            CompactGraph c = CompactGraph::fromGraph(currentGraph);
+            PageRankResult rank;
+            if (mode == 2) {
+                Graph::Vertex s; std::cout << "Source vertex: "; std::cin >> s;
+                if (!currentGraph.hasVertex(s)) { std::cout << "[!] Unknown vertex.\n"; continue; }
+                rank = PageRank::Personalized(c, c.index(s));
+            } else {
+                rank = PageRank::Compute(c);
+            }
+            std::cout << "\n--- PageRank ---\n"
+                      << (mode == 2 ? "Pushes:                     " : "Iterations:                 ") << rank.iterations
+                      << (rank.converged ? "" : " (not converged)") << "\n"
+                      << "Top " << k << " (vertex: score):\n";
+            for (auto [v, score] : PageRank::TopK(rank.score, k)) std::cout << "  " << c.id(v) << ": " << score << "\n";
+            std::string path; std::cout << "Binary scores file ('-' to skip): "; std::cin >> path;
+            if (path != "-") {
+                try {
+                    PageRank::Save(path, c, rank.score);
+                    std::cout << "[OK] Saved " << c.vertexCount() << " scores to " << path << "\n";
+                } catch (const std::exception& e) {
+                    std::cout << "[!] " << e.what() << "\n";
+                }
+            }
+        }
+        else if (choice == 7) break;
+        else if (!hasGraph) std::cout << "[!] Generate or load a graph first!\n";
+    }
+    return 0;
+}
@@ -1,48 +1,1437 @@
-#include <iostream>
-#include <cassert>
-#include "../src/Graph.hpp"
-#include "../src/Generators.hpp"
-#include "../src/Metrics.hpp"
-#include "../src/IO.hpp"
-
-void TestGenerators() {
-    Graph cubic = GraphGenerator::Cubic(6);
-    assert(cubic.vertexCount() == 6 && cubic.edgeCount() == 9);
-    
-    Graph apsGraph = GraphGenerator::WithArticulationPoints(8, 3);
-    assert(GraphMetrics::CountArticulationPoints(apsGraph) == 3);
-    
-    std::cout << "[OK] 12 Generators passed invariants.\n";
-}
-
-void TestMetrics() {
-    Graph c4 = GraphGenerator::Cycle(4);
-    assert(GraphMetrics::Diameter(c4) == 2);
-    assert(GraphMetrics::CountBridgesRandomized(c4) == 0);
-
-    std::cout << "[OK] 8 Metrics logic verified.\n";
-}
-
-void TestSerializers() {
-    Graph g = GraphGenerator::Cycle(5);
-    std::string dotCycle = GraphVizSerializer::serialize(g, GraphVizSerializer::RANDOM_CYCLE);
-    assert(dotCycle.find("color=\"blue\"") != std::string::npos);
-
-    std::string p4y = Program4YouSerializer::serialize(g);
-    assert(p4y.find("5 5") != std::string::npos);
-
-    std::stringstream dimacs("c comment\np edge 3 2\ne 0 1\ne 1 2\n");
-    Graph parsed = DimacsParser::parse(dimacs);
-    assert(parsed.edgeCount() == 2);
-
-    std::cout << "[OK] Parsers and Serializers tests passed.\n";
-}
-
-int main() {
-    std::cout << "Running GraphoDro4 Level 8 Tests...\n";
-    TestGenerators();
-    TestMetrics();
-    TestSerializers();
-    std::cout << "--- All tests passed successfully! ---\n";
-    return 0;
-}
\ No newline at end of file
+#include <iostream>
+#include <cassert>
+#include "../src/Graph.hpp"
+#include "../src/Generators.hpp"
+#include "../src/Metrics.hpp"
+#include "../src/IO.hpp"
+#include "../src/Cores.hpp"
+#include "../src/Betweenness.hpp"
+#include "../src/EdgeCuts.hpp"
+#include "../src/Scheduler.hpp"
+#include "../src/Streaming.hpp"
+#include "../src/OutOfCore.hpp"
+#include "../src/ConcurrentGraph.hpp"
+#include "../src/VersionedGraph.hpp"
+#include "../src/Views.hpp"
+#include "../src/ImplicitGraphs.hpp"
+#include "../src/DistanceOracle.hpp"
+#include "../src/ShortestPaths.hpp"
+#include "../src/SpanningTrees.hpp"
+#include "../src/Cycles.hpp"
+#include "../src/Communities.hpp"
+#include "../src/TriangleEstimation.hpp"
+#include "../src/Motifs.hpp"
+#include "../src/Coloring.hpp"
+#include "../src/MaximalSets.hpp"
+#include "../src/Connectivity.hpp"
+#include "../src/Spectral.hpp"
+#include "../src/Algebra.hpp"
+#include "../src/PageRank.hpp"
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <thread>
+
+void TestGenerators() {
+    Graph cubic = GraphGenerator::Cubic(6);
+    assert(cubic.vertexCount() == 6 && cubic.edgeCount() == 9);
+    
+    Graph apsGraph = GraphGenerator::WithArticulationPoints(8, 3);
+    assert(GraphMetrics::CountArticulationPoints(apsGraph) == 3);
+    
+    std::cout << "[OK] 12 Generators passed invariants.\n";
+}
+
+void TestGraphBackend() {
+    Graph hub;
+    for (int i = 1; i <= 100; ++i) { hub.addEdge(0, i); hub.addEdge(i, 0); }
+    hub.addEdge(7, 7);
+    assert(hub.vertexCount() == 101 && hub.edgeCount() == 100);
+    assert(hub.hasEdge(0, 64) && hub.hasEdge(64, 0) && !hub.hasEdge(1, 2) && hub.hasEdge(7, 7));
+    assert(hub.neighbors(0).size() == 100 && hub.isLeaf(3));
+
+    Graph copy = hub;
+    copy.addEdge(1, 2);
+    assert(copy.hasEdge(1, 2) && !hub.hasEdge(1, 2) && copy.neighbors(0).count(99));
+
+    bool threw = false;
+    try { hub.neighbors(1000); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+
+    std::cout << "[OK] Hash adjacency backend verified.\n";
+}
+
+void TestVertexWidths() {
+    // 64-bit ids far above 2^32 go through the same generators, parsers and metrics.
+    std::stringstream in("5000000000 5000000001\n5000000001 5000000002\n5000000002 5000000000\n5000000002 7\n");
+    Graph64 big = EdgeListParser::parse<Graph64>(in);
+    assert(big.vertexCount() == 4 && big.hasEdge(5000000000ull, 5000000002ull));
+    assert(GraphMetrics::Diameter(big) == 2 && GraphMetrics::CountBridgesRandomized(big) == 1);
+    assert(GraphMetrics::CountArticulationPoints(big) == 1 && GraphMetrics::Degeneracy(big) == 2);
+
+    Graph32 wheel = GraphGenerator::Wheel<Graph32>(7);
+    assert(wheel.edgeCount() == 12 && GraphMetrics::GreedyColoring(wheel) >= 3);
+    assert(GraphMetrics::Count2EdgeCuts(GraphGenerator::With2Bridges<Graph32>(8)) == 12);
+    static_assert(sizeof(CompactOf<Graph32>::Index) == 4 && sizeof(CompactOf<Graph32>::Offset) == 8, "32/64 layout");
+    static_assert(sizeof(BasicCompactGraph<uint64_t, uint64_t>::Index) == 8, "64/64 layout");
+
+    std::cout << "[OK] 32- and 64-bit vertex ids verified.\n";
+}
+
+void TestMetrics() {
+    Graph c4 = GraphGenerator::Cycle(4);
+    assert(GraphMetrics::Diameter(c4) == 2);
+    assert(GraphMetrics::CountBridgesRandomized(c4) == 0);
+
+    std::cout << "[OK] 8 Metrics logic verified.\n";
+}
+
+void TestSerializers() {
+    Graph g = GraphGenerator::Cycle(5);
+    std::string dotCycle = GraphVizSerializer::serialize(g, GraphVizSerializer::RANDOM_CYCLE);
+    assert(dotCycle.find("color=\"blue\"") != std::string::npos);
+
+    std::string p4y = Program4YouSerializer::serialize(g);
+    assert(p4y.find("5 5") != std::string::npos);
+
+    std::stringstream dimacs("c comment\np edge 3 2\ne 0 1\ne 1 2\n");
+    Graph parsed = DimacsParser::parse(dimacs);
+    assert(parsed.edgeCount() == 2);
+
+    std::cout << "[OK] Parsers and Serializers tests passed.\n";
+}
+
+void TestCores() {
+    assert(GraphMetrics::Degeneracy(GraphGenerator::Complete(6)) == 5);
+    assert(GraphMetrics::Degeneracy(GraphGenerator::Star(7)) == 1);
+
+    CompactGraph wheel = CompactGraph::fromGraph(GraphGenerator::Wheel(8));
+    CoreResult seq = KCore::Decompose(wheel);
+    assert(seq.degeneracy == 3);
+
+    CompactGraph rnd = CompactGraph::fromGraph(GraphGenerator::Random(200, 0.05));
+    CoreResult a = KCore::Decompose(rnd), b = KCore::DecomposeParallel(rnd, 4);
+    assert(a.core == b.core && a.degeneracy == b.degeneracy);
+    for (const CoreResult* r : {&a, &b}) {
+        std::vector<size_t> rank(rnd.vertexCount());
+        for (size_t i = 0; i < r->order.size(); ++i) rank[r->order[i]] = i;
+        for (unsigned v = 0; v < rnd.vertexCount(); ++v) {
+            unsigned later = 0;
+            for (unsigned u : rnd.neighbors(v)) later += rank[u] > rank[v];
+            assert(later <= r->degeneracy);
+        }
+    }
+
+    std::cout << "[OK] k-core decomposition verified.\n";
+}
+
+void TestBetweenness() {
+    CompactGraph path = CompactGraph::fromGraph(GraphGenerator::Path(5));
+    BetweennessResult bc = Betweenness::Exact(path, 3);
+    assert(std::abs(bc.vertex[path.index(2)] - 4.0) < 1e-9);
+    assert(std::abs(bc.vertex[path.index(0)]) < 1e-9);
+    assert(std::abs(bc.edgeValue(path, path.index(1), path.index(2)) - 6.0) < 1e-9);
+
+    BetweennessResult full = Betweenness::Sampled(path, 100);
+    assert(full.pivots == 5 && std::abs(full.vertex[path.index(1)] - 3.0) < 1e-9);
+    assert(Betweenness::Approximate(path, 1e-200, 0.1, 1).pivots == 5);  // bound beyond size_t, clamped to n
+    for (auto [epsilon, delta] : {std::pair{0.0, 0.1}, {-0.5, 0.1}, {1.0, 0.1}, {0.1, 0.0}, {0.1, 1.5}, {std::nan(""), 0.1}}) {
+        bool thrown = false;
+        try { Betweenness::Approximate(path, epsilon, delta); } catch (const std::invalid_argument&) { thrown = true; }
+        assert(thrown);
+    }
+
+    Graph g = GraphGenerator::WithBridges(10, 3);
+    auto ranked = GraphMetrics::RankBridges(g);
+    assert(ranked.size() == 3);
+    assert(std::abs(ranked[0].betweenness - 3.0 * 7.0) < 1e-9);
+
+    std::cout << "[OK] Betweenness and bridge ranking verified.\n";
+}
+
+void TestEdgeCuts() {
+    EdgeCutResult twoCycles = EdgeCutAnalyzer::Analyze(CompactGraph::fromGraph(GraphGenerator::With2Bridges(8)));
+    assert(twoCycles.bridges == 1 && twoCycles.twoEdgeCuts == 12 && twoCycles.threeEdgeClassCount == 8);
+    assert(GraphMetrics::Count2EdgeCuts(GraphGenerator::Cubic(6)) == 0);
+    assert(GraphMetrics::Count3EdgeConnectedClasses(GraphGenerator::Complete(5)) == 1);
+
+    // Two K4 blobs joined by three paths of length 2: the blobs stay 3-edge-connected.
+    Graph blobs = GraphGenerator::Complete(4);
+    for (int i = 4; i < 8; ++i) for (int j = i + 1; j < 8; ++j) blobs.addEdge(i, j);
+    for (int i = 0; i < 3; ++i) { blobs.addEdge(i, 8 + i); blobs.addEdge(8 + i, 4 + i); }
+    EdgeCutResult r = EdgeCutAnalyzer::Analyze(CompactGraph::fromGraph(blobs));
+    assert(r.twoEdgeCuts == 3 && r.threeEdgeClassCount == 4);
+
+    // Brute force over all edge pairs on a small random graph.
+    Graph g = GraphGenerator::Random(12, 0.3);
+    std::vector<std::pair<int, int>> edges;
+    for (int u : g.getVertices()) for (int v : g.neighbors(u)) if (u < v) edges.push_back({u, v});
+    auto components = [&](size_t skipA, size_t skipB) {
+        Graph h;
+        for (int v : g.getVertices()) h.addVertex(v);
+        for (size_t i = 0; i < edges.size(); ++i)
+            if (i != skipA && i != skipB) h.addEdge(edges[i].first, edges[i].second);
+        return GraphMetrics::ConnectedComponents(h);
+    };
+    size_t base = components(-1, -1);
+    std::vector<bool> bridge(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) bridge[i] = components(i, -1) > base;
+    size_t expected = 0;
+    for (size_t i = 0; i < edges.size(); ++i)
+        for (size_t j = i + 1; j < edges.size(); ++j)
+            if (!bridge[i] && !bridge[j] && components(i, j) > base) expected++;
+    assert(GraphMetrics::Count2EdgeCuts(g) == expected);
+
+    std::cout << "[OK] 2-edge cuts and 3-edge-connected classes verified.\n";
+}
+
+void TestScheduler() {
+    TaskScheduler::configure({4, false});
+    TaskScheduler& pool = TaskScheduler::instance();
+    assert(pool.workerCount() == 4);
+
+    long long sum = pool.parallelReduce(0, 100000, 0LL, [](size_t lo, size_t hi) {
+        long long s = 0;
+        for (size_t i = lo; i < hi; ++i) s += i;
+        return s;
+    }, [](long long a, long long b) { return a + b; });
+    assert(sum == 100000LL * 99999 / 2);
+
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(0, 10, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            pool.parallelFor(0, 100, [&](size_t a, size_t b) {
+                for (size_t j = a; j < b; ++j) hits[i * 100 + j]++;
+            }, 7);
+    }, 1);
+    for (auto& h : hits) assert(h.load() == 1);
+
+    // `threads` caps the bodies in flight, `chunks` sets how finely the range is cut.
+    std::atomic<int> running{0}, peak{0}, calls{0};
+    std::vector<std::atomic<int>> seen(997);
+    Parallel::forRange(0, seen.size(), [&](size_t lo, size_t hi) {
+        int now = ++running;
+        for (int p = peak.load(); now > p && !peak.compare_exchange_weak(p, now);) {}
+        for (size_t i = lo; i < hi; ++i) seen[i]++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        calls++;
+        running--;
+    }, 2, 40);
+    for (auto& s : seen) assert(s.load() == 1);
+    assert(peak.load() <= 2 && calls.load() == 40);
+
+    bool thrown = false;
+    try {
+        TaskGroup group(pool);
+        group.run([] { throw std::runtime_error("task failed"); });
+        group.wait();
+    } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+
+    std::cout << "[OK] Work-stealing scheduler verified.\n";
+}
+
+void TestStreaming() {
+    StreamingAnalyzer odd(16);
+    for (int i = 0; i < 5; ++i) odd.addEdge(i, (i + 1) % 5);
+    odd.addEdge(10, 11);
+    StreamSummary s = odd.result();
+    assert(s.vertices == 7 && s.edges == 6 && s.components == 2 && !s.bipartite);
+    assert(s.degreeHistogram[2] == 5 && s.degreeHistogram[1] == 2);
+    assert(s.triangleExact && s.triangleEstimate == 0.0);
+
+    auto path = std::filesystem::temp_directory_path() / "graphodro4_stream.edges";
+    {
+        std::ofstream out(path);
+        out << "# K4 plus a pendant path\n0 1\n0 2\n0 3\n1 2\n1 3\n2 3\n3 4\n4 4\n";
+        out << "123456789012345678901234 4\n4 -99999999999999999999\n";  // ids beyond long long: skipped
+    }
+    StreamSummary k4 = StreamingAnalyzer::ProcessFile(path.string());
+    std::filesystem::remove(path);
+    assert(k4.vertices == 5 && k4.edges == 7 && k4.selfLoops == 1 && k4.components == 1);
+    assert(k4.triangleEstimate == 4.0 && k4.maxDegree == 4);
+
+    StreamingAnalyzer even(0);
+    for (int i = 0; i < 6; ++i) even.addEdge(i, (i + 1) % 6);
+    assert(even.result().bipartite);
+
+    std::cout << "[OK] Streaming metrics verified.\n";
+}
+
+void TestOutOfCore() {
+    Graph g = GraphGenerator::WithConnectedComponents(20, 3);
+    g.addEdge(0, 5);
+    auto file = std::filesystem::temp_directory_path() / "graphodro4_ooc.edges";
+    {
+        std::ofstream out(file);
+        out << Program4YouSerializer::serialize(g).substr(Program4YouSerializer::serialize(g).find('\n') + 1);
+    }
+    ShardedGraph::Options options;
+    options.verticesPerShard = 3;
+    options.directory = (std::filesystem::temp_directory_path() / "graphodro4_ooc_shards").string();
+    {
+        ShardedGraph sg = ShardedGraph::Build(file.string(), options);
+        assert(sg.shardCount() == 7 && sg.edgeCount() == g.edgeCount());
+    }
+    ShardedGraph sg = ShardedGraph::Open(options.directory);
+    std::filesystem::remove(file);
+
+    auto deg = sg.Degrees();
+    for (int v : g.getVertices()) assert(deg[v] == g.neighbors(v).size());
+    size_t components = 0;
+    sg.ConnectedComponents(&components);
+    assert(components == GraphMetrics::ConnectedComponents(g));
+    auto level = sg.BFS(0);
+    assert(level[5] == 1 && level[4] == 2 && level[3] == 3 && level[6] == ShardedGraph::kUnreached);
+    std::filesystem::remove_all(options.directory);
+
+    std::cout << "[OK] Out-of-core sharded engine verified.\n";
+}
+
+void TestConcurrentGraph() {
+    ConcurrentGraph cg;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t)
+        producers.emplace_back([&cg, t] {
+            for (int i = 0; i < 1000; ++i) cg.addEdge(i, (i + 1) % 1000); // every thread adds the same cycle
+            for (int i = 0; i < 250; ++i) cg.addEdge(2000 + t, i * 4 + t);
+        });
+    for (auto& p : producers) p.join();
+    CompactGraph frozen = cg.freeze();
+    assert(frozen.vertexCount() == 1004 && frozen.edgeCount() == 2000);
+    assert(frozen.degree(frozen.index(2001)) == 250 && frozen.degree(frozen.index(5)) == 3);
+    assert(cg.toGraph().edgeCount() == 2000);
+
+    ConcurrentGraph parsed;
+    std::stringstream a("0 1\n1 2\n2 0\n"), b("3 4\n4 5\n5 3\n2 3\n");
+    std::thread other([&] { EdgeListParser::parseInto(a, parsed); });
+    EdgeListParser::parseInto(b, parsed);
+    other.join();
+    Graph g = parsed.toGraph();
+    assert(g.edgeCount() == 7 && GraphMetrics::CountBridgesRandomized(g) == 1);
+
+    // Lines parse independently of where the pieces are cut: comments are
+    // skipped, a bad line is dropped alone and a weight column is ignored.
+    std::string text = "# comment\n% comment\n";
+    for (int i = 0; i < 2000; ++i) text += std::to_string(i) + " " + std::to_string(i + 1) + (i % 3 ? "\n" : " 0.5\n");
+    text += "7 99999999999\n-\n1 2 3 4 5\n8 x\n2000 2001\n";
+    std::stringstream lines(text);
+    ConcurrentGraph lineGraph;
+    assert(EdgeListParser::parseInto(lines, lineGraph) == 4);
+    CompactGraph path = lineGraph.freeze();
+    assert(path.vertexCount() == 2002 && path.edgeCount() == 2001);
+
+    ConcurrentGraph rnd;
+    GraphGenerator::RandomInto(rnd, 300, 1.0);
+    assert(rnd.freeze().edgeCount() == 300 * 299 / 2);
+
+    std::cout << "[OK] Concurrent graph ingestion verified.\n";
+}
+
+void TestVersionedGraph() {
+    VersionedGraph vg;
+    vg.addEdge(1, 2);
+    vg.addEdge(2, 3);
+    auto first = vg.commit();
+    vg.addEdge(3, 1);
+    vg.addEdge(3, 4);
+    assert(first->edgeCount() == 2 && !first->hasEdge(1, 3) && !first->hasVertex(4));
+    auto second = vg.commit();
+    assert(second->edgeCount() == 4 && second->hasEdge(1, 3) && second->neighbors(3).size() == 3);
+    assert(first->neighbors(3).size() == 1 && GraphMetrics::Transitivity(*first) == 0.0);
+    assert(GraphMetrics::CountBridgesRandomized(*second) == 1);
+
+    // Readers check snapshot invariants of a growing path while the writer keeps adding.
+    VersionedGraph path;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto snap = path.snapshot();
+                if (snap->vertexCount() == 0) continue;
+                assert(snap->edgeCount() + 1 == snap->vertexCount());
+                assert(GraphMetrics::ConnectedComponents(*snap) == 1);
+                assert(snap->getVertices().size() == snap->vertexCount());
+            }
+        });
+    for (int i = 0; i < 1000; ++i) {
+        path.addEdge(i, i + 1);
+        if (i % 50 == 0) path.commit();
+    }
+    auto last = path.commit();
+    done = true;
+    for (auto& r : readers) r.join();
+    assert(last->vertexCount() == 1001 && GraphMetrics::Diameter(*last) == 1000);
+    assert(last->getVertices().back() == 1000);
+
+    std::cout << "[OK] Copy-on-write snapshots verified.\n";
+}
+
+void TestViews() {
+    Graph a = GraphGenerator::Cycle(6);                  // 0..5
+    Graph b;
+    b.addEdge(0, 1); b.addEdge(5, 6); b.addEdge(6, 7);  // one shared edge, a tail of two
+    auto u = GraphViews::Union(a, b);
+    assert(u.vertexCount() == 8 && u.edgeCount() == 8 && u.neighbors(0).size() == 2);
+    assert(GraphMetrics::CountBridgesRandomized(u) == 2 && GraphMetrics::Diameter(u) == 5);
+    Graph merged = a;
+    merged.merge(b);
+    Graph copy = GraphViews::Merge(a, b);
+    assert(copy.edgeCount() == merged.edgeCount() && copy.vertexCount() == merged.vertexCount());
+    assert(a.edgeCount() == 6 && b.edgeCount() == 3);
+    Graph heavy = a, light = b;                          // weights survive the parallel merge
+    heavy.addEdge(1, 2, 5.0);
+    light.addEdge(0, 1, 0.5);
+    Graph heavyMerged = heavy;
+    heavyMerged.merge(light);
+    Graph heavyCopy = GraphViews::Merge(heavy, light);
+    assert(heavyCopy.isWeighted() && heavyCopy.weight(1, 2) == 5.0 && heavyCopy.weight(2, 1) == 5.0);
+    for (int v : heavyMerged.getVertices())
+        for (int x : heavyMerged.neighbors(v)) assert(heavyCopy.weight(v, x) == heavyMerged.weight(v, x));
+    assert(heavyMerged.weight(0, 1) == 0.5 && GraphViews::Materialize(heavy, 2).weight(1, 2) == 5.0);
+    Graph big = GraphGenerator::Random(400, 0.02), other = GraphGenerator::Random(400, 0.02);
+    Graph bigMerged = big;
+    bigMerged.merge(other);
+    Graph bigCopy = GraphViews::Merge(big, other, 4);
+    assert(bigCopy.edgeCount() == bigMerged.edgeCount() && bigCopy.vertexCount() == bigMerged.vertexCount());
+    for (int v : bigMerged.getVertices())
+        for (int x : bigMerged.neighbors(v)) assert(bigCopy.hasEdge(v, x));
+
+    auto even = GraphViews::Induced(u, [](int v) { return v % 2 == 0; });
+    assert(even.vertexCount() == 4 && even.edgeCount() == 0 && GraphMetrics::ConnectedComponents(even) == 4);
+    std::vector<bool> bits(8, false);
+    bits[0] = bits[1] = bits[2] = true;
+    auto path = GraphViews::InducedBitmap(a, bits);
+    assert(path.edgeCount() == 2 && GraphMetrics::Diameter(path) == 2 && !path.hasVertex(3));
+    auto owned = GraphViews::InducedBitmap(a, std::vector<bool>{true, true, true});  // temporary bitmap
+    assert(owned.edgeCount() == 2 && owned.hasVertex(2) && !owned.hasVertex(3));
+
+    Graph two = GraphGenerator::WithConnectedComponents(12, 3);
+    auto comp = GraphViews::Component(two, two.getVertices().front());
+    assert(GraphMetrics::ConnectedComponents(comp) == 1 && comp.vertexCount() < two.vertexCount());
+
+    auto cut = GraphViews::EdgeFilter(u, [](int x, int y) { return std::min(x, y) != 5; });
+    assert(cut.edgeCount() == 7 && GraphMetrics::ConnectedComponents(cut) == 2);
+
+    auto shifted = GraphViews::Relabel(a, [](int v) { return v + 100; }, [](int v) { return v - 100; });
+    assert(shifted.hasEdge(100, 105) && !shifted.hasEdge(100, 102));
+    Graph relabeled = GraphViews::Materialize(shifted, 2);
+    assert(relabeled.hasEdge(103, 104) && relabeled.edgeCount() == 6);
+    auto nested = GraphViews::Union(shifted, a);
+    assert(nested.vertexCount() == 12 && GraphMetrics::ConnectedComponents(nested) == 2);
+
+    std::cout << "[OK] Union, subgraph, filter and relabel views verified.\n";
+}
+
+// The implicit family must describe exactly the generator's graph, and its closed forms
+// must agree with the general algorithms run on that graph.
+template <class I>
+void CheckImplicit(const I& implicit, const Graph& g) {
+    Graph copy = GraphViews::Materialize(implicit);
+    assert(copy.vertexCount() == g.vertexCount() && copy.edgeCount() == g.edgeCount());
+    assert(implicit.edgeCount() == g.edgeCount() && implicit.vertexCount() == g.vertexCount());
+    for (int v : g.getVertices()) {
+        assert(implicit.neighbors(v).size() == g.neighbors(v).size());
+        for (int u : g.neighbors(v)) assert(implicit.hasEdge(v, u) && copy.hasEdge(v, u));
+    }
+    assert(GraphMetrics::Diameter(implicit) == GraphMetrics::Diameter(g));
+    assert(GraphMetrics::ConnectedComponents(implicit) == GraphMetrics::ConnectedComponents(g));
+    assert(GraphMetrics::IsBipartite(implicit) == GraphMetrics::IsBipartite(g));
+    assert(GraphMetrics::GreedyColoring(implicit) == GraphMetrics::GreedyColoring(copy)); // same vertex order
+    assert(std::abs(GraphMetrics::Transitivity(implicit) - GraphMetrics::Transitivity(g)) < 1e-12);
+    assert(GraphMetrics::CountArticulationPoints(implicit) == GraphMetrics::CountArticulationPoints(g));
+    assert(GraphMetrics::CountBridgesRandomized(implicit) == GraphMetrics::CountBridgesRandomized(g));
+    assert(GraphMetrics::Degeneracy(implicit) == GraphMetrics::Degeneracy(g));
+    assert(GraphMetrics::Girth(implicit) == GraphMetrics::Girth(g));
+    assert(GraphMetrics::CliqueNumber(implicit) == GraphMetrics::CliqueNumber(g));
+    assert(GraphMetrics::ChromaticNumber(implicit) == GraphMetrics::ChromaticNumber(g));
+    assert(GraphMetrics::EdgeConnectivity(implicit) == GraphMetrics::EdgeConnectivity(g));
+    assert(GraphMetrics::VertexConnectivity(implicit) == GraphMetrics::VertexConnectivity(g));
+    assert(std::abs(GraphMetrics::SpectralRadius(implicit) - GraphMetrics::SpectralRadius(g)) < 1e-8);
+    assert(std::abs(GraphMetrics::AlgebraicConnectivity(implicit) - GraphMetrics::AlgebraicConnectivity(g)) < 1e-8);
+    assert(GraphMetrics::Density(implicit) == GraphMetrics::Density(g));
+}
+
+void TestImplicitGraphs() {
+    for (int n = 2; n <= 9; ++n) {
+        CheckImplicit(ImplicitComplete<>(n), GraphGenerator::Complete(n));
+        CheckImplicit(ImplicitPath<>(n), GraphGenerator::Path(n));
+        CheckImplicit(ImplicitStar<>(n), GraphGenerator::Star(n));
+        if (n >= 3) CheckImplicit(ImplicitCycle<>(n), GraphGenerator::Cycle(n));
+        if (n >= 4) CheckImplicit(ImplicitWheel<>(n), GraphGenerator::Wheel(n));
+        for (int m = 1; m <= 4; ++m) CheckImplicit(ImplicitCompleteBipartite<>(n, m), GraphGenerator::CompleteBipartite(n, m));
+    }
+    for (int n = 4; n <= 30; n += 2) CheckImplicit(ImplicitCubic<>(n), GraphGenerator::Cubic(n));
+
+    ImplicitComplete<> huge(100000);
+    assert(huge.edgeCount() == 4999950000ull && GraphMetrics::Density(huge) == 1.0);
+    assert(GraphMetrics::Diameter(huge) == 1 && GraphMetrics::Degeneracy(huge) == 99999);
+    assert(huge.hasEdge(0, 99999) && *huge.neighbors(7).begin() == 0);
+    ImplicitCycle<uint64_t> ring(1ull << 40);
+    assert(GraphMetrics::Diameter(ring) == (1ull << 39) && ring.hasEdge(0, (1ull << 40) - 1));
+
+    std::cout << "[OK] Implicit graph families and closed-form metrics verified.\n";
+}
+
+void TestDistanceOracle() {
+    Graph g = GraphGenerator::Random(200, 0.02);
+    for (int i = 0; i < 30; ++i) g.addEdge(300 + i, 301 + i);   // a separate path component
+    CompactGraph c = CompactGraph::fromGraph(g);
+    DistanceOracle oracle = DistanceOracle::Build(c);
+    DistanceOracle serial = DistanceOracle::Build(c, 1);
+    BreadthFirstSearch<CompactGraph> bfs(c);
+    for (CompactGraph::Index s = 0; s < c.vertexCount(); ++s) {
+        bfs.run(s);
+        for (CompactGraph::Index t = 0; t < c.vertexCount(); ++t) {
+            size_t expect = bfs.distance(t) == CompactGraph::kNone ? DistanceOracle::kUnreachable : bfs.distance(t);
+            assert(oracle.distanceIndex(s, t) == expect && serial.distanceIndex(s, t) == expect);
+        }
+    }
+    assert(oracle.distance(300, 330) == 30 && oracle.distance(c.id(0), 330) == DistanceOracle::kUnreachable);
+
+    std::string path = (std::filesystem::temp_directory_path() / "graphodro4_test.pll").string();
+    oracle.save(path);
+    DistanceOracle loaded = DistanceOracle::Load(path);
+    // Corrupt headers and label offsets must fail as runtime errors, not in the allocator
+    // or by reading past the hub array: huge vertex count, huge label count, offsets[1].
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    size_t offsetOne = 32 + loaded.vertexCount() * sizeof(DistanceOracle::Vertex) + sizeof(uint64_t);
+    for (size_t at : {size_t(16), size_t(24), offsetOne}) {
+        std::string bad = bytes;
+        uint64_t huge = uint64_t(1) << 60;
+        bad.replace(at, sizeof(huge), (const char*)&huge, sizeof(huge));
+        std::ofstream(path, std::ios::binary) << bad;
+        bool rejected = false;
+        try { DistanceOracle::Load(path); } catch (const std::runtime_error&) { rejected = true; }
+        assert(rejected);
+    }
+    std::filesystem::remove(path);
+    assert(loaded.labelCount() == oracle.labelCount());
+    auto batch = loaded.distances({{300, 315}, {315, 300}, {301, 301}});
+    assert(batch[0] == 15 && batch[1] == 15 && batch[2] == 0);
+    bool thrown = false;
+    try { loaded.distance(-5, 0); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    assert(GraphMetrics::Diameter(GraphGenerator::Cycle(11)) == 5);
+    assert(GraphMetrics::Diameter(GraphViews::Union(GraphGenerator::Path(4), Graph())) == 3);
+
+    std::cout << "[OK] Pruned landmark distance oracle verified.\n";
+}
+
+void TestWeightedPaths() {
+    std::stringstream edges("0 1 2.5\n1 2 1\n0 2 10\n2 3\n");
+    Graph g = EdgeListParser::parse(edges);
+    assert(g.isWeighted() && g.weight(1, 0) == 2.5 && g.weight(2, 3) == 1.0);
+    CompactGraph c = CompactGraph::fromGraph(g);
+    assert(ShortestPaths::Dijkstra(c, c.index(0))[c.index(3)] == 4.5);
+    assert(GraphMetrics::WeightedEccentricity(g, 0) == 4.5 && GraphMetrics::WeightedDiameter(g) == 4.5);
+
+    std::stringstream dimacs("c roads\np sp 3 2\na 1 2 7\na 2 3 0.5\n");
+    Graph road = DimacsParser::parse(dimacs);
+    assert(road.weight(2, 3) == 0.5 && GraphMetrics::WeightedDiameter(road) == 7.5);
+    std::stringstream matrix("3\n0 4 1\n4 0 0\n1 0 0\n");
+    Graph m = MatrixParser::parse(matrix);
+    assert(m.isWeighted() && m.weight(0, 1) == 4 && m.weight(0, 2) == 1 && m.edgeCount() == 2);
+    std::stringstream plain("0 1\n1 2\n");
+    assert(!EdgeListParser::parse(plain).isWeighted());
+
+    // Two ids are an edge, three a weighted edge, an even count pairs of ids;
+    // comments are skipped and every other line is rejected on its own.
+    std::stringstream mixed("# header\n10 11\n11 12 3.5\n12 13 13 14\n20 21 22\n% note\n30 31 32 33 34\n"
+                            "40 4.5\n41 42 1.5 43\n50 x\n60 61 nan\n\n14 15, 2\n");
+    size_t malformed = 0;
+    Graph mg = EdgeListParser::parse(mixed, malformed);
+    assert(malformed == 5 && mg.edgeCount() == 6 && mg.vertexCount() == 8);
+    assert(mg.weight(11, 12) == 3.5 && mg.weight(20, 21) == 22 && mg.weight(14, 15) == 2);
+    assert(mg.hasEdge(12, 13) && mg.hasEdge(13, 14) && mg.weight(10, 11) == 1.0 && !mg.hasVertex(30));
+
+    // Weights survive the indexed neighbour sets of high-degree vertices.
+    Graph star;
+    for (int i = 1; i <= 40; ++i) star.addEdge(0, i);
+    for (int i = 1; i <= 40; ++i) star.addEdge(i, 0, i);
+    assert(star.weight(0, 33) == 33 && star.edgeCount() == 40 && GraphMetrics::WeightedDiameter(star) == 79);
+
+    // Dijkstra and delta-stepping against Bellman-Ford on a random weighted graph.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> weight(0.0, 5.0);
+    Graph r;
+    for (int i = 0; i < 300; ++i) r.addVertex(i);
+    for (int i = 0; i < 1200; ++i) r.addEdge(rng() % 300, rng() % 300, i % 10 == 0 ? 40.0 : weight(rng));
+    CompactGraph rc = CompactGraph::fromGraph(r);
+    std::vector<double> bf(300, ShortestPaths::kInfinity);
+    bf[0] = 0;
+    for (int it = 0; it < 300; ++it)
+        for (CompactGraph::Index v = 0; v < 300; ++v)
+            for (auto slot = rc.offsets[v]; slot < rc.offsets[v + 1]; ++slot)
+                bf[rc.targets[slot]] = std::min(bf[rc.targets[slot]], bf[v] + rc.weight(slot));
+    auto dj = ShortestPaths::Dijkstra(rc, 0);
+    auto ds = ShortestPaths::DeltaStepping(rc, 0);
+    auto ds1 = ShortestPaths::DeltaStepping(rc, 0, 0.3, 1);
+    for (int v = 0; v < 300; ++v)
+        assert(std::abs(dj[v] - bf[v]) < 1e-9 && std::abs(ds[v] - bf[v]) < 1e-9 && std::abs(ds1[v] - bf[v]) < 1e-9);
+
+    // Skewed weights: a tiny delta against 1e9 weights must not allocate a bucket per delta.
+    Graph skewed;
+    for (int i = 0; i < 200; ++i) skewed.addEdge(i, i + 1, i % 50 == 49 ? 1e9 : 1e-3 * (1 + i % 7));
+    for (int i = 0; i < 200; i += 3) skewed.addEdge(i, i + 2, i % 2 ? 5e8 : 2e-3);
+    CompactGraph sc = CompactGraph::fromGraph(skewed);
+    std::vector<double> sd = ShortestPaths::Dijkstra(sc, 0);
+    for (double delta : {1e-4, 0.0, 1e8})
+        for (unsigned t : {1u, 0u}) {
+            std::vector<double> got = ShortestPaths::DeltaStepping(sc, 0, delta, t);
+            for (size_t v = 0; v < sd.size(); ++v) assert(std::abs(got[v] - sd[v]) <= 1e-12 * sd[v]);
+        }
+
+    Graph cyc = GraphGenerator::Cycle(9);
+    assert(GraphMetrics::WeightedDiameter(cyc) == GraphMetrics::Diameter(cyc));
+    Graph bad;
+    bad.addEdge(0, 1, -1.0);
+    bool thrown = false;
+    try { GraphMetrics::WeightedDiameter(bad); } catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    std::cout << "[OK] Weighted parsing, Dijkstra and delta-stepping verified.\n";
+}
+
+void TestSpanningTrees() {
+    Graph g = GraphGenerator::WithConnectedComponents(60, 4);
+    CompactGraph c = CompactGraph::fromGraph(g);
+    size_t components = GraphMetrics::ConnectedComponents(g);
+    for (const SpanningForest& f : {SpanningTrees::Wilson(c, 7), SpanningTrees::BFS(c), SpanningTrees::DFS(c),
+                                    SpanningTrees::Kruskal(c), SpanningTrees::Boruvka(c, 3)}) {
+        assert(f.trees == components && f.weight == 60.0 - components);
+        for (CompactGraph::Index v = 0; v < 60; ++v)
+            assert(f.parent[v] == f.kNone || g.hasEdge(c.id(v), c.id(f.parent[v])));
+    }
+
+    // Every one of the 16 spanning trees of K4 should come up about equally often.
+    CompactGraph k4 = CompactGraph::fromGraph(GraphGenerator::Complete(4));
+    std::map<std::vector<std::pair<int, int>>, int> seen;
+    for (uint64_t seed = 0; seed < 4000; ++seed) {
+        SpanningForest f = SpanningTrees::Wilson(k4, seed);
+        std::vector<std::pair<int, int>> edges;
+        for (int v = 0; v < 4; ++v)
+            if (f.parent[v] != f.kNone) edges.push_back(std::minmax<int>(v, f.parent[v]));
+        std::sort(edges.begin(), edges.end());
+        seen[edges]++;
+    }
+    assert(seen.size() == 16);
+    for (auto& [tree, count] : seen) assert(count > 170 && count < 330);
+
+    Graph w;
+    std::mt19937 rng(5);
+    for (int i = 0; i < 300; ++i) w.addEdge(rng() % 80, rng() % 80, rng() % 10);
+    CompactGraph cw = CompactGraph::fromGraph(w);
+    SpanningForest kruskal = SpanningTrees::Kruskal(cw), boruvka = SpanningTrees::Boruvka(cw, 4);
+    assert(kruskal.weight == boruvka.weight && kruskal.trees == boruvka.trees);
+    assert(SpanningTrees::BFS(cw).weight >= kruskal.weight);
+
+    std::string dot = GraphVizSerializer::serialize(w, GraphVizSerializer::MINIMUM_SPANNING_TREE);
+    size_t red = 0;
+    for (size_t at = dot.find("red"); at != std::string::npos; at = dot.find("red", at + 1)) red++;
+    assert(red == cw.vertexCount() - kruskal.trees);
+
+    std::cout << "[OK] Wilson, BFS/DFS and minimum spanning forests verified.\n";
+}
+
+// A cycle must be a closed walk through distinct vertices along edges of c.
+bool IsCycle(const CompactGraph& c, const std::vector<CompactGraph::Index>& cycle) {
+    std::set<CompactGraph::Index> distinct(cycle.begin(), cycle.end());
+    if (cycle.size() < 3 || distinct.size() != cycle.size()) return false;
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        auto row = c.neighbors(cycle[i]);
+        if (!std::binary_search(row.begin(), row.end(), cycle[(i + 1) % cycle.size()])) return false;
+    }
+    return true;
+}
+
+void TestCycles() {
+    CompactGraph path = CompactGraph::fromGraph(GraphGenerator::Path(50));
+    assert(Cycles::Find(path).empty() && Cycles::Girth(path) == 0 && Cycles::MinimumBasis(path).empty());
+    CompactGraph ring = CompactGraph::fromGraph(GraphGenerator::Cycle(100000));
+    assert(Cycles::Find(ring).size() == 100000 && Cycles::Girth(CompactGraph::fromGraph(GraphGenerator::Cycle(1000))) == 1000);
+
+    Graph petersen;
+    for (int i = 0; i < 5; ++i) {
+        petersen.addEdge(i, (i + 1) % 5);
+        petersen.addEdge(i, i + 5);
+        petersen.addEdge(i + 5, (i + 2) % 5 + 5);
+    }
+    CompactGraph p = CompactGraph::fromGraph(petersen);
+    assert(GraphMetrics::Girth(petersen) == 5 && GraphMetrics::CycleRank(petersen) == 6);
+    auto shortest = Cycles::Shortest(p);
+    assert(shortest.size() == 5 && IsCycle(p, shortest));
+    for (uint64_t seed = 0; seed < 20; ++seed) assert(IsCycle(p, Cycles::Random(p, seed)));
+    auto fundamental = Cycles::FundamentalBasis(p);
+    assert(fundamental.size() == 6);
+    for (auto& cycle : fundamental) assert(IsCycle(p, cycle));
+    auto minimum = Cycles::MinimumBasis(p);
+    assert(minimum.size() == 6);
+    for (auto& cycle : minimum) assert(cycle.size() == 5 && IsCycle(p, cycle));
+
+    // The minimum basis of a 4x4 grid is its nine unit squares.
+    Graph grid;
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c) {
+            if (c < 3) grid.addEdge(4 * r + c, 4 * r + c + 1);
+            if (r < 3) grid.addEdge(4 * r + c, 4 * r + c + 4);
+        }
+    CompactGraph cg = CompactGraph::fromGraph(grid);
+    auto squares = Cycles::MinimumBasis(cg);
+    assert(squares.size() == 9 && Cycles::FundamentalBasis(cg).size() == 9);
+    for (auto& cycle : squares) assert(cycle.size() == 4 && IsCycle(cg, cycle));
+
+    std::string dot = GraphVizSerializer::serialize(grid, GraphVizSerializer::CYCLE_BASIS);
+    assert(dot.find("blue") != std::string::npos && dot.find("darkgreen") != std::string::npos);
+    dot = GraphVizSerializer::serialize(petersen, GraphVizSerializer::SHORTEST_CYCLE);
+    size_t blue = 0;
+    for (size_t at = dot.find("blue"); at != std::string::npos; at = dot.find("blue", at + 1)) blue++;
+    assert(blue == 5);
+
+    std::cout << "[OK] Cycle detection, girth and cycle bases verified.\n";
+}
+
+void TestCommunities() {
+    using Arc = CompactGraph::Arc;
+    CompactGraph bulk = CompactGraph::fromArcs(3, {Arc{0, 1, 1.0}, Arc{1, 0, 1.0}, Arc{0, 1, 2.5}, Arc{1, 0, 2.5}, Arc{2, 2, 4.0}});
+    assert(bulk.degree(0) == 1 && bulk.weight(bulk.offsets[0]) == 3.5 && bulk.degree(2) == 1 && bulk.index(2) == 2);
+
+    // 40 cliques of 8 joined in a ring by single edges.
+    Graph ring;
+    for (int q = 0; q < 40; ++q) {
+        for (int i = 0; i < 8; ++i)
+            for (int j = i + 1; j < 8; ++j) ring.addEdge(8 * q + i, 8 * q + j);
+        ring.addEdge(8 * q, (8 * q + 9) % 320);
+    }
+    CompactGraph c = CompactGraph::fromGraph(ring);
+    for (const Communities& found : {CommunityDetection::Leiden(c), CommunityDetection::Louvain(c, 1.0, 4)}) {
+        assert(found.count == 40 && found.modularity > 0.9);
+        for (int v = 0; v < 320; ++v) assert(found.label[c.index(v)] == found.label[c.index(v - v % 8)]);
+        assert(std::abs(found.modularity - CommunityDetection::Modularity(c, found.label)) < 1e-12);
+    }
+    // Label propagation may merge a few neighbouring cliques but never splits one.
+    Communities spread = CommunityDetection::LabelPropagation(c, 20, 0, 11);
+    assert(spread.count >= 30 && spread.count <= 40 && spread.modularity > 0.85);
+    for (int v = 0; v < 320; ++v) assert(spread.label[c.index(v)] == spread.label[c.index(v - v % 8)]);
+    std::vector<CompactGraph::Index> single(320, 0), apart(320);
+    std::iota(apart.begin(), apart.end(), 0);
+    assert(std::abs(CommunityDetection::Modularity(c, single)) < 1e-12 && CommunityDetection::Modularity(c, apart) < 0);
+
+    // Leiden communities stay connected.
+    Graph random = GraphGenerator::Random(400, 0.01);
+    CompactGraph rc = CompactGraph::fromGraph(random);
+    Communities leiden = CommunityDetection::Leiden(rc, 1.0, 3);
+    assert(leiden.modularity > 0.3 && std::abs(leiden.modularity - GraphMetrics::Modularity(random)) < 0.1);
+    for (size_t k = 0; k < leiden.count; ++k) {
+        auto inside = GraphViews::Induced(random, [&](int v) { return leiden.label[rc.index(v)] == k; });
+        assert(GraphMetrics::ConnectedComponents(inside) == 1);
+    }
+
+    std::string dot = GraphVizSerializer::serialize(ring, GraphVizSerializer::COMMUNITIES);
+    assert(dot.find("fillcolor") != std::string::npos);
+
+    std::cout << "[OK] Leiden, Louvain, label propagation and modularity verified.\n";
+}
+
+bool Covers(const Estimate& e, double exact) { return e.low <= exact && exact <= e.high; }
+
+void TestTriangleEstimation() {
+    // Overlapping cliques on a random backbone give a clustered graph with a fixed seed.
+    Graph g;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 6000; ++i) {
+        int u = rng() % 1500, v = rng() % 1500;
+        if (u != v) g.addEdge(u, v);
+    }
+    for (int q = 0; q < 150; ++q) {
+        int base = rng() % 1490;
+        for (int i = 0; i < 8; ++i)
+            for (int j = i + 1; j < 8; ++j) g.addEdge(base + i, base + j);
+    }
+    CompactGraph c = CompactGraph::fromGraph(g);
+    ClusteringEstimate exact = TriangleEstimation::Exact(c, 3);
+    assert(std::abs(exact.transitivity.value - GraphMetrics::Transitivity(g)) < 1e-12);
+    assert(exact.triangles.low == exact.triangles.high && exact.triangles.value > 1000);
+    assert(std::abs(GraphMetrics::AverageClustering(g) - exact.averageClustering.value) < 1e-12);
+
+    ClusteringEstimate few = TriangleEstimation::Wedges(c, 2000, 0.999, 1);
+    ClusteringEstimate many = TriangleEstimation::Wedges(c, 200000, 0.999, 1, 3);
+    assert(many.transitivity.high - many.transitivity.low < (few.transitivity.high - few.transitivity.low) / 5);
+    assert(Covers(many.transitivity, exact.transitivity.value) && Covers(many.triangles, exact.triangles.value));
+    assert(Covers(many.averageClustering, exact.averageClustering.value));
+    ClusteringEstimate again = TriangleEstimation::Wedges(c, 200000, 0.999, 1, 1);
+    assert(again.transitivity.value == many.transitivity.value);
+
+    ClusteringEstimate doulion = TriangleEstimation::Doulion(c, 0.5, 16, 0.999, 2);
+    assert(Covers(doulion.triangles, exact.triangles.value) && Covers(doulion.transitivity, exact.transitivity.value));
+    assert(Covers(doulion.averageClustering, exact.averageClustering.value));
+    // Few trials: the interval uses Student t (3.182 at 3 degrees of freedom), not z = 1.96.
+    assert(std::abs(Estimate::tScore(0.95, 3) - 3.182) < 1e-3 && std::abs(Estimate::tScore(0.95, 7) - 2.365) < 1e-3);
+    assert(std::abs(Estimate::tScore(0.95, 1) - 12.706) < 1e-3 && std::abs(Estimate::tScore(0.95, 100000) - 1.960) < 1e-3);
+    Estimate four = Estimate::Mean({1.0, 2.0, 3.0, 4.0}, 0.95);
+    assert(std::abs(four.high - 2.5 - 3.182 * std::sqrt(5.0 / 12.0)) < 1e-3);
+    ClusteringEstimate full = TriangleEstimation::Doulion(c, 1.0, 2);
+    assert(full.triangles.value == exact.triangles.value && full.triangles.low == full.triangles.high);
+
+    // Streaming: reservoirs large enough for the whole stream are exact, small ones bracket it.
+    StreamingAnalyzer whole(1 << 20, 5, 4), sampled(4000, 5, 8, 0.999);
+    for (CompactGraph::Index v = 0; v < c.vertexCount(); ++v)
+        for (CompactGraph::Index u : c.neighbors(v))
+            if (v < u) { whole.addEdge(v, u); sampled.addEdge(v, u); }
+    StreamSummary w = whole.result(), s = sampled.result();
+    assert(w.triangleExact && w.triangles.value == exact.triangles.value && w.triangles.low == w.triangles.high);
+    assert(std::abs(w.averageClustering.value - exact.averageClustering.value) < 1e-9);
+    assert(!s.triangleExact && Covers(s.triangles, exact.triangles.value) && Covers(s.transitivity, exact.transitivity.value));
+
+    std::cout << "[OK] Wedge sampling, DOULION and streaming estimates verified.\n";
+}
+
+void TestMotifs() {
+    // Brute force over all 3- and 4-subsets of a small random graph with a self-loop and an isolated vertex.
+    Graph g;
+    std::mt19937 rng(11);
+    const int n = 24;
+    for (int u = 0; u < n - 1; ++u)
+        for (int v = u + 1; v < n - 1; ++v)
+            if (rng() % 100 < 35) g.addEdge(u, v);
+    g.addEdge(4, 4);
+    g.addVertex(n - 1);
+    auto adj = [&](int a, int b) { return g.hasEdge(a, b); };
+    GraphletCounts brute;
+    std::vector<uint64_t> cliques(7, 0);
+    for (int a = 0; a < n; ++a)
+        for (int b = a + 1; b < n; ++b)
+            for (int c = b + 1; c < n; ++c) {
+                int e3 = adj(a, b) + adj(a, c) + adj(b, c);
+                if (e3 == 2) brute.wedges++;
+                if (e3 == 3) brute.triangles++;
+                for (int d = c + 1; d < n; ++d) {
+                    int vs[4] = {a, b, c, d}, deg[4] = {0, 0, 0, 0}, edges = 0;
+                    for (int i = 0; i < 4; ++i)
+                        for (int j = i + 1; j < 4; ++j)
+                            if (adj(vs[i], vs[j])) { deg[i]++; deg[j]++; edges++; }
+                    int top = *std::max_element(deg, deg + 4), low = *std::min_element(deg, deg + 4);
+                    if (edges == 3 && top == 3) brute.stars++;
+                    else if (edges == 3 && low == 1) brute.paths++;
+                    else if (edges == 4) (top == 2 ? brute.cycles : brute.tailedTriangles)++;
+                    else if (edges == 5) brute.diamonds++;
+                    else if (edges == 6) brute.cliques++;
+                }
+            }
+    // Cliques by extending sorted vertex lists one larger vertex at a time.
+    std::vector<std::vector<int>> level;
+    for (int v = 0; v < n; ++v) level.push_back({v});
+    for (size_t k = 2; k < cliques.size(); ++k) {
+        std::vector<std::vector<int>> next;
+        for (const auto& q : level)
+            for (int v = q.back() + 1; v < n; ++v)
+                if (std::all_of(q.begin(), q.end(), [&](int u) { return adj(u, v); })) {
+                    next.push_back(q);
+                    next.back().push_back(v);
+                }
+        cliques[k] = next.size();
+        level = std::move(next);
+    }
+
+    CompactGraph c = CompactGraph::fromGraph(g);
+    for (unsigned threads : {1u, 3u}) {
+        GraphletCounts got = Motifs::Graphlets(c, threads);
+        assert(got.wedges == brute.wedges && got.triangles == brute.triangles);
+        assert(got.stars == brute.stars && got.paths == brute.paths && got.tailedTriangles == brute.tailedTriangles);
+        assert(got.cycles == brute.cycles && got.diamonds == brute.diamonds && got.cliques == brute.cliques);
+        auto profile = Motifs::CliqueProfile(c, 6, threads);
+        for (size_t k = 2; k <= 6; ++k) assert(profile[k] == cliques[k]);
+        assert(profile[1] == (uint64_t)n && Motifs::CountCliques(c, 5, threads) == cliques[5]);
+    }
+    assert(brute.cliques > 0 && brute.cycles > 0 && GraphMetrics::CountCliques(g, 3) == brute.triangles);
+
+    // Complete graphs: C(n, k) cliques; K70 needs two words per bitset row.
+    Graph k10 = GraphGenerator::Complete<Graph>(10), k70 = GraphGenerator::Complete<Graph>(70);
+    auto profile = Motifs::CliqueProfile(CompactGraph::fromGraph(k10), 8, 2);
+    const uint64_t binom10[] = {1, 10, 45, 120, 210, 252, 210, 120, 45};
+    for (unsigned k = 0; k <= 8; ++k) assert(profile[k] == binom10[k]);
+    CompactGraph big = CompactGraph::fromGraph(k70);
+    assert(Motifs::CountCliques(big, 4) == 916895);
+    GraphletCounts full = Motifs::Graphlets(big);
+    assert(full.cliques == 916895 && full.diamonds == 0 && full.paths == 0 && full.wedges == 0);
+
+    std::cout << "[OK] k-clique profile and 4-vertex graphlet counts verified.\n";
+}
+
+// Smallest k admitting a proper colouring, by plain backtracking over vertices 0..n-1.
+size_t BruteChromatic(const Graph& g, int n) {
+    std::vector<int> color(n, -1);
+    for (int k = 1;; ++k) {
+        std::function<bool(int)> place = [&](int v) {
+            if (v == n) return true;
+            for (int c = 0; c < k; ++c) {
+                bool ok = true;
+                for (int u = 0; u < v && ok; ++u) ok = !(color[u] == c && g.hasEdge(u, v));
+                if (!ok) continue;
+                color[v] = c;
+                if (place(v + 1)) return true;
+            }
+            return false;
+        };
+        if (n == 0 || place(0)) return n ? k : 0;
+    }
+}
+
+void TestColoring() {
+    std::mt19937 rng(21);
+    for (int trial = 0; trial < 40; ++trial) {
+        int n = 4 + trial % 9, density = 20 + rng() % 60;
+        Graph g;
+        for (int v = 0; v < n; ++v) g.addVertex(v);
+        for (int u = 0; u < n; ++u)
+            for (int v = u + 1; v < n; ++v)
+                if ((int)(rng() % 100) < density) g.addEdge(u, v);
+        if (trial % 5 == 0) g.addEdge(0, 0);
+        size_t omega = 0;
+        for (uint32_t mask = 1; mask < (1u << n); ++mask) {
+            bool clique = true;
+            for (int u = 0; u < n && clique; ++u)
+                for (int v = u + 1; v < n && clique; ++v)
+                    if ((mask >> u & 1) && (mask >> v & 1) && !g.hasEdge(u, v)) clique = false;
+            if (clique) omega = std::max<size_t>(omega, __builtin_popcount(mask));
+        }
+        CompactGraph c = CompactGraph::fromGraph(g);
+        for (unsigned threads : {1u, 3u}) {
+            auto found = MaxClique::Find(c, threads);
+            assert(found.size() == omega);
+            for (size_t i = 0; i < found.size(); ++i)
+                for (size_t j = i + 1; j < found.size(); ++j) {
+                    auto row = c.neighbors(found[i]);
+                    assert(std::binary_search(row.begin(), row.end(), found[j]));
+                }
+            Coloring exact = VertexColoring::Exact(c, threads);
+            assert(exact.exact && exact.colors == BruteChromatic(g, n) && exact.lowerBound == exact.colors);
+            assert(VertexColoring::IsProper(c, exact.color));
+        }
+    }
+
+    // Groetzsch graph: triangle-free with chromatic number 4, so the clique bound is not tight.
+    Graph mycielski;
+    for (int i = 0; i < 5; ++i) {
+        mycielski.addEdge(i, (i + 1) % 5);
+        mycielski.addEdge(5 + i, (i + 1) % 5);
+        mycielski.addEdge(5 + i, (i + 4) % 5);
+        mycielski.addEdge(5 + i, 10);
+    }
+    CompactGraph m = CompactGraph::fromGraph(mycielski);
+    Coloring four = VertexColoring::Exact(m, 2);
+    assert(MaxClique::Size(m) == 2 && four.exact && four.colors == 4 && VertexColoring::IsProper(m, four.color));
+    Coloring cut = VertexColoring::Exact(m, 1, 3);
+    assert(!cut.exact && cut.lowerBound == 2 && cut.colors >= 4 && VertexColoring::IsProper(m, cut.color));
+    assert(GraphMetrics::ChromaticNumber(mycielski) == 4 && GraphMetrics::CliqueNumber(mycielski) == 2);
+
+    // A 90-clique planted in a sparse random graph: candidate bitsets span two words.
+    Graph planted;
+    for (int i = 0; i < 3000; ++i) planted.addEdge(rng() % 400, rng() % 400);
+    std::vector<int> members;
+    for (int i = 0; i < 90; ++i) members.push_back(i * 4 + 1);
+    for (size_t i = 0; i < members.size(); ++i)
+        for (size_t j = i + 1; j < members.size(); ++j) planted.addEdge(members[i], members[j]);
+    CompactGraph p = CompactGraph::fromGraph(planted);
+    auto big = MaxClique::Find(p, 3);
+    assert(big.size() == 90);
+    Coloring pc = VertexColoring::Exact(p);
+    assert(pc.exact && pc.colors == 90 && VertexColoring::IsProper(p, pc.color));
+    assert(VertexColoring::SmallestLast(p).colors <= KCore::Decompose(p).degeneracy + 1u);
+
+    // Node limits: a dense random graph stops early with a real (not maximum) clique,
+    // and the colouring shares the budget instead of running the clique search unbounded.
+    std::mt19937 dense(41);
+    Graph half;
+    for (int u = 0; u < 300; ++u)
+        for (int v = u + 1; v < 300; ++v) if (dense() % 2) half.addEdge(u, v);
+    CompactGraph h = CompactGraph::fromGraph(half);
+    BasicClique<CompactGraph::Index> partial = MaxClique::Bounded(h, 2, 500);
+    assert(!partial.exact && partial.nodes == 500 && partial.members.size() >= 2);
+    for (size_t i = 0; i < partial.members.size(); ++i)
+        for (size_t j = i + 1; j < partial.members.size(); ++j) {
+            auto row = h.neighbors(partial.members[i]);
+            assert(std::binary_search(row.begin(), row.end(), partial.members[j]));
+        }
+    BasicClique<CompactGraph::Index> whole = MaxClique::Bounded(p, 1, SIZE_MAX);
+    assert(whole.exact && whole.members == big);
+    Coloring capped = VertexColoring::Exact(h, 2, 500);
+    assert(!capped.exact && capped.lowerBound <= capped.colors && VertexColoring::IsProper(h, capped.color));
+
+    std::cout << "[OK] Maximum clique and exact chromatic number verified.\n";
+}
+
+void TestMaximalSets() {
+    // Large enough for many reservation windows; isolated vertices and a self-loop included.
+    Graph g;
+    std::mt19937 rng(17);
+    for (int v = 0; v < 30000; ++v) g.addVertex(v);
+    for (int i = 0; i < 60000; ++i) g.addEdge(rng() % 25000, rng() % 25000);
+    g.addEdge(7, 7);
+    CompactGraph c = CompactGraph::fromGraph(g);
+
+    for (uint64_t seed : {1ull, 2ull}) {
+        IndependentSet greedy = MaximalSets::GreedyIndependentSet(c, seed);
+        assert(MaximalSets::IsMaximalIndependentSet(c, greedy.members) && greedy.size() > 5000);
+        Matching greedyMatching = MaximalSets::GreedyMatching(c, seed);
+        assert(MaximalSets::IsMaximalMatching(c, greedyMatching.mate));
+        for (unsigned threads : {1u, 4u}) {
+            IndependentSet parallel = MaximalSets::IndependentSet(c, threads, seed);
+            assert(parallel.members == greedy.members && parallel.rounds > 1);
+            Matching matching = MaximalSets::Matching(c, threads, seed);
+            assert(matching.mate == greedyMatching.mate && matching.edges == greedyMatching.edges);
+            IndependentSet luby = MaximalSets::Luby(c, threads, seed);
+            assert(MaximalSets::IsMaximalIndependentSet(c, luby.members) && luby.rounds < 40);
+        }
+    }
+    // A star's maximal independent sets are the hub alone or all leaves; a maximal matching is one edge.
+    CompactGraph star = CompactGraph::fromGraph(GraphGenerator::Star(50));
+    IndependentSet leaves = MaximalSets::Luby(star, 2, 3);
+    assert(leaves.size() == 1 || leaves.size() == 49);
+    assert(MaximalSets::Matching(star).size() == 1 && MaximalSets::IndependentSet(CompactGraph()).size() == 0);
+
+    std::cout << "[OK] Maximal independent sets and matchings verified.\n";
+}
+
+// Smallest vertex set whose removal disconnects the graph on vertices 0..n-1 (n - 1 if none does).
+size_t BruteVertexConnectivity(const Graph& g, int n) {
+    size_t best = n - 1;
+    for (uint32_t removed = 0; removed < (1u << n); ++removed) {
+        if ((size_t)__builtin_popcount(removed) >= best || __builtin_popcount(removed) > n - 2) continue;
+        int start = 0;
+        while (removed >> start & 1) start++;
+        std::vector<char> seen(n, 0);
+        std::vector<int> stack{start};
+        seen[start] = 1;
+        int reached = 1;
+        while (!stack.empty()) {
+            int v = stack.back(); stack.pop_back();
+            for (int u = 0; u < n; ++u)
+                if (!seen[u] && !(removed >> u & 1) && g.hasEdge(v, u)) { seen[u] = 1; reached++; stack.push_back(u); }
+        }
+        if (reached < n - __builtin_popcount(removed)) best = __builtin_popcount(removed);
+    }
+    return best;
+}
+
+void TestConnectivity() {
+    // Dinic on the CLRS network: maximum flow 23, and a capped run stops at the cap.
+    FlowNetwork net(6);
+    const int arcs[][3] = {{0, 1, 16}, {0, 2, 13}, {2, 1, 4}, {1, 3, 12}, {3, 2, 9}, {2, 4, 14}, {4, 3, 7}, {3, 5, 20}, {4, 5, 4}};
+    for (auto& a : arcs) net.addEdge(a[0], a[1], a[2]);
+    assert(net.maxFlow(0, 5) == 23.0);
+    std::vector<char> source = net.sourceSide(0);
+    assert(source[0] && !source[5]);
+    net.reset();
+    assert(net.maxFlow(0, 5, 10.0) == 10.0 && net.maxFlow(0, 5) == 13.0);
+
+    // Generator ground truth: bridges give lambda = kappa = 1, Moebius ladders are 3-connected.
+    for (Graph g : {GraphGenerator::WithBridges(14, 3), GraphGenerator::With2Bridges(16), GraphGenerator::WithArticulationPoints(12, 2)}) {
+        CompactGraph c = CompactGraph::fromGraph(g);
+        assert(Connectivity::EdgeConnectivity(c) == 1 && Connectivity::VertexConnectivity(c, 3) == 1);
+        assert(Connectivity::StoerWagner(c).weight == 1.0 && Connectivity::KargerStein(c, 0, 2, 5).weight == 1.0);
+    }
+    for (int n = 4; n <= 20; n += 2) {
+        Graph g = GraphGenerator::Cubic(n);
+        assert(GraphMetrics::EdgeConnectivity(g) == 3 && GraphMetrics::VertexConnectivity(g) == 3);
+        Cut cut = Connectivity::StoerWagner(CompactGraph::fromGraph(g));
+        assert(cut.weight == 3.0 && !cut.side.empty() && cut.side.size() < (size_t)n);
+    }
+
+    // Two weighted K5s joined by three light edges: the light edges are the minimum cut.
+    Graph bells;
+    for (int side = 0; side < 2; ++side)
+        for (int i = 0; i < 5; ++i)
+            for (int j = i + 1; j < 5; ++j) bells.addEdge(5 * side + i, 5 * side + j, 2.0);
+    for (int i = 0; i < 3; ++i) bells.addEdge(i, 5 + i, 0.5);
+    CompactGraph b = CompactGraph::fromGraph(bells);
+    Cut sw = Connectivity::StoerWagner(b), ks = Connectivity::KargerStein(b, 0, 3, 1);
+    Cut st = Connectivity::MinimumCut(b, b.index(0), b.index(9));
+    for (const Cut& cut : {sw, ks, st}) {
+        assert(std::abs(cut.weight - 1.5) < 1e-9 && cut.side.size() == 5);
+        std::set<int> ids;
+        for (auto v : cut.side) ids.insert(b.id(v) / 5);
+        assert(ids.size() == 1);
+    }
+    assert(Connectivity::EdgeConnectivity(b) == 3 && Connectivity::VertexConnectivity(b) == 3);
+
+    // Random small graphs against brute force, some of them disconnected.
+    std::mt19937 rng(29);
+    for (int trial = 0; trial < 30; ++trial) {
+        int n = 3 + trial % 8;
+        Graph g;
+        for (int v = 0; v < n; ++v) g.addVertex(v);
+        for (int u = 0; u < n; ++u)
+            for (int v = u + 1; v < n; ++v)
+                if (rng() % 100 < 55) g.addEdge(u, v, 1.0 + rng() % 4);
+        CompactGraph c = CompactGraph::fromGraph(g);
+        double bestWeight = 1e300;
+        size_t bestEdges = SIZE_MAX;
+        for (uint32_t mask = 1; mask + 1 < (1u << n); ++mask) {
+            double w = 0.0;
+            size_t edges = 0;
+            for (int u = 0; u < n; ++u)
+                for (int v = u + 1; v < n; ++v)
+                    if ((mask >> u & 1) != (mask >> v & 1) && g.hasEdge(u, v)) { w += g.weight(u, v); edges++; }
+            bestWeight = std::min(bestWeight, w);
+            bestEdges = std::min(bestEdges, edges);
+        }
+        assert(Connectivity::StoerWagner(c).weight == bestWeight);
+        assert(Connectivity::KargerStein(c, 0, 2, trial).weight == bestWeight);
+        assert(Connectivity::EdgeConnectivity(c, 2) == bestEdges);
+        assert(Connectivity::VertexConnectivity(c, 2) == BruteVertexConnectivity(g, n));
+    }
+
+    // Beyond the exact limit of 32 vertices the contraction recursion does the work:
+    // planted cuts (two dense halves, a few light edges across) and plain random graphs.
+    for (int trial = 0; trial < 4; ++trial) {
+        int n = 36 + 12 * trial;
+        Graph g;
+        for (int v = 0; v < n; ++v) g.addVertex(v);
+        bool planted = trial % 2 == 0;
+        for (int u = 0; u < n; ++u)
+            for (int v = u + 1; v < n; ++v) {
+                bool across = planted && (u < n / 2) != (v < n / 2);
+                if (across ? rng() % 1000 < 2 : rng() % 100 < 20) g.addEdge(u, v, 1.0 + rng() % 4);
+            }
+        if (planted) g.addEdge(0, n - 1, 1.0);
+        CompactGraph c = CompactGraph::fromGraph(g);
+        Cut sw = Connectivity::StoerWagner(c), ks = Connectivity::KargerStein(c, 0, 2, trial);
+        assert(sw.weight == ks.weight && ks.side.size() > 0 && ks.side.size() < (size_t)n);
+        if (trial == 0) assert(Connectivity::KargerStein(c, 0, 1, trial).side == ks.side);
+        double crossing = 0.0;
+        std::vector<char> inSide(n, 0);
+        for (auto v : ks.side) inSide[v] = 1;
+        for (CompactGraph::Index v = 0; v < c.vertexCount(); ++v)
+            for (auto slot = c.offsets[v]; slot < c.offsets[v + 1]; ++slot)
+                if (inSide[v] && !inSide[c.targets[slot]]) crossing += c.weight(slot);
+        assert(crossing == ks.weight);
+    }
+
+    std::cout << "[OK] Minimum cuts, max-flow and edge/vertex connectivity verified.\n";
+}
+
+// ||M x - value x|| for M = A (laplacian off) or L.
+double EigenResidual(const CompactGraph& c, const EigenPair& e, bool laplacian) {
+    std::vector<double> y;
+    if (laplacian) Spectral::MultiplyLaplacian(c, Spectral::WeightedDegrees(c), e.vector, y);
+    else Spectral::Multiply(c, e.vector, y);
+    double r = 0.0;
+    for (size_t v = 0; v < y.size(); ++v) r += (y[v] - e.value * e.vector[v]) * (y[v] - e.value * e.vector[v]);
+    return std::sqrt(r);
+}
+
+void TestSpectral() {
+    const double pi = std::acos(-1.0);
+    // SpMV against the adjacency lists, weighted and unweighted, any thread count.
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    Graph g = GraphGenerator::Random(300, 0.05), w;
+    for (int u : g.getVertices()) for (int v : g.neighbors(u)) if (u < v) w.addEdge(u, v, 0.5 + unit(rng));
+    w.addEdge(7, 7, 2.0);
+    for (const Graph* source : {&g, &w}) {
+        CompactGraph c = CompactGraph::fromGraph(*source);
+        std::vector<double> x(c.vertexCount()), y1, y3, ones(c.vertexCount(), 1.0), lap;
+        for (double& xi : x) xi = unit(rng) - 0.5;
+        Spectral::Multiply(c, x, y1, 1);
+        Spectral::Multiply(c, x, y3, 3);
+        for (CompactGraph::Index v = 0; v < c.vertexCount(); ++v) {
+            double expect = 0.0;
+            for (int u : source->neighbors(c.id(v))) expect += source->weight(c.id(v), u) * x[c.index(u)];
+            assert(std::abs(y1[v] - expect) < 1e-9 && std::abs(y3[v] - expect) < 1e-9);
+        }
+        Spectral::MultiplyLaplacian(c, Spectral::WeightedDegrees(c), ones, lap, 2);
+        for (double l : lap) assert(std::abs(l) < 1e-9);
+    }
+
+    // Closed-form spectra beyond the small implicit checks.
+    CompactGraph path = CompactGraph::fromGraph(GraphGenerator::Path(120));
+    EigenPair pr = Spectral::SpectralRadius(path), pf = Spectral::Fiedler(path);
+    assert(pr.converged && std::abs(pr.value - 2.0 * std::cos(pi / 121)) < 1e-8);
+    assert(pf.converged && std::abs(pf.value - (2.0 - 2.0 * std::cos(pi / 120))) < 1e-8);
+    for (double xi : pr.vector) assert(xi > 0);
+    // Long paths: lambda_2 ~ (pi / n)^2 with a relative gap near 1e-6, where
+    // plain restarted Lanczos stalls; shift-invert gets it to full precision.
+    for (int n : {1000}) {
+        CompactGraph longPath = CompactGraph::fromGraph(GraphGenerator::Path(n));
+        EigenPair lf = Spectral::Fiedler(longPath);
+        double exact = 2.0 - 2.0 * std::cos(pi / n);
+        assert(lf.converged && std::abs(lf.value - exact) < 1e-9 * exact && EigenResidual(longPath, lf, true) < 1e-9);
+        assert(Spectral::Bisection(longPath, lf).weight == 1.0);
+    }
+    CompactGraph cubic = CompactGraph::fromGraph(GraphGenerator::Cubic(200));
+    assert(std::abs(Spectral::SpectralRadius(cubic).value - 3.0) < 1e-8);
+    assert(std::abs(Spectral::AlgebraicConnectivity(cubic) - ImplicitCubic<>(200).algebraicConnectivity()) < 1e-8);
+    assert(!Spectral::SpectralRadius(path, 0, 10).converged); // reported, not silently wrong
+
+    // Disconnected: value 0, the vector still orthogonal to the constants.
+    CompactGraph split = CompactGraph::fromGraph(GraphGenerator::WithConnectedComponents(20, 2));
+    EigenPair sf = Spectral::Fiedler(split);
+    double sum = 0.0;
+    for (double xi : sf.vector) sum += xi;
+    assert(sf.value == 0.0 && std::abs(sum) < 1e-9 && EigenResidual(split, sf, true) < 1e-9);
+
+    // Two weighted K8 joined by a light edge: bisection separates them.
+    Graph bells;
+    for (int i = 0; i < 8; ++i)
+        for (int j = i + 1; j < 8; ++j) { bells.addEdge(i, j, 2.0); bells.addEdge(8 + i, 8 + j, 3.0); }
+    bells.addEdge(0, 8, 0.25);
+    CompactGraph cb = CompactGraph::fromGraph(bells);
+    Cut halves = Spectral::Bisection(cb);
+    assert(halves.weight == 0.25 && halves.side.size() == 8);
+    for (auto v : halves.side) assert((cb.id(v) < 8) == (cb.id(halves.side[0]) < 8));
+
+    // Random graphs: residuals, Fiedler's bound a(G) <= kappa(G) and
+    // average degree <= rho <= max degree.
+    for (int trial = 0; trial < 10; ++trial) {
+        CompactGraph c = CompactGraph::fromGraph(GraphGenerator::Random(40 + 8 * trial, 0.15));
+        EigenPair rho = Spectral::SpectralRadius(c, 2), fiedler = Spectral::Fiedler(c, 2);
+        assert(rho.converged && fiedler.converged);
+        assert(EigenResidual(c, rho, false) < 1e-7 && EigenResidual(c, fiedler, true) < 1e-7);
+        size_t maxDegree = 0;
+        for (CompactGraph::Index v = 0; v < c.vertexCount(); ++v) maxDegree = std::max(maxDegree, c.degree(v));
+        assert(rho.value >= 2.0 * c.edgeCount() / c.vertexCount() - 1e-9 && rho.value <= maxDegree + 1e-9);
+        assert(fiedler.value <= Connectivity::VertexConnectivity(c) + 1e-9);
+    }
+
+    std::cout << "[OK] SpMV, Lanczos spectral radius, Fiedler vector and bisection verified.\n";
+}
+
+// Push and pull products of one semiring agree on a random sparse x and mask.
+template <class S, class Make>
+void CheckPushPull(const CompactGraph& c, std::mt19937_64& rng, Make&& make) {
+    size_t n = c.vertexCount();
+    std::vector<char> bits(n);
+    SparseVector<typename S::Value> x(n);
+    for (size_t v = 0; v < n; ++v) {
+        bits[v] = rng() % 3 != 0;
+        if (rng() % 4 == 0) x.push(v, make(v));
+    }
+    for (Mask mask : {Mask{}, Mask{&bits, false}, Mask{&bits, true}}) {
+        SparseVector<typename S::Value> pushed = GraphAlgebra::Push<S>(c, x, mask, 3);
+        DenseVector<typename S::Value> pulled = GraphAlgebra::Pull<S>(c, GraphAlgebra::ToDense(x), mask, 2);
+        SparseVector<typename S::Value> chosen = GraphAlgebra::Multiply<S>(c, x, mask);
+        SparseVector<typename S::Value> back = GraphAlgebra::ToSparse(pulled);
+        assert(pushed.indices == back.indices && chosen.indices == back.indices);
+        for (size_t k = 0; k < back.nnz(); ++k) {
+            assert(mask.allows(back.indices[k]));
+            assert(std::abs((double)pushed.values[k] - (double)back.values[k]) <= 1e-9 * std::max(1.0, std::abs((double)back.values[k])));
+        }
+    }
+}
+
+void TestAlgebra() {
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    Graph g = GraphGenerator::Random(400, 0.02), w;
+    for (int u : g.getVertices()) for (int v : g.neighbors(u)) if (u < v) w.addEdge(u, v, 0.25 + unit(rng));
+    for (int i = 0; i < 40; ++i) w.addEdge(500 + i, 501 + i, 1.0 + i); // a separate weighted path
+    CompactGraph cg = CompactGraph::fromGraph(g), cw = CompactGraph::fromGraph(w);
+    for (const CompactGraph* c : {&cg, &cw}) {
+        CheckPushPull<OrAndSemiring>(*c, rng, [](size_t) { return (uint8_t)1; });
+        CheckPushPull<MinPlusSemiring>(*c, rng, [&](size_t) { return 10 * unit(rng); });
+        CheckPushPull<PlusTimesSemiring>(*c, rng, [&](size_t) { return unit(rng) - 0.5; });
+        CheckPushPull<MinFirstSemiring>(*c, rng, [](size_t v) { return (uint64_t)v; });
+    }
+
+    // BFS levels and Bellman-Ford distances against the queue BFS and Dijkstra.
+    BreadthFirstSearch<CompactGraph> bfs(cw);
+    for (CompactGraph::Index s : {0u, 7u, (CompactGraph::Index)cw.index(520)}) {
+        bfs.run(s);
+        std::vector<CompactGraph::Index> levels = GraphAlgebra::BFS(cw, s, 2);
+        for (CompactGraph::Index v = 0; v < cw.vertexCount(); ++v) assert(levels[v] == bfs.distance(v));
+        std::vector<double> dist = GraphAlgebra::BellmanFord(cw, s, 2), expect = ShortestPaths::Dijkstra(cw, s);
+        for (size_t v = 0; v < dist.size(); ++v)
+            assert(dist[v] == expect[v] || std::abs(dist[v] - expect[v]) < 1e-9 * expect[v]);
+    }
+    Graph negative;
+    negative.addEdge(0, 1, -1.0);
+    bool thrown = false;
+    try { GraphAlgebra::BellmanFord(CompactGraph::fromGraph(negative), 0); } catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    // Components: labels are the smallest index of each component.
+    CompactGraph parts = CompactGraph::fromGraph(GraphGenerator::WithConnectedComponents(90, 6));
+    std::vector<CompactGraph::Index> label = GraphAlgebra::Components(parts, 2);
+    BreadthFirstSearch<CompactGraph> partsBfs(parts);
+    for (CompactGraph::Index v = 0; v < parts.vertexCount(); ++v) {
+        partsBfs.run(v);
+        CompactGraph::Index smallest = v;
+        for (CompactGraph::Index u : partsBfs.visited()) smallest = std::min(smallest, u);
+        assert(label[v] == smallest);
+    }
+    assert(GraphAlgebra::ComponentCount(parts) == 6 && GraphMetrics::ConnectedComponents(GraphGenerator::WithConnectedComponents(90, 6)) == 6);
+
+    // A long path: label propagation would need O(n * diameter) work here.
+    Graph longPath = GraphGenerator::Path(100000);
+    CompactGraph lp = CompactGraph::fromGraph(longPath);
+    std::vector<CompactGraph::Index> pathLabel = GraphAlgebra::Components(lp);
+    assert(std::count(pathLabel.begin(), pathLabel.end(), 0u) == 100000);
+    assert(GraphMetrics::ConnectedComponents(longPath) == 1 && GraphMetrics::IsBipartite(longPath));
+    longPath.addEdge(99999, 100001);
+    longPath.addEdge(100001, 99998);
+    assert(!GraphMetrics::IsBipartite(longPath));
+
+    // Bipartiteness, including odd cycles hidden in a second component and self-loops.
+    assert(GraphAlgebra::IsBipartite(CompactGraph::fromGraph(GraphGenerator::Cycle(10))));
+    assert(!GraphAlgebra::IsBipartite(CompactGraph::fromGraph(GraphGenerator::Cycle(11))));
+    assert(GraphAlgebra::IsBipartite(CompactGraph::fromGraph(GraphGenerator::CompleteBipartite(4, 7))));
+    Graph mixed = GraphGenerator::Path(6);
+    for (int i = 0; i < 5; ++i) mixed.addEdge(10 + i, 10 + (i + 1) % 5);
+    assert(!GraphMetrics::IsBipartite(mixed));
+    Graph loop = GraphGenerator::Path(4);
+    loop.addEdge(2, 2);
+    assert(!GraphMetrics::IsBipartite(loop) && GraphMetrics::IsBipartite(GraphGenerator::Path(4)));
+
+    std::cout << "[OK] Semiring push/pull products and algebraic BFS, components, bipartiteness and SSSP verified.\n";
+}
+
+// Textbook power iteration: rank' = (1 - d) / n + d (sum of rank(u) w(u, v) / out(u) + dangling / n).
+std::vector<double> ReferencePageRank(const CompactGraph& c, double damping, int iterations) {
+    size_t n = c.vertexCount();
+    std::vector<double> rank(n, 1.0 / n), out(n, 0.0);
+    for (size_t v = 0; v < n; ++v)
+        for (auto slot = c.offsets[v]; slot < c.offsets[v + 1]; ++slot) out[v] += c.weight(slot);
+    for (int it = 0; it < iterations; ++it) {
+        double dangling = 0.0;
+        for (size_t v = 0; v < n; ++v) if (out[v] == 0) dangling += rank[v];
+        std::vector<double> next(n, (1 - damping) / n + damping * dangling / n);
+        for (size_t u = 0; u < n; ++u)
+            for (auto slot = c.offsets[u]; slot < c.offsets[u + 1]; ++slot)
+                if (out[u] > 0) next[c.targets[slot]] += damping * rank[u] * c.weight(slot) / out[u];
+        rank.swap(next);
+    }
+    return rank;
+}
+
+void TestPageRank() {
+    std::mt19937_64 rng(6);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    Graph g = GraphGenerator::Random(500, 0.015), w;
+    for (int u : g.getVertices()) for (int v : g.neighbors(u)) if (u < v) w.addEdge(u, v, 0.25 + unit(rng));
+    for (int i = 0; i < 30; ++i) w.addVertex(1000 + i); // dangling vertices
+    PageRankOptions tight;
+    tight.tolerance = 1e-13;
+    tight.maxIterations = 1000;
+    for (const Graph* h : {&g, &w}) {
+        CompactGraph c = CompactGraph::fromGraph(*h);
+        std::vector<double> expect = ReferencePageRank(c, 0.85, 300);
+        PageRankResult jacobi = PageRank::Compute(c, tight, 1), parallel = PageRank::Compute(c, tight, 3);
+        PageRankOptions gs = tight;
+        gs.gaussSeidel = true;
+        PageRankResult seidel = PageRank::Compute(c, gs);
+        assert(jacobi.converged && seidel.converged && seidel.iterations <= jacobi.iterations);
+        assert(parallel.score == jacobi.score);
+        double total = 0.0;
+        for (size_t v = 0; v < c.vertexCount(); ++v) {
+            assert(std::abs(jacobi.score[v] - expect[v]) < 1e-11 && std::abs(seidel.score[v] - expect[v]) < 1e-10);
+            total += seidel.score[v];
+        }
+        assert(std::abs(total - 1.0) < 1e-10);
+
+        // Forward push: never above the exact personalized rank, short by at most the unpushed mass.
+        for (CompactGraph::Index s : {0u, 11u, (CompactGraph::Index)(c.vertexCount() - 1)}) {
+            PageRankResult exact = PageRank::PersonalizedExact(c, s, tight);
+            PageRankResult push = PageRank::Personalized(c, s, 1e-6);
+            double error = 0.0, settled = 0.0;
+            for (size_t v = 0; v < c.vertexCount(); ++v) {
+                assert(push.score[v] <= exact.score[v] + 1e-12);
+                error += exact.score[v] - push.score[v];
+                settled += push.score[v];
+            }
+            assert(std::abs(error - push.residual) < 1e-9 && push.residual < 1e-6 * 2 * c.edgeCount() + 1e-12);
+            assert(std::abs(settled + push.residual - 1.0) < 1e-9);
+        }
+    }
+
+    // Gauss-Seidel sweeps pay off where rank mixes slowly.
+    for (const Graph& h : {GraphGenerator::Path(300), GraphGenerator::WithBridges(300, 10)}) {
+        CompactGraph c = CompactGraph::fromGraph(h);
+        PageRankOptions gs = tight;
+        gs.gaussSeidel = true;
+        assert(2 * PageRank::Compute(c, gs).iterations < PageRank::Compute(c, tight).iterations + 10);
+    }
+
+    // Uniform on a cycle; a distribution with isolated and dangling vertices, on any thread count.
+    for (double r : PageRank::Compute(CompactGraph::fromGraph(GraphGenerator::Cycle(12))).score) assert(std::abs(r - 1.0 / 12) < 1e-12);
+    Graph dangling = GraphGenerator::Path(5);
+    dangling.addVertex(9);
+    PageRankResult spread = PageRank::Compute(CompactGraph::fromGraph(dangling), tight, 2);
+    assert(spread.converged && std::abs(std::accumulate(spread.score.begin(), spread.score.end(), 0.0) - 1.0) < 1e-12);
+
+    // Star closed form, and the hub first in the top-k with the leaves tied by index.
+    CompactGraph star = CompactGraph::fromGraph(GraphGenerator::Star(21));
+    PageRankResult rank = PageRank::Compute(star, tight);
+    assert(std::abs(rank.score[star.index(0)] - (1 + 0.85 * 20) / (21 * 1.85)) < 1e-10);
+    auto top = PageRank::TopK(rank.score, 4);
+    assert(top.size() == 4 && top[0].first == star.index(0));
+    for (size_t i = 2; i < top.size(); ++i) assert(top[i - 1].first < top[i].first && top[i - 1].second == top[i].second);
+    assert(PageRank::TopK(rank.score, 100).size() == 21);
+
+    // Binary scores round trip by vertex id; other files are rejected.
+    std::string path = (std::filesystem::temp_directory_path() / "graphodro4_test.pr").string();
+    CompactGraph c = CompactGraph::fromGraph(w);
+    PageRankResult scores = PageRank::Compute(c);
+    PageRank::Save(path, c, scores.score);
+    auto loaded = PageRank::Load(path);
+    assert(loaded.size() == c.vertexCount());
+    for (size_t i = 0; i < loaded.size(); ++i) assert(loaded[i].first == c.id(i) && loaded[i].second == scores.score[i]);
+    // A valid header with a huge count must fail as a truncated file, not in the allocator.
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        uint64_t huge = uint64_t(1) << 60;
+        bytes.replace(12, sizeof(huge), (const char*)&huge, sizeof(huge));
+        std::ofstream(path, std::ios::binary) << bytes;
+    }
+    bool thrown = false;
+    try { PageRank::Load(path); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+    { std::ofstream(path, std::ios::binary) << "not a score file"; }
+    thrown = false;
+    try { PageRank::Load(path); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+    std::filesystem::remove(path);
+
+    std::cout << "[OK] PageRank (parallel pull, Gauss-Seidel), personalized forward push, top-k and binary scores verified.\n";
+}
+
+int main() {
+    std::cout << "Running GraphoDro4 Level 8 Tests...\n";
+    TestGenerators();
+    TestGraphBackend();
+    TestVertexWidths();
+    TestMetrics();
+    TestSerializers();
+    TestCores();
+    TestBetweenness();
+    TestEdgeCuts();
+    TestScheduler();
+    TestStreaming();
+    TestOutOfCore();
+    TestConcurrentGraph();
+    TestVersionedGraph();
+    TestViews();
+    TestImplicitGraphs();
+    TestDistanceOracle();
+    TestWeightedPaths();
+    TestSpanningTrees();
+    TestCycles();
+    TestCommunities();
+    TestTriangleEstimation();
+    TestMotifs();
+    TestColoring();
+    TestMaximalSets();
+    TestConnectivity();
+    TestSpectral();
+    TestAlgebra();
+    TestPageRank();
+    std::cout << "--- All tests passed successfully! ---\n";
+    return 0;
+}